@@ -0,0 +1,110 @@
+package com.thalmic.myo.bench;
+
+import java.io.BufferedReader;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.io.OutputStreamWriter;
+import java.io.Writer;
+import java.lang.management.ManagementFactory;
+import java.lang.management.ThreadMXBean;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Map;
+
+/**
+ * What the benchmarks share: running each measurement in a fresh JVM and collecting its result, and writing the
+ * results as JSON.<br>
+ * <br>
+ * A child process prints its result with {@link #printResult(String)}, as a list of JSON members on a line of its
+ * own, and {@link #fork(Class, List, Map, String...)} returns that list to the parent.
+ *
+ */
+final class BenchmarkProcess {
+
+	//Child processes print their result on a line starting with this
+	private static final String RESULT_PREFIX = "RESULT ";
+
+	private BenchmarkProcess() {
+	}
+
+	//Runs main in a new JVM with the same class and library path as this one, plus jvmOptions, and with env added
+	//to the environment. Returns the result it printed.
+	static String fork(Class<?> main, List<String> jvmOptions, Map<String, String> env, String... args)
+			throws IOException, InterruptedException {
+		List<String> command = new ArrayList<String>();
+		command.add(System.getProperty("java.home") + "/bin/java");
+		command.addAll(jvmOptions);
+		command.add("-cp");
+		command.add(System.getProperty("java.class.path"));
+		command.add("-Djava.library.path=" + System.getProperty("java.library.path"));
+		command.add(main.getName());
+		command.addAll(Arrays.asList(args));
+		ProcessBuilder builder = new ProcessBuilder(command);
+		builder.environment().putAll(env);
+		builder.redirectError(ProcessBuilder.Redirect.INHERIT);
+
+		Process process = builder.start();
+		String result = null;
+		BufferedReader reader = new BufferedReader(new InputStreamReader(process.getInputStream(), "UTF-8"));
+		try {
+			String line;
+			while((line = reader.readLine()) != null) {
+				if(line.startsWith(RESULT_PREFIX)) {
+					result = line.substring(RESULT_PREFIX.length());
+				}
+			}
+		}
+		finally {
+			reader.close();
+		}
+		int exitCode = process.waitFor();
+		if(exitCode != 0 || result == null) {
+			throw new IOException("Benchmark process " + Arrays.toString(args) + " failed with exit code " + exitCode);
+		}
+		return result;
+	}
+
+	//Called by a child process to hand its result, a list of JSON members, to the parent
+	static void printResult(String result) {
+		System.out.println(RESULT_PREFIX + result);
+		System.out.flush();
+	}
+
+	//Starts the JSON of a benchmark's results, up to the opening bracket of the results array. extraMembers are
+	//added after the common ones, each with its leading comma.
+	static StringBuilder startJson(String benchmark, String extraMembers) {
+		StringBuilder json = new StringBuilder();
+		json.append("{\"benchmark\":\"").append(benchmark).append("\",\"javaVersion\":\"")
+			.append(System.getProperty("java.version")).append("\",\"os\":\"").append(System.getProperty("os.name"))
+			.append('"').append(extraMembers).append(",\"results\":[");
+		return json;
+	}
+
+	//Closes the results array, and writes the JSON to the file given as the only argument or to standard output
+	static void finishJson(StringBuilder json, String[] args) throws IOException {
+		json.append("\n]}\n");
+		if(args.length > 0) {
+			Writer out = new OutputStreamWriter(new FileOutputStream(args[0]), "UTF-8");
+			try {
+				out.write(json.toString());
+			}
+			finally {
+				out.close();
+			}
+		}
+		else {
+			System.out.print(json);
+		}
+	}
+
+	//Bytes allocated by the current thread so far, or -1 if the JVM can't tell
+	static long allocatedBytes() {
+		ThreadMXBean threads = ManagementFactory.getThreadMXBean();
+		if(threads instanceof com.sun.management.ThreadMXBean) {
+			return ((com.sun.management.ThreadMXBean) threads).getThreadAllocatedBytes(Thread.currentThread().getId());
+		}
+		return -1;
+	}
+}
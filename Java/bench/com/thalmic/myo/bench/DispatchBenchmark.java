@@ -0,0 +1,287 @@
+package com.thalmic.myo.bench;
+
+import java.io.IOException;
+import java.lang.management.GarbageCollectorMXBean;
+import java.lang.management.ManagementFactory;
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.Locale;
+import java.util.Map;
+
+import com.thalmic.myo.DeviceListener;
+import com.thalmic.myo.FirmwareVersion;
+import com.thalmic.myo.Hub;
+import com.thalmic.myo.Myo;
+import com.thalmic.myo.Pose;
+import com.thalmic.myo.Quaternion;
+import com.thalmic.myo.Vector3;
+
+/**
+ * Measures how fast events get from libmyo to each kind of {@link DeviceListener} callback.<br>
+ * <br>
+ * This needs the native library built against the simulated libmyo (see the README), which provides the virtual
+ * armbands. Every combination of callback and number of armbands is measured in a fresh JVM, in two phases:
+ * <ul>
+ * <li>Throughput: the simulator runs as fast as {@link Hub#run(int)} can consume events. This measures events
+ * per second, bytes allocated per event on the dispatching thread, and time spent in garbage collection.
+ * <li>Latency: the simulator runs in real time, and the time from each event's timestamp to its callback is
+ * recorded. This relies on libmyo timestamps and {@link System#nanoTime()} using the same clock, which is true
+ * for the simulator on Linux.
+ * </ul>
+ * The results are written as JSON, to the file given as the only argument or to standard output.
+ *
+ */
+public final class DispatchBenchmark {
+
+	//Dispatch without any Java callback is measured by Benchmark/NativeDispatchBenchmark, since a listener that
+	//overrides nothing has no events to count
+	private static final String[] CALLBACKS = {
+		"onPose", "onOrientationData", "onAccelerometerData", "onGyroscopeData", "onImuData",
+		"onOrientationRaw", "onAccelerometerRaw", "onGyroscopeRaw", "onEmgData", "onEmgBatch"
+	};
+	private static final int[] MYO_COUNTS = { 1, 4, 16 };
+
+	//Durations of each phase. In the throughput phase these are simulated milliseconds.
+	private static final int WARMUP_MS = 2000;
+	private static final int THROUGHPUT_ITERATIONS = 20;
+	private static final int THROUGHPUT_ITERATION_MS = 1000;
+	private static final int LATENCY_MS = 5000;
+	private static final int MAX_LATENCY_SAMPLES = 1 << 20;
+
+	private DispatchBenchmark() {
+	}
+
+	public static void main(String[] args) throws Exception {
+		//The child processes get the number of Myos through the simulator's environment; it is only passed as an
+		//argument to make them recognizable in a process list
+		if(args.length == 3 && args[0].equals("--throughput")) {
+			runThroughput(args[1]);
+			return;
+		}
+		if(args.length == 3 && args[0].equals("--latency")) {
+			runLatency(args[1]);
+			return;
+		}
+
+		StringBuilder json = BenchmarkProcess.startJson("dispatch", "");
+		boolean first = true;
+		for(String callback : CALLBACKS) {
+			for(int myos : MYO_COUNTS) {
+				System.err.println("Benchmarking " + callback + " with " + myos + " Myo(s)");
+				String throughput = fork("--throughput", callback, myos);
+				String latency = fork("--latency", callback, myos);
+				if(!first) {
+					json.append(',');
+				}
+				first = false;
+				json.append("\n{\"callback\":\"").append(callback).append("\",\"myos\":").append(myos)
+					.append(',').append(throughput).append(',').append(latency).append('}');
+			}
+		}
+		BenchmarkProcess.finishJson(json, args);
+	}
+
+	//Runs one phase in a new JVM and returns its result, which is a list of JSON members.
+	private static String fork(String phase, String callback, int myos) throws IOException, InterruptedException {
+		Map<String, String> env = new HashMap<String, String>();
+		env.put("MYO_SIM_COUNT", Integer.toString(myos));
+		env.put("MYO_SIM_REALTIME", phase.equals("--latency") ? "1" : "0");
+		//Poses normally change every second or so, which is far too rare to measure anything
+		env.put("MYO_SIM_POSE_INTERVAL", callback.equals("onPose") ? "0.02" : "1.5");
+		return BenchmarkProcess.fork(DispatchBenchmark.class, Collections.<String>emptyList(), env,
+				phase, callback, Integer.toString(myos));
+	}
+
+	private static void runThroughput(String callback) {
+		Recorder recorder = new Recorder(0);
+		Hub hub = createHub(callback, recorder);
+		try {
+			hub.run(WARMUP_MS);
+
+			long allocatedBefore = BenchmarkProcess.allocatedBytes();
+			long gcBefore = gcTimeMs();
+			recorder.events = 0;
+			long start = System.nanoTime();
+			for(int i = 0; i < THROUGHPUT_ITERATIONS; i ++) {
+				hub.run(THROUGHPUT_ITERATION_MS);
+			}
+			long elapsed = System.nanoTime() - start;
+			long allocated = BenchmarkProcess.allocatedBytes() - allocatedBefore;
+			long gcTime = gcTimeMs() - gcBefore;
+
+			long events = recorder.events;
+			BenchmarkProcess.printResult(String.format(Locale.ROOT,
+					"\"events\":%d,\"eventsPerSecond\":%.1f,\"allocatedBytesPerEvent\":%.2f,\"gcTimeMs\":%d",
+					events, events / (elapsed / 1e9), allocatedBefore < 0 || events == 0 ? -1.0 : (double) allocated / events, gcTime));
+		}
+		finally {
+			hub.release();
+		}
+	}
+
+	private static void runLatency(String callback) {
+		Recorder recorder = new Recorder(MAX_LATENCY_SAMPLES);
+		Hub hub = createHub(callback, recorder);
+		try {
+			hub.run(WARMUP_MS);
+			recorder.latencyCount = 0;
+			hub.run(LATENCY_MS);
+
+			long[] latencies = Arrays.copyOf(recorder.latencies, recorder.latencyCount);
+			Arrays.sort(latencies);
+			BenchmarkProcess.printResult(String.format(Locale.ROOT,
+					"\"latencySamples\":%d,\"latencyP50Us\":%d,\"latencyP99Us\":%d,\"latencyP999Us\":%d,\"latencyMaxUs\":%d",
+					latencies.length, percentile(latencies, 0.5), percentile(latencies, 0.99), percentile(latencies, 0.999),
+					latencies.length > 0 ? latencies[latencies.length - 1] : -1));
+		}
+		finally {
+			hub.release();
+		}
+	}
+
+	private static Hub createHub(String callback, Recorder recorder) {
+		Hub hub = new Hub("com.thalmic.myo.benchmark");
+		//Poses are only measurable if they are not held back while the Myo is locked
+		hub.setLockingPolicy(Hub.LockingPolicy.lockingPolicyNone);
+		hub.addListener(createListener(callback, recorder));
+		return hub;
+	}
+
+	private static long percentile(long[] sorted, double fraction) {
+		if(sorted.length == 0) {
+			return -1;
+		}
+		int index = (int) Math.ceil(fraction * sorted.length) - 1;
+		return sorted[Math.max(0, Math.min(sorted.length - 1, index))];
+	}
+
+	private static long gcTimeMs() {
+		long total = 0;
+		for(GarbageCollectorMXBean collector : ManagementFactory.getGarbageCollectorMXBeans()) {
+			total += Math.max(0, collector.getCollectionTime());
+		}
+		return total;
+	}
+
+	//Counts events and records their latency in microseconds, into a preallocated array so that the measurement
+	//itself allocates nothing
+	private static final class Recorder {
+		long events;
+		final long[] latencies;
+		int latencyCount;
+
+		Recorder(int maxSamples) {
+			latencies = new long[maxSamples];
+		}
+
+		void record(long timestamp) {
+			events ++;
+			if(latencyCount < latencies.length) {
+				latencies[latencyCount ++] = System.nanoTime() / 1000 - timestamp;
+			}
+		}
+	}
+
+	//Every listener turns on EMG as soon as a Myo pairs, so that EMG callbacks have something to measure
+	private static class BenchmarkListener extends DeviceListener {
+		protected final Recorder recorder;
+
+		BenchmarkListener(Recorder recorder) {
+			this.recorder = recorder;
+		}
+
+		@Override
+		public void onPair(Myo myo, long timestamp, FirmwareVersion firmwareVersion) {
+			myo.setStreamEmg(Myo.StreamEmgType.streamEmgEnabled);
+		}
+	}
+
+	//Only the measured callback may be overridden, since Hub skips callbacks that aren't
+	private static DeviceListener createListener(String callback, final Recorder recorder) {
+		if(callback.equals("onPose")) {
+			return new BenchmarkListener(recorder) {
+				@Override
+				public void onPose(Myo myo, long timestamp, Pose pose) {
+					recorder.record(timestamp);
+				}
+			};
+		}
+		if(callback.equals("onOrientationData")) {
+			return new BenchmarkListener(recorder) {
+				@Override
+				public void onOrientationData(Myo myo, long timestamp, Quaternion rotation) {
+					recorder.record(timestamp);
+				}
+			};
+		}
+		if(callback.equals("onAccelerometerData")) {
+			return new BenchmarkListener(recorder) {
+				@Override
+				public void onAccelerometerData(Myo myo, long timestamp, Vector3 accel) {
+					recorder.record(timestamp);
+				}
+			};
+		}
+		if(callback.equals("onGyroscopeData")) {
+			return new BenchmarkListener(recorder) {
+				@Override
+				public void onGyroscopeData(Myo myo, long timestamp, Vector3 gyro) {
+					recorder.record(timestamp);
+				}
+			};
+		}
+		if(callback.equals("onImuData")) {
+			return new BenchmarkListener(recorder) {
+				@Override
+				public void onImuData(Myo myo, long timestamp, float[] imu) {
+					recorder.record(timestamp);
+				}
+			};
+		}
+		if(callback.equals("onOrientationRaw")) {
+			return new BenchmarkListener(recorder) {
+				@Override
+				public void onOrientationRaw(Myo myo, long timestamp, float x, float y, float z, float w) {
+					recorder.record(timestamp);
+				}
+			};
+		}
+		if(callback.equals("onAccelerometerRaw")) {
+			return new BenchmarkListener(recorder) {
+				@Override
+				public void onAccelerometerRaw(Myo myo, long timestamp, float x, float y, float z) {
+					recorder.record(timestamp);
+				}
+			};
+		}
+		if(callback.equals("onGyroscopeRaw")) {
+			return new BenchmarkListener(recorder) {
+				@Override
+				public void onGyroscopeRaw(Myo myo, long timestamp, float x, float y, float z) {
+					recorder.record(timestamp);
+				}
+			};
+		}
+		if(callback.equals("onEmgData")) {
+			return new BenchmarkListener(recorder) {
+				@Override
+				public void onEmgData(Myo myo, long timestamp, byte[] emg) {
+					recorder.record(timestamp);
+				}
+			};
+		}
+		if(callback.equals("onEmgBatch")) {
+			return new BenchmarkListener(recorder) {
+				@Override
+				public void onEmgBatch(Myo myo, long[] timestamps, ByteBuffer samples, int count) {
+					//Every frame counts as an event, but only the newest one's latency is recorded
+					recorder.events += count - 1;
+					recorder.record(timestamps[count - 1]);
+				}
+			};
+		}
+		throw new IllegalArgumentException("Unknown callback " + callback);
+	}
+}
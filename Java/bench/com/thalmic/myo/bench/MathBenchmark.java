@@ -0,0 +1,278 @@
+package com.thalmic.myo.bench;
+
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.Locale;
+
+import com.thalmic.myo.Quaternion;
+import com.thalmic.myo.Quaternionf;
+import com.thalmic.myo.Vector3;
+import com.thalmic.myo.Vector3f;
+
+/**
+ * Compares the allocating {@link Quaternion} and {@link Vector3} methods with their in-place and out-parameter
+ * variants, and with {@link Quaternionf} and {@link Vector3f}.<br>
+ * <br>
+ * Every operation is measured in a fresh JVM started with escape analysis turned off, so that the JIT can't hide
+ * the temporaries of the allocating methods by scalar replacement. The bytes allocated per operation then show
+ * what each method costs in the worst case, which is the case of a callback that the JIT doesn't inline fully. This
+ * doesn't need the native library.<br>
+ * <br>
+ * The results are written as JSON, to the file given as the only argument or to standard output.
+ *
+ */
+public final class MathBenchmark {
+
+	private static final String[] OPERATIONS = {
+		"multiply", "multiplyEquals", "multiplyInto", "multiplyIntoFloat",
+		"rotate", "rotateInto", "rotateIntoFloat",
+		"normalized", "normalizeInPlace", "normalizeInPlaceFloat",
+		"conjugate", "conjugateInto", "conjugateIntoFloat",
+		"cross", "crossInto", "crossIntoFloat"
+	};
+
+	private static final int WARMUP_OPERATIONS = 2000000;
+	private static final int MEASURED_OPERATIONS = 20000000;
+
+	//Keeps the results of the operations alive, so that the JIT can't drop them
+	private static double sink;
+
+	private MathBenchmark() {
+	}
+
+	public static void main(String[] args) throws Exception {
+		if(args.length == 2 && args[0].equals("--run")) {
+			run(args[1]);
+			return;
+		}
+
+		StringBuilder json = BenchmarkProcess.startJson("math", ",\"escapeAnalysis\":false");
+		boolean first = true;
+		for(String operation : OPERATIONS) {
+			System.err.println("Benchmarking " + operation);
+			//Escape analysis is turned off so that allocations show up even where the JIT would remove them
+			String result = BenchmarkProcess.fork(MathBenchmark.class, Arrays.asList("-XX:-DoEscapeAnalysis"),
+					Collections.<String, String>emptyMap(), "--run", operation);
+			if(!first) {
+				json.append(',');
+			}
+			first = false;
+			json.append("\n{\"operation\":\"").append(operation).append("\",").append(result).append('}');
+		}
+		BenchmarkProcess.finishJson(json, args);
+	}
+
+	private static void run(String operation) {
+		Operation op = createOperation(operation);
+		op.run(WARMUP_OPERATIONS);
+
+		long allocatedBefore = BenchmarkProcess.allocatedBytes();
+		long start = System.nanoTime();
+		op.run(MEASURED_OPERATIONS);
+		long elapsed = System.nanoTime() - start;
+		long allocated = BenchmarkProcess.allocatedBytes() - allocatedBefore;
+
+		BenchmarkProcess.printResult(String.format(Locale.ROOT,
+				"\"operations\":%d,\"nsPerOperation\":%.2f,\"allocatedBytesPerOperation\":%.2f",
+				MEASURED_OPERATIONS, (double) elapsed / MEASURED_OPERATIONS,
+				allocatedBefore < 0 ? -1.0 : (double) allocated / MEASURED_OPERATIONS));
+		//Printed so that the sink is used
+		System.err.println(operation + " checksum " + sink);
+	}
+
+	private interface Operation {
+		void run(int count);
+	}
+
+	//The operands are created once, outside of the measured loops, like the fields of a listener would be. Every
+	//loop feeds its result back into an operand so that no iteration can be skipped.
+	private static Operation createOperation(String operation) {
+		final Quaternion q = new Quaternion(0.18257419, 0.36514837, 0.54772256, 0.73029674);
+		final Quaternion r = new Quaternion(-0.5, 0.5, 0.5, 0.5);
+		final Vector3 v = new Vector3(1, 2, 3);
+		final Quaternionf qf = new Quaternionf().set(q);
+		final Quaternionf rf = new Quaternionf().set(r);
+		final Vector3f vf = new Vector3f().set(v);
+
+		if(operation.equals("multiply")) {
+			return new Operation() {
+				public void run(int count) {
+					Quaternion acc = q;
+					for(int i = 0; i < count; i ++) {
+						acc = acc.multiply(r);
+					}
+					sink += acc.w();
+				}
+			};
+		}
+		if(operation.equals("multiplyEquals")) {
+			return new Operation() {
+				public void run(int count) {
+					Quaternion acc = new Quaternion(q);
+					for(int i = 0; i < count; i ++) {
+						acc.multiplyEquals(r);
+					}
+					sink += acc.w();
+				}
+			};
+		}
+		if(operation.equals("multiplyInto")) {
+			return new Operation() {
+				public void run(int count) {
+					Quaternion acc = new Quaternion(q);
+					for(int i = 0; i < count; i ++) {
+						acc.multiplyInto(r, acc);
+					}
+					sink += acc.w();
+				}
+			};
+		}
+		if(operation.equals("multiplyIntoFloat")) {
+			return new Operation() {
+				public void run(int count) {
+					Quaternionf acc = new Quaternionf(qf);
+					for(int i = 0; i < count; i ++) {
+						acc.multiplyInto(rf, acc);
+					}
+					sink += acc.w();
+				}
+			};
+		}
+		if(operation.equals("rotate")) {
+			return new Operation() {
+				public void run(int count) {
+					Vector3 acc = v;
+					for(int i = 0; i < count; i ++) {
+						acc = Quaternion.rotate(r, acc);
+					}
+					sink += acc.x();
+				}
+			};
+		}
+		if(operation.equals("rotateInto")) {
+			return new Operation() {
+				public void run(int count) {
+					Vector3 acc = new Vector3(v);
+					for(int i = 0; i < count; i ++) {
+						Quaternion.rotateInto(r, acc, acc);
+					}
+					sink += acc.x();
+				}
+			};
+		}
+		if(operation.equals("rotateIntoFloat")) {
+			return new Operation() {
+				public void run(int count) {
+					Vector3f acc = new Vector3f(vf);
+					for(int i = 0; i < count; i ++) {
+						Quaternionf.rotateInto(rf, acc, acc);
+					}
+					sink += acc.x();
+				}
+			};
+		}
+		if(operation.equals("normalized")) {
+			return new Operation() {
+				public void run(int count) {
+					Quaternion acc = q;
+					for(int i = 0; i < count; i ++) {
+						acc = acc.normalized();
+					}
+					sink += acc.w();
+				}
+			};
+		}
+		if(operation.equals("normalizeInPlace")) {
+			return new Operation() {
+				public void run(int count) {
+					Quaternion acc = new Quaternion(q);
+					for(int i = 0; i < count; i ++) {
+						acc.normalizeInPlace();
+					}
+					sink += acc.w();
+				}
+			};
+		}
+		if(operation.equals("normalizeInPlaceFloat")) {
+			return new Operation() {
+				public void run(int count) {
+					Quaternionf acc = new Quaternionf(qf);
+					for(int i = 0; i < count; i ++) {
+						acc.normalizeInPlace();
+					}
+					sink += acc.w();
+				}
+			};
+		}
+		if(operation.equals("conjugate")) {
+			return new Operation() {
+				public void run(int count) {
+					Quaternion acc = q;
+					for(int i = 0; i < count; i ++) {
+						acc = acc.conjugate();
+					}
+					sink += acc.x();
+				}
+			};
+		}
+		if(operation.equals("conjugateInto")) {
+			return new Operation() {
+				public void run(int count) {
+					Quaternion acc = new Quaternion(q);
+					for(int i = 0; i < count; i ++) {
+						acc.conjugateInto(acc);
+					}
+					sink += acc.x();
+				}
+			};
+		}
+		if(operation.equals("conjugateIntoFloat")) {
+			return new Operation() {
+				public void run(int count) {
+					Quaternionf acc = new Quaternionf(qf);
+					for(int i = 0; i < count; i ++) {
+						acc.conjugateInto(acc);
+					}
+					sink += acc.x();
+				}
+			};
+		}
+		if(operation.equals("cross")) {
+			return new Operation() {
+				public void run(int count) {
+					Vector3 acc = v;
+					Vector3 other = new Vector3(0, 0, 1);
+					for(int i = 0; i < count; i ++) {
+						acc = other.cross(acc);
+					}
+					sink += acc.x();
+				}
+			};
+		}
+		if(operation.equals("crossInto")) {
+			return new Operation() {
+				public void run(int count) {
+					Vector3 acc = new Vector3(v);
+					Vector3 other = new Vector3(0, 0, 1);
+					for(int i = 0; i < count; i ++) {
+						other.crossInto(acc, acc);
+					}
+					sink += acc.x();
+				}
+			};
+		}
+		if(operation.equals("crossIntoFloat")) {
+			return new Operation() {
+				public void run(int count) {
+					Vector3f acc = new Vector3f(vf);
+					Vector3f other = new Vector3f(0, 0, 1);
+					for(int i = 0; i < count; i ++) {
+						other.crossInto(acc, acc);
+					}
+					sink += acc.x();
+				}
+			};
+		}
+		throw new IllegalArgumentException("Unknown operation " + operation);
+	}
+}
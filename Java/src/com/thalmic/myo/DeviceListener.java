@@ -1,5 +1,7 @@
 package com.thalmic.myo;
 
+import java.nio.ByteBuffer;
+
 /**
  * A DeviceListener receives events about a {@link Myo}. 
  * @see Hub#addListener(DeviceListener)
@@ -115,6 +117,86 @@ public class DeviceListener {
 	 */
 	public void onGyroscopeData(Myo myo, long timestamp, Vector3 gyro) {
 	}
+	/**
+	 * Called when a paired {@link Myo} has provided new orientation, accelerometer and gyroscope data.<br>
+	 * <br>
+	 * The {@link Myo} sends all three together, so this delivers them in a single call instead of three calls to
+	 * {@link #onOrientationData(Myo, long, Quaternion)}, {@link #onAccelerometerData(Myo, long, Vector3)} and 
+	 * {@link #onGyroscopeData(Myo, long, Vector3)}, and without creating any objects. If those methods are 
+	 * implemented as well, they are still called, after this one. The same goes for the {@code Raw} variants,
+	 * such as {@link #onOrientationRaw(Myo, long, float, float, float, float)}.
+	 * <p>
+	 * Note: <em>imu</em> is reused for every call. Its contents are only valid until this method returns;
+	 * copy them if they are needed afterwards.
+	 * </p>
+	 * @param myo The {@link Myo} for this event.
+	 * @param timestamp The timestamp of when the event is received by the SDK. Timestamps are 64 bit unsigned 
+	 * integers that correspond to a number of microseconds since some (unspecified) period in time. 
+	 * @param imu An array of 10 elements: the x, y, z and w components of the orientation quaternion, then the 
+	 * x, y and z accelerometer data in units of g, then the x, y and z gyroscope data in units of deg/s.
+	 */
+	public void onImuData(Myo myo, long timestamp, float[] imu) {
+	}
+	/**
+	 * Called when a paired {@link Myo} has provided new orientation data.<br>
+	 * <br>
+	 * This is the same as {@link #onOrientationData(Myo, long, Quaternion)}, except that the quaternion is passed
+	 * as single-precision components, without creating a {@link Quaternion} object.
+	 * @param myo The {@link Myo} for this event.
+	 * @param timestamp The timestamp of when the event is received by the SDK. Timestamps are 64 bit unsigned 
+	 * integers that correspond to a number of microseconds since some (unspecified) period in time. 
+	 * @param x The x component of the orientation quaternion.
+	 * @param y The y component of the orientation quaternion.
+	 * @param z The z component of the orientation quaternion.
+	 * @param w The w component of the orientation quaternion.
+	 */
+	public void onOrientationRaw(Myo myo, long timestamp, float x, float y, float z, float w) {
+	}
+	/**
+	 * Called when a paired {@link Myo} has provided new orientation data, with the orientation as Euler angles.<br>
+	 * <br>
+	 * The angles are computed natively, without creating any objects, and only for the {@link Myo}s of listeners 
+	 * that implement this method. They are relative to the reference set
+	 * with {@link Myo#setOrientationReference(Quaternion)} or {@link Myo#centerOrientation()}, if any. While
+	 * <em>myo</em> is synced with its +x axis toward the elbow, <em>roll</em> and <em>pitch</em> are negated,
+	 * so that they mean the same whichever way round it is worn.
+	 * @param myo The {@link Myo} for this event.
+	 * @param timestamp The timestamp of when the event is received by the SDK. Timestamps are 64 bit unsigned
+	 * integers that correspond to a number of microseconds since some (unspecified) period in time.
+	 * @param roll The rotation around the x axis, in radians, from -pi to pi.
+	 * @param pitch The rotation around the y axis, in radians, from -pi/2 to pi/2.
+	 * @param yaw The rotation around the z axis, in radians, from -pi to pi.
+	 */
+	public void onOrientationEuler(Myo myo, long timestamp, float roll, float pitch, float yaw) {
+	}
+	/**
+	 * Called when a paired {@link Myo} has provided new accelerometer data in units of g.<br>
+	 * <br>
+	 * This is the same as {@link #onAccelerometerData(Myo, long, Vector3)}, except that the data is passed as
+	 * single-precision components, without creating a {@link Vector3} object.
+	 * @param myo The {@link Myo} for this event.
+	 * @param timestamp The timestamp of when the event is received by the SDK. Timestamps are 64 bit unsigned 
+	 * integers that correspond to a number of microseconds since some (unspecified) period in time. 
+	 * @param x The acceleration along the x axis, in units of g.
+	 * @param y The acceleration along the y axis, in units of g.
+	 * @param z The acceleration along the z axis, in units of g.
+	 */
+	public void onAccelerometerRaw(Myo myo, long timestamp, float x, float y, float z) {
+	}
+	/**
+	 * Called when a paired {@link Myo} has provided new gyroscope data in units of deg/s.<br>
+	 * <br>
+	 * This is the same as {@link #onGyroscopeData(Myo, long, Vector3)}, except that the data is passed as
+	 * single-precision components, without creating a {@link Vector3} object.
+	 * @param myo The {@link Myo} for this event.
+	 * @param timestamp The timestamp of when the event is received by the SDK. Timestamps are 64 bit unsigned 
+	 * integers that correspond to a number of microseconds since some (unspecified) period in time. 
+	 * @param x The angular velocity around the x axis, in units of deg/s.
+	 * @param y The angular velocity around the y axis, in units of deg/s.
+	 * @param z The angular velocity around the z axis, in units of deg/s.
+	 */
+	public void onGyroscopeRaw(Myo myo, long timestamp, float x, float y, float z) {
+	}
 	/**
 	 * Called when a paired {@link Myo} has provided a new RSSI value.
 	 * @param myo The {@link Myo} for this event.
@@ -161,4 +243,77 @@ public class DeviceListener {
 	 */
 	public void onWarmupCompleted(Myo myo, long timestamp, WarmupResult warmupResult) {
 	}
+	/**
+	 * Called when a batch of EMG data from a {@link Myo} is ready.<br>
+	 * <br>
+	 * Instead of one call per EMG frame, frames are collected natively and delivered together once
+	 * the batch is full or its oldest frame is older than the configured latency; see 
+	 * {@link Hub#setEmgBatching(int, int)}. Pending frames are also delivered by {@link Hub#flushEmgBatches()}
+	 * and before <em>myo</em> disconnects or unpairs. 
+	 * <p>
+	 * Note: <em>timestamps</em> and <em>samples</em> are reused for every batch of <em>myo</em>. Their contents
+	 * are only valid until this method returns; copy them if they are needed afterwards.
+	 * </p>
+	 * @param myo The {@link Myo} for this event.
+	 * @param timestamps The timestamps of the frames in this batch. Only the first <em>count</em> elements are valid.
+	 * @param samples A direct buffer holding the frames in this batch, 8 bytes (one per sensor) per frame. Frame 
+	 * <em>i</em> starts at index {@code i * 8}.
+	 * @param count The number of frames in this batch.
+	 * @see #onEmgData(Myo, long, byte[])
+	 */
+	public void onEmgBatch(Myo myo, long[] timestamps, ByteBuffer samples, int count) {
+	}
+	/**
+	 * Called when new EMG features of a {@link Myo} are ready.<br>
+	 * <br>
+	 * The features are computed natively over a sliding window of EMG frames, and delivered every few frames
+	 * once the window is full; see {@link Hub#setEmgFeatures(int, int)}. The window starts over when <em>myo</em>
+	 * disconnects or unpairs.
+	 * <p>
+	 * Note: <em>features</em> is reused for every call. Its contents are only valid until this method returns.
+	 * </p>
+	 * @param myo The {@link Myo} for this event.
+	 * @param timestamp The timestamp of the last EMG frame in the window. Timestamps are 64 bit unsigned 
+	 * integers that correspond to a number of microseconds since some (unspecified) period in time. 
+	 * @param features Every {@link EmgFeature} of every sensor; the value of feature <em>f</em> for sensor
+	 * <em>s</em> is at index {@code f.index(s)}.
+	 * @see EmgFeature
+	 */
+	public void onEmgFeatures(Myo myo, long timestamp, float[] features) {
+	}
+	/**
+	 * Called when a paired {@link Myo} has provided new EMG data and has a filter set.<br>
+	 * <br>
+	 * The frame has gone through the filter set by {@link Myo#setEmgFilter(EmgFilter)}. It is delivered right
+	 * after the raw frame, which still reaches {@link #onEmgData(Myo, long, byte[])}.
+	 * <p>
+	 * Note: <em>emg</em> is reused for every call. Its contents are only valid until this method returns.
+	 * </p>
+	 * @param myo The {@link Myo} for this event.
+	 * @param timestamp The timestamp of when the event is received by the SDK. Timestamps are 64 bit unsigned 
+	 * integers that correspond to a number of microseconds since some (unspecified) period in time.
+	 * @param emg An array of 8 elements, each corresponding to one sensor.
+	 * @see EmgFilter
+	 */
+	public void onEmgFilteredData(Myo myo, long timestamp, float[] emg) {
+	}
+	/**
+	 * Called when a batch of filtered EMG data from a {@link Myo} is ready.<br>
+	 * <br>
+	 * This is the batched counterpart of {@link #onEmgFilteredData(Myo, long, float[])}. Batches are collected 
+	 * and delivered the same way as those of {@link #onEmgBatch(Myo, long[], ByteBuffer, int)}; see 
+	 * {@link Hub#setEmgBatching(int, int)}.
+	 * <p>
+	 * Note: <em>timestamps</em> and <em>samples</em> are reused for every batch of <em>myo</em>. Their contents
+	 * are only valid until this method returns; copy them if they are needed afterwards.
+	 * </p>
+	 * @param myo The {@link Myo} for this event.
+	 * @param timestamps The timestamps of the frames in this batch. Only the first <em>count</em> elements are valid.
+	 * @param samples The frames in this batch, 8 values (one per sensor) per frame. Frame <em>i</em> starts at
+	 * index {@code i * 8}.
+	 * @param count The number of frames in this batch.
+	 * @see EmgFilter
+	 */
+	public void onEmgFilteredBatch(Myo myo, long[] timestamps, float[] samples, int count) {
+	}
 }
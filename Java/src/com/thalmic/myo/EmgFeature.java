@@ -0,0 +1,48 @@
+package com.thalmic.myo;
+
+/**
+ * Time-domain features of EMG data, as delivered to {@link DeviceListener#onEmgFeatures(Myo, long, float[])}.<br>
+ * <br>
+ * Every feature is computed for each of the 8 EMG sensors over a window of frames; see
+ * {@link Hub#setEmgFeatures(int, int)}.
+ *
+ */
+public enum EmgFeature {
+	/**
+	 * The root mean square of the samples in the window.
+	 */
+	rms,
+	/**
+	 * The mean of the absolute values of the samples in the window.
+	 */
+	meanAbsoluteValue,
+	/**
+	 * The waveform length: the sum of the absolute differences between each sample in the window and the one
+	 * before it.
+	 */
+	waveformLength,
+	/**
+	 * The number of samples in the window whose sign is the opposite of the one before it.
+	 */
+	zeroCrossings,
+	/**
+	 * The number of slope sign changes: samples that are greater than both of their neighbours, or less than both.
+	 * Each frame in the window counts the sample of the frame before it.
+	 */
+	slopeSignChanges;
+
+	/**
+	 * The number of sensors each feature is computed for.
+	 */
+	public static final int SENSORS = 8;
+
+	/**
+	 * Returns where this feature of a sensor is in the array passed to
+	 * {@link DeviceListener#onEmgFeatures(Myo, long, float[])}.
+	 * @param sensor The sensor, from 0 to 7.
+	 * @return The index of the value in the array.
+	 */
+	public int index(int sensor) {
+		return ordinal() * SENSORS + sensor;
+	}
+}
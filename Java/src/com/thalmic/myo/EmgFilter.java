@@ -0,0 +1,134 @@
+package com.thalmic.myo;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * A chain of filters for the EMG data of a {@link Myo}, set with {@link Myo#setEmgFilter(EmgFilter)}.<br>
+ * <br>
+ * Stages are applied in the order they are added, to each of the 8 sensors separately. EMG data arrives at 200
+ * frames per second, so every frequency must be between 0 and 100 Hz (exclusive). A typical chain removes mains
+ * hum, keeps the band where the muscle activity is, then turns the result into an envelope:
+ * <pre>
+ * myo.setEmgFilter(new EmgFilter().notch(50, 30).bandPass(20, 90).rectify().envelope(20));
+ * </pre>
+ * The stages run natively, so filtering does not cost any Java allocation per frame.
+ *
+ */
+public final class EmgFilter {
+	//Same as the enums in Hub, stages are passed to the native side as groups of STAGE_SIZE doubles:
+	//type, frequency, quality factor and frames.
+	private static final int STAGE_NOTCH = 0;
+	private static final int STAGE_HIGH_PASS = 1;
+	private static final int STAGE_LOW_PASS = 2;
+	private static final int STAGE_RECTIFY = 3;
+	private static final int STAGE_ENVELOPE = 4;
+	private static final int STAGE_SIZE = 4;
+
+	//Rate of Myo EMG data, in frames per second
+	private static final double SAMPLE_RATE = 200;
+
+	private final List<double[]> stages = new ArrayList<double[]>();
+
+	/**
+	 * Creates an empty filter, which passes EMG data through unchanged.
+	 */
+	public EmgFilter() {
+	}
+
+	/**
+	 * Adds a notch (band-stop) filter, typically used to remove 50 or 60 Hz mains hum.
+	 * @param frequency The center frequency, in Hz.
+	 * @param q The quality factor; higher values make the notch narrower.
+	 * @return This filter.
+	 * @throws IllegalArgumentException If <em>frequency</em> or <em>q</em> is out of range.
+	 */
+	public EmgFilter notch(double frequency, double q) {
+		checkFrequency(frequency);
+		if(!(q > 0)) {
+			throw new IllegalArgumentException("Notch quality factor must be positive");
+		}
+		return add(STAGE_NOTCH, frequency, q, 0);
+	}
+
+	/**
+	 * Adds a second order Butterworth high-pass filter.
+	 * @param frequency The cutoff frequency, in Hz.
+	 * @return This filter.
+	 * @throws IllegalArgumentException If <em>frequency</em> is out of range.
+	 */
+	public EmgFilter highPass(double frequency) {
+		checkFrequency(frequency);
+		return add(STAGE_HIGH_PASS, frequency, 0, 0);
+	}
+
+	/**
+	 * Adds a second order Butterworth low-pass filter.
+	 * @param frequency The cutoff frequency, in Hz.
+	 * @return This filter.
+	 * @throws IllegalArgumentException If <em>frequency</em> is out of range.
+	 */
+	public EmgFilter lowPass(double frequency) {
+		checkFrequency(frequency);
+		return add(STAGE_LOW_PASS, frequency, 0, 0);
+	}
+
+	/**
+	 * Adds a band-pass filter, made of a high-pass filter at <em>low</em> followed by a low-pass filter at
+	 * <em>high</em>.
+	 * @param low The lower cutoff frequency, in Hz.
+	 * @param high The upper cutoff frequency, in Hz.
+	 * @return This filter.
+	 * @throws IllegalArgumentException If a frequency is out of range, or <em>low</em> is not below <em>high</em>.
+	 */
+	public EmgFilter bandPass(double low, double high) {
+		checkFrequency(low);
+		checkFrequency(high);
+		if(!(low < high)) {
+			throw new IllegalArgumentException("Lower cutoff frequency must be below the upper one");
+		}
+		return highPass(low).lowPass(high);
+	}
+
+	/**
+	 * Adds a stage that replaces every sample by its absolute value.
+	 * @return This filter.
+	 */
+	public EmgFilter rectify() {
+		return add(STAGE_RECTIFY, 0, 0, 0);
+	}
+
+	/**
+	 * Adds a moving average over the last <em>frames</em> frames. After {@link #rectify()}, this gives the
+	 * envelope of the signal.
+	 * @param frames The number of frames averaged; at 200 frames per second, 20 frames are 100 ms.
+	 * @return This filter.
+	 * @throws IllegalArgumentException If <em>frames</em> is less than 1.
+	 */
+	public EmgFilter envelope(int frames) {
+		if(frames < 1) {
+			throw new IllegalArgumentException("Envelope must span at least one frame");
+		}
+		return add(STAGE_ENVELOPE, 0, 0, frames);
+	}
+
+	private static void checkFrequency(double frequency) {
+		if(!(frequency > 0 && frequency < SAMPLE_RATE / 2)) {
+			throw new IllegalArgumentException("Filter frequency must be between 0 and " + SAMPLE_RATE / 2 + " Hz");
+		}
+	}
+
+	private EmgFilter add(int type, double frequency, double q, int frames) {
+		stages.add(new double[] { type, frequency, q, frames });
+		return this;
+	}
+
+	//Flattens the stages into the array passed to Myo._setEmgFilter().
+	double[] encode() {
+		double[] encoded = new double[stages.size() * STAGE_SIZE];
+		for(int i = 0; i < stages.size(); i++) {
+			System.arraycopy(stages.get(i), 0, encoded, i * STAGE_SIZE, STAGE_SIZE);
+		}
+		return encoded;
+	}
+}
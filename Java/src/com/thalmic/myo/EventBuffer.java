@@ -0,0 +1,230 @@
+package com.thalmic.myo;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * A reusable buffer of device events, filled by {@link Hub#poll(EventBuffer, int)}.<br>
+ * <br>
+ * Events are stored as fixed-size records in a direct {@link ByteBuffer}, so polling does not allocate any objects.
+ * After a poll, events {@code 0} to {@code size() - 1} can be read with the getters below; each getter only makes
+ * sense for the {@link EventType}s mentioned in its description. The contents are overwritten by the next poll.
+ *
+ */
+public final class EventBuffer {
+
+	/*
+	 * Layout of a record; this has to match struct MyoEvent in the native code.
+	 *
+	 * Each record is 64 bytes in the platform's native byte order:
+	 *     0   int   event type (the ordinal of EventType)
+	 *     8   long  timestamp
+	 *     16  long  address of the native Myo
+	 *     24  40 bytes of event data, which depend on the type
+	 */
+	static final int RECORD_SIZE = 64;
+	private static final int TYPE_OFFSET = 0;
+	private static final int TIMESTAMP_OFFSET = 8;
+	private static final int DATA_OFFSET = 24;
+
+	//values() copies the array on every call, so these are kept around
+	private static final EventType[] EVENT_TYPES = EventType.values();
+	private static final XDirection[] X_DIRECTIONS = XDirection.values();
+	private static final WarmupState[] WARMUP_STATES = WarmupState.values();
+	private static final WarmupResult[] WARMUP_RESULTS = WarmupResult.values();
+	//libmyo's order of these enums differs from the Java one
+	private static final Arm[] ARMS = { Arm.armRight, Arm.armLeft, Arm.armUnknown };
+	private static final Pose[] POSES = { Pose.rest, Pose.fist, Pose.waveIn, Pose.waveOut, Pose.fingersSpread, Pose.doubleTap };
+
+	final ByteBuffer records;
+	final Myo[] myos;
+	int size = 0;
+
+	/**
+	 * Create a buffer that can hold up to <em>capacity</em> events.
+	 * @param capacity The maximum number of events a single poll can return.
+	 * @throws IllegalArgumentException If <em>capacity</em> is less than 1.
+	 */
+	public EventBuffer(int capacity) {
+		if(capacity < 1) {
+			throw new IllegalArgumentException("Capacity must be at least 1");
+		}
+		records = ByteBuffer.allocateDirect(capacity * RECORD_SIZE).order(ByteOrder.nativeOrder());
+		myos = new Myo[capacity];
+	}
+
+	/**
+	 * Returns the maximum number of events this buffer can hold.
+	 * @return The capacity of this buffer.
+	 */
+	public int capacity() {
+		return myos.length;
+	}
+	/**
+	 * Returns the number of events returned by the last poll.
+	 * @return The number of valid events in this buffer.
+	 */
+	public int size() {
+		return size;
+	}
+
+	//Verifies that the index refers to a valid event and returns the offset of its record.
+	private int offset(int index) {
+		if(index < 0 || index >= size) {
+			throw new IndexOutOfBoundsException("Event index " + index + " out of bounds for size " + size);
+		}
+		return index * RECORD_SIZE;
+	}
+
+	/**
+	 * Returns the type of an event.
+	 * @param index The index of the event.
+	 * @return The type of the event.
+	 */
+	public EventType getType(int index) {
+		return EVENT_TYPES[records.getInt(offset(index) + TYPE_OFFSET)];
+	}
+	/**
+	 * Returns the timestamp of an event, in microseconds since an unspecified epoch.
+	 * @param index The index of the event.
+	 * @return The timestamp of the event.
+	 */
+	public long getTimestamp(int index) {
+		return records.getLong(offset(index) + TIMESTAMP_OFFSET);
+	}
+	/**
+	 * Returns the {@link Myo} an event came from. This is the same object the {@link Hub} hands out to listeners.
+	 * @param index The index of the event.
+	 * @return The {@link Myo} of the event.
+	 */
+	public Myo getMyo(int index) {
+		offset(index);
+		return myos[index];
+	}
+
+	/**
+	 * Returns one component of the firmware version of an {@link EventType#paired} or {@link EventType#connected} event.
+	 * @param index The index of the event.
+	 * @param component 0 for the major version, 1 for the minor version, 2 for the patch version,
+	 * 3 for the hardware revision.
+	 * @return The firmware version component. Note that this value is unsigned.
+	 */
+	public int getFirmwareVersion(int index, int component) {
+		return records.getInt(offset(index) + DATA_OFFSET + checkComponent(component, 4) * 4);
+	}
+
+	/**
+	 * Returns the arm of an {@link EventType#armSynced} event.
+	 * @param index The index of the event.
+	 * @return The arm the {@link Myo} is on.
+	 */
+	public Arm getArm(int index) {
+		int arm = records.getInt(offset(index) + DATA_OFFSET);
+		return arm >= 0 && arm < ARMS.length ? ARMS[arm] : Arm.armUnknown;
+	}
+	/**
+	 * Returns the x-direction of an {@link EventType#armSynced} event.
+	 * @param index The index of the event.
+	 * @return The direction of the {@link Myo}'s +x axis.
+	 */
+	public XDirection getXDirection(int index) {
+		int direction = records.getInt(offset(index) + DATA_OFFSET + 4);
+		return direction >= 0 && direction < X_DIRECTIONS.length ? X_DIRECTIONS[direction] : XDirection.xDirectionUnknown;
+	}
+	/**
+	 * Returns the estimated rotation of the {@link Myo} on the arm of an {@link EventType#armSynced} event.
+	 * @param index The index of the event.
+	 * @return The rotation on the arm, in radians.
+	 */
+	public float getRotationOnArm(int index) {
+		return records.getFloat(offset(index) + DATA_OFFSET + 8);
+	}
+	/**
+	 * Returns the warmup state of an {@link EventType#armSynced} event.
+	 * @param index The index of the event.
+	 * @return The warmup state of the {@link Myo}.
+	 */
+	public WarmupState getWarmupState(int index) {
+		int state = records.getInt(offset(index) + DATA_OFFSET + 12);
+		return state >= 0 && state < WARMUP_STATES.length ? WARMUP_STATES[state] : WarmupState.warmupStateUnknown;
+	}
+
+	/**
+	 * Returns one component of the orientation of an {@link EventType#orientation} event.
+	 * @param index The index of the event.
+	 * @param component 0 for x, 1 for y, 2 for z, 3 for w.
+	 * @return The quaternion component.
+	 */
+	public float getOrientation(int index, int component) {
+		return records.getFloat(offset(index) + DATA_OFFSET + checkComponent(component, 4) * 4);
+	}
+	/**
+	 * Returns one axis of the accelerometer data of an {@link EventType#orientation} event.
+	 * @param index The index of the event.
+	 * @param axis 0 for x, 1 for y, 2 for z.
+	 * @return The acceleration, in units of g.
+	 */
+	public float getAccelerometer(int index, int axis) {
+		return records.getFloat(offset(index) + DATA_OFFSET + 16 + checkComponent(axis, 3) * 4);
+	}
+	/**
+	 * Returns one axis of the gyroscope data of an {@link EventType#orientation} event.
+	 * @param index The index of the event.
+	 * @param axis 0 for x, 1 for y, 2 for z.
+	 * @return The angular velocity, in degrees per second.
+	 */
+	public float getGyroscope(int index, int axis) {
+		return records.getFloat(offset(index) + DATA_OFFSET + 28 + checkComponent(axis, 3) * 4);
+	}
+
+	/**
+	 * Returns the pose of an {@link EventType#pose} event.
+	 * @param index The index of the event.
+	 * @return The detected pose.
+	 */
+	public Pose getPose(int index) {
+		int pose = records.getInt(offset(index) + DATA_OFFSET);
+		return pose >= 0 && pose < POSES.length ? POSES[pose] : Pose.unknown;
+	}
+	/**
+	 * Returns the RSSI value of an {@link EventType#rssi} event.
+	 * @param index The index of the event.
+	 * @return The received signal strength.
+	 */
+	public byte getRssi(int index) {
+		return records.get(offset(index) + DATA_OFFSET);
+	}
+	/**
+	 * Returns the battery level of an {@link EventType#batteryLevel} event.
+	 * @param index The index of the event.
+	 * @return The battery level, from 0 to 100.
+	 */
+	public byte getBatteryLevel(int index) {
+		return records.get(offset(index) + DATA_OFFSET);
+	}
+	/**
+	 * Returns the reading of one sensor of an {@link EventType#emg} event.
+	 * @param index The index of the event.
+	 * @param sensor The sensor, from 0 to 7.
+	 * @return The EMG reading.
+	 */
+	public byte getEmg(int index, int sensor) {
+		return records.get(offset(index) + DATA_OFFSET + checkComponent(sensor, 8));
+	}
+	/**
+	 * Returns the result of an {@link EventType#warmupCompleted} event.
+	 * @param index The index of the event.
+	 * @return The result of the warmup.
+	 */
+	public WarmupResult getWarmupResult(int index) {
+		int result = records.getInt(offset(index) + DATA_OFFSET);
+		return result >= 0 && result < WARMUP_RESULTS.length ? WARMUP_RESULTS[result] : WarmupResult.warmupResultUnknown;
+	}
+
+	private static int checkComponent(int component, int count) {
+		if(component < 0 || component >= count) {
+			throw new IndexOutOfBoundsException("Component " + component + " out of bounds for " + count + " components");
+		}
+		return component;
+	}
+}
@@ -0,0 +1,70 @@
+package com.thalmic.myo;
+
+/**
+ * Types of events that can be read from an {@link EventBuffer}.<br>
+ * <br>
+ * Each type corresponds to one or more methods of {@link DeviceListener}.
+ *
+ */
+public enum EventType {
+	/**
+	 * Successfully paired with a {@link Myo}. See {@link DeviceListener#onPair(Myo, long, FirmwareVersion)}.
+	 */
+	paired,
+	/**
+	 * Successfully unpaired from a {@link Myo}. See {@link DeviceListener#onUnpair(Myo, long)}.
+	 */
+	unpaired,
+	/**
+	 * A {@link Myo} has successfully connected. See {@link DeviceListener#onConnect(Myo, long, FirmwareVersion)}.
+	 */
+	connected,
+	/**
+	 * A {@link Myo} has been disconnected. See {@link DeviceListener#onDisconnect(Myo, long)}.
+	 */
+	disconnected,
+	/**
+	 * A {@link Myo} recognized that it is on an arm.
+	 * See {@link DeviceListener#onArmSync(Myo, long, Arm, XDirection, float, WarmupState)}.
+	 */
+	armSynced,
+	/**
+	 * A {@link Myo} was moved or removed from the arm. See {@link DeviceListener#onArmUnsync(Myo, long)}.
+	 */
+	armUnsynced,
+	/**
+	 * Orientation, accelerometer and gyroscope data, which all arrive together.
+	 * See {@link DeviceListener#onOrientationData(Myo, long, Quaternion)},
+	 * {@link DeviceListener#onAccelerometerData(Myo, long, Vector3)} and
+	 * {@link DeviceListener#onGyroscopeData(Myo, long, Vector3)}.
+	 */
+	orientation,
+	/**
+	 * A change in pose has been detected. See {@link DeviceListener#onPose(Myo, long, Pose)}.
+	 */
+	pose,
+	/**
+	 * A RSSI value has been received. See {@link DeviceListener#onRssi(Myo, long, byte)}.
+	 */
+	rssi,
+	/**
+	 * A {@link Myo} has become unlocked. See {@link DeviceListener#onUnlock(Myo, long)}.
+	 */
+	unlocked,
+	/**
+	 * A {@link Myo} has become locked. See {@link DeviceListener#onLock(Myo, long)}.
+	 */
+	locked,
+	/**
+	 * EMG data has been received. See {@link DeviceListener#onEmgData(Myo, long, byte[])}.
+	 */
+	emg,
+	/**
+	 * A battery level value has been received. See {@link DeviceListener#onBatteryLevelReceived(Myo, long, byte)}.
+	 */
+	batteryLevel,
+	/**
+	 * The warmup period of a {@link Myo} has completed. See {@link DeviceListener#onWarmupCompleted(Myo, long, WarmupResult)}.
+	 */
+	warmupCompleted;
+}
@@ -0,0 +1,136 @@
+package com.thalmic.myo;
+
+import java.util.Arrays;
+import java.util.HashSet;
+
+/**
+ * Settings for putting the data of several {@link Myo}s onto one timeline.<br>
+ * <br>
+ * Each {@link Myo} delivers its IMU and EMG data on its own clock, with jitter, and at different rates. A
+ * {@link FrameListener} registered with a {@link FrameAssembler} instead gets one {@link SyncFrame} per tick, holding
+ * the values of every {@link Myo} at the time of the tick. The frames are assembled in native code and written into a
+ * single direct buffer, so there is one call per tick no matter how many {@link Myo}s there are.<br>
+ * <br>
+ * Ticks are the multiples of the tick length on the Myo timestamp clock. The values of a {@link Myo} at a tick are
+ * those of its samples around the tick, either the nearest one or a linear interpolation between the two on either
+ * side (spherical for the orientation). Samples further than the maximum gap from the tick are not used; if a
+ * {@link Myo} has none near enough, its data is flagged as missing in the frame (see {@link SyncFrame#hasImu(int)}).
+ * A tick is assembled once every {@link Myo} that is still streaming has sent data past it, so frames lag the newest
+ * data by up to the maximum gap. Ticks that no {@link Myo} has any data near are skipped
+ * (see {@link SyncFrame#getSkippedTicks()}).<br>
+ * <br>
+ * The settings are copied when the listener is registered; changing them afterwards has no effect on listeners
+ * that are already registered.
+ *
+ */
+public final class FrameAssembler {
+
+	//These int values are passed to the native method instead of the enum.
+	private static final int INTERPOLATION_NEAREST = 0;
+	private static final int INTERPOLATION_LINEAR = 1;
+	/**
+	 * How the values at a tick are computed from the samples around it.
+	 *
+	 */
+	public enum Interpolation {
+		/**
+		 * Take the values of the sample nearest to the tick.
+		 */
+		nearest,
+		/**
+		 * Interpolate linearly between the samples on either side of the tick. The orientation is interpolated
+		 * spherically.
+		 */
+		linear;
+
+		//"Translates" an Interpolation into an integer that can be passed to the native method.
+		protected int translate() {
+			if(this == nearest) {
+				return INTERPOLATION_NEAREST;
+			}
+			else {
+				return INTERPOLATION_LINEAR;
+			}
+		}
+	}
+
+	private final Myo[] myos;
+	private int tickUs = 10000;
+	private Interpolation interpolation = Interpolation.linear;
+	private int maxGapUs = 50000;
+
+	/**
+	 * Create the settings for frames of the given {@link Myo}s. Frames hold the data of the {@link Myo}s in this order.
+	 * @param myos The {@link Myo}s whose data goes into the frames.
+	 * @throws IllegalArgumentException If no {@link Myo}s are given, or one of them is null or given twice.
+	 */
+	public FrameAssembler(Myo... myos) {
+		if(myos == null || myos.length == 0) {
+			throw new IllegalArgumentException("At least one Myo is required");
+		}
+		HashSet<Myo> seen = new HashSet<Myo>();
+		for(Myo myo : myos) {
+			if(myo == null) {
+				throw new IllegalArgumentException("Myo must not be null");
+			}
+			if(!seen.add(myo)) {
+				throw new IllegalArgumentException("A Myo can only be part of a frame once");
+			}
+		}
+		this.myos = Arrays.copyOf(myos, myos.length);
+	}
+
+	/**
+	 * Set the time between two frames. The default is 10000 microseconds, which is 100 frames per second.
+	 * @param tickUs The tick length, in microseconds.
+	 * @return This object, for chaining.
+	 * @throws IllegalArgumentException If <em>tickUs</em> is less than 1.
+	 */
+	public FrameAssembler setTick(int tickUs) {
+		if(tickUs < 1) {
+			throw new IllegalArgumentException("Tick must be at least 1 microsecond");
+		}
+		this.tickUs = tickUs;
+		return this;
+	}
+	/**
+	 * Set how the values at a tick are computed. The default is {@link Interpolation#linear}.
+	 * @param interpolation The interpolation.
+	 * @return This object, for chaining.
+	 */
+	public FrameAssembler setInterpolation(Interpolation interpolation) {
+		if(interpolation == null) {
+			throw new IllegalArgumentException("Interpolation must not be null");
+		}
+		this.interpolation = interpolation;
+		return this;
+	}
+	/**
+	 * Set how far from a tick a sample may be and still be used. This is also how long a {@link Myo} that stops
+	 * sending data holds frames back. The default is 50000 microseconds.
+	 * @param maxGapUs The maximum gap, in microseconds.
+	 * @return This object, for chaining.
+	 * @throws IllegalArgumentException If <em>maxGapUs</em> is negative.
+	 */
+	public FrameAssembler setMaxGap(int maxGapUs) {
+		if(maxGapUs < 0) {
+			throw new IllegalArgumentException("Maximum gap must not be negative");
+		}
+		this.maxGapUs = maxGapUs;
+		return this;
+	}
+
+	//Getters for the hubs, which pass these to the native code
+	Myo[] getMyos() {
+		return myos;
+	}
+	int getTick() {
+		return tickUs;
+	}
+	int getInterpolation() {
+		return interpolation.translate();
+	}
+	int getMaxGap() {
+		return maxGapUs;
+	}
+}
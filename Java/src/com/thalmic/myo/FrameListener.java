@@ -0,0 +1,20 @@
+package com.thalmic.myo;
+
+/**
+ * Receives the synchronized frames of a {@link FrameAssembler}.<br>
+ * <br>
+ * Register one with {@link Hub#addFrameListener(FrameListener, FrameAssembler)} or
+ * {@link ReplayHub#addFrameListener(FrameListener, FrameAssembler)}. It is called on the thread that runs the hub,
+ * once per tick, with the data of every {@link Myo} of the assembler at that tick.
+ *
+ */
+public interface FrameListener {
+	/**
+	 * Called when a frame has been assembled.<br>
+	 * <br>
+	 * The same {@link SyncFrame} object is passed to every call and overwritten by the next frame, so its contents
+	 * are only valid until this method returns. Copy out whatever is needed later.
+	 * @param frame The frame of this tick.
+	 */
+	public void onFrame(SyncFrame frame);
+}
@@ -1,5 +1,8 @@
 package com.thalmic.myo;
 
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.file.Path;
 import java.util.Collection;
 import java.util.HashMap;
 
@@ -68,6 +71,8 @@ public final class Hub {
 	//This map matches DeviceListener objects to physical locations in memory.
 	//For details please see the addListener and removeListener methods.
 	private HashMap<DeviceListener, Long> deviceListenerAddresses = new HashMap<DeviceListener, Long>();
+	//Same for FrameListener objects and their native wrappers, which hold the FrameAssembler.
+	private HashMap<FrameListener, Long> frameListenerAddresses = new HashMap<FrameListener, Long>();
 	
 	/*
 	 * The physical location in memory that the C++ Hub object is stored.
@@ -149,7 +154,7 @@ public final class Hub {
 	 * any method, excluding this one and {@link #isReleased()}, will throw a {@link MyoException}.<br>
 	 * <br>
 	 * Calling this method on a {@link Hub} that has already been released will have no effect. This method also
-	 * removes all device listeners.
+	 * removes all device listeners and frame listeners.
 	 */
 	public void release() {
 		if(!deleted) {
@@ -159,10 +164,19 @@ public final class Hub {
 			//For more information see addListener and removeListener
 			for(long address : addresses) {
 				_removeDeviceListener(address);
+				_deleteListenerWrapper(address);
 			}
 			deviceListenerAddresses.clear();
+			for(long address : frameListenerAddresses.values()) {
+				_removeFrameListener(address);
+				_deleteFrameAssembler(address);
+			}
+			frameListenerAddresses.clear();
 			
+			//Also stops the event pump and the recording, if they are running
 			_release();
+			async = false;
+			recording = false;
 			deleted = true;
 		}
 	}
@@ -186,9 +200,13 @@ public final class Hub {
 	 * Run the event loop for the specified duration (in milliseconds).<br>
 	 * <br>
 	 * During that time, this method will block. For more information, see 
-	 * <a href="http://developerblog.myo.com/hub-run/">http://developerblog.myo.com/hub-run/</a>.
+	 * <a href="http://developerblog.myo.com/hub-run/">http://developerblog.myo.com/hub-run/</a>.<br>
+	 * <br>
+	 * In async mode (see {@link #startAsync()}), this method dispatches queued events to the listeners for the
+	 * specified duration instead, on the calling thread.
 	 * @param durationMs The duration to run the event loop for, in milliseconds.
-	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released, or if the event pump 
+	 * has stopped because of an error.
 	 * @see #runOnce(int)
 	 */
 	public void run(int durationMs) {
@@ -202,9 +220,13 @@ public final class Hub {
 	 * Run the event loop until a single event occurs, or the specified duration (in milliseconds) has elapsed.<br>
 	 * <br>
 	 * During that time, this method will block. For more information, see 
-	 * <a href="http://developerblog.myo.com/hub-run/">http://developerblog.myo.com/hub-run/</a>.
+	 * <a href="http://developerblog.myo.com/hub-run/">http://developerblog.myo.com/hub-run/</a>.<br>
+	 * <br>
+	 * In async mode (see {@link #startAsync()}), this method dispatches a single queued event instead, waiting 
+	 * for up to the specified duration if the queue is empty.
 	 * @param durationMs The duration to run the even loop for, in milliseconds.
-	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released, or if the event pump 
+	 * has stopped because of an error.
 	 * @see #run(int)
 	 */
 	public void runOnce(int durationMs) {
@@ -213,17 +235,15 @@ public final class Hub {
 	}
 	
 	//Native method that directly calls Hub::waitForMyo().
-	//Returns true if Myo is connected, false if timed out.
-	private native boolean _waitForMyo(int duration);
-	//A physical location in memory that the native C++ Myo object is stored.
-	//Set by the _waitForMyo() native method after it returns.
-	private long _myoAddress;
+	//Returns the Myo object of the paired device, or null if timed out.
+	private native Myo _waitForMyo(int duration);
 	/**
 	 * Wait for a {@link Myo} to become paired.<br>
 	 * <br>
 	 * This method blocks indefinitely until a {@link Myo} is found. This method must not be called concurrently
 	 * with {@link #run(int)} or {@link #runOnce(int)}.
-	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released, or if the {@link Hub} is
+	 * in async mode.
 	 * @return A paired {@link Myo}.
 	 */
 	public Myo waitForMyo() {
@@ -235,12 +255,296 @@ public final class Hub {
 	 * If <em>timeoutMs</em> is zero, this method blocks indefinitely until a {@link Myo} is found. 
 	 * This method must not be called concurrently with {@link #run(int)} or {@link #runOnce(int)}.
 	 * @param timeoutMs The amount of milliseconds to wait for before timing out.
-	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released, or if the {@link Hub} is
+	 * in async mode.
 	 * @return A paired {@link Myo}, or {@code null} if wait timed out.
 	 */
 	public Myo waitForMyo(int timeoutMs) {
 		checkExcept();
-		return _waitForMyo(timeoutMs) ? new Myo(_myoAddress) : null;
+		//The event pump owns the event loop in async mode
+		if(async) {
+			throw new MyoException("waitForMyo() cannot be used while the Hub is in async mode");
+		}
+		return _waitForMyo(timeoutMs);
+	}
+	
+	/*
+	 * Async mode
+	 * 
+	 * Normally the event loop only runs while run() or runOnce() is called, and listeners are called from within it.
+	 * A slow listener then holds up the event loop itself, and events pile up inside libmyo or get lost.
+	 * 
+	 * In async mode, a native thread runs the event loop by itself, and puts the events into a queue. run() and 
+	 * runOnce() dispatch events from that queue to the listeners, and poll() copies them into an EventBuffer.
+	 * Only one thread may read from the queue at a time.
+	 */
+	private boolean async = false;
+	
+	//Same as LockingPolicy, these are passed to the native method instead of the enum.
+	private static final int OVERFLOW_BLOCK = 0;
+	private static final int OVERFLOW_DROP_OLDEST = 1;
+	private static final int OVERFLOW_DROP_NEWEST = 2;
+	private static final int OVERFLOW_COALESCE = 3;
+	/**
+	 * What happens to events in async mode when the queue is full, because events are not consumed fast enough.
+	 * @see Hub#startAsync(int, OverflowPolicy)
+	 */
+	public enum OverflowPolicy {
+		/**
+		 * Wait for the consumer to make room. No events are lost, but while waiting, the event loop is held up the
+		 * same way as a slow listener holds it up outside of async mode.
+		 */
+		overflowPolicyBlock,
+		/**
+		 * Discard the oldest queued event to make room for the new one. The consumer always sees the most
+		 * recent events.
+		 */
+		overflowPolicyDropOldest,
+		/**
+		 * Discard the new event. The consumer sees everything up to the point the queue filled up.
+		 */
+		overflowPolicyDropNewest,
+		/**
+		 * Until there is room, keep only the latest orientation, RSSI and battery level event of each {@link Myo}
+		 * (replacing older ones) and discard EMG events. All other events, such as poses, locks and connections, are
+		 * never lost; the event loop waits for room for them as with {@link #overflowPolicyBlock}.
+		 */
+		overflowPolicyCoalesce;
+		
+		//"Translates" an OverflowPolicy into an integer that can be passed to the native method.
+		protected int translate() {
+			switch(this) {
+			case overflowPolicyBlock:
+				return OVERFLOW_BLOCK;
+			case overflowPolicyDropOldest:
+				return OVERFLOW_DROP_OLDEST;
+			case overflowPolicyCoalesce:
+				return OVERFLOW_COALESCE;
+			default:
+				return OVERFLOW_DROP_NEWEST;
+			}
+		}
+	}
+	
+	//Native method that starts the event pump thread with a queue of the given capacity and overflow policy.
+	private native void _startAsync(int queueCapacity, int policy);
+	//Native method that stops the event pump thread and discards the queue.
+	private native void _stopAsync();
+	//Native method that copies queued events into the direct buffer, and their Myos into the array.
+	//Returns the number of events copied.
+	private native int _poll(ByteBuffer records, Myo[] myos, int capacity, int timeoutMs);
+	private native long _getDroppedEventCount();
+	private native int _getQueuedEventCount();
+	//Native method that returns a snapshot of the queue counters, in the format described in QueueStats.
+	private native long[] _getQueueStats();
+	/**
+	 * Start async mode with a queue of 4096 events, which drops new events when it is full.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 * @see #startAsync(int, OverflowPolicy)
+	 */
+	public void startAsync() {
+		startAsync(4096, OverflowPolicy.overflowPolicyDropNewest);
+	}
+	/**
+	 * Start async mode with a queue that drops new events when it is full.
+	 * @param queueCapacity The number of events the queue can hold. This is rounded up to a power of two.
+	 * @throws IllegalArgumentException If <em>queueCapacity</em> is less than 1.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released, or the thread could not be started.
+	 * @see #startAsync(int, OverflowPolicy)
+	 */
+	public void startAsync(int queueCapacity) {
+		startAsync(queueCapacity, OverflowPolicy.overflowPolicyDropNewest);
+	}
+	/**
+	 * Start async mode.<br>
+	 * <br>
+	 * In async mode, a native thread runs the event loop continuously and queues up all events, so device 
+	 * communication is never held up by application code. Queued events can be consumed in one of two ways:
+	 * <ul>
+	 * <li>{@link #run(int)} and {@link #runOnce(int)} dispatch them to the registered listeners, on the calling thread.
+	 * <li>{@link #poll(EventBuffer, int)} copies them into an {@link EventBuffer}, without calling any listeners.
+	 * </ul>
+	 * Only one thread may consume events at a time. What happens when the queue fills up because events are not
+	 * consumed fast enough is decided by <em>policy</em>; {@link #getQueueStats()} shows how often that happens.<br>
+	 * <br>
+	 * Calling this method while already in async mode has no effect.
+	 * @param queueCapacity The number of events the queue can hold. This is rounded up to a power of two.
+	 * @param policy What to do with events when the queue is full.
+	 * @throws IllegalArgumentException If <em>queueCapacity</em> is less than 1.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released, or the thread could not be started.
+	 */
+	public void startAsync(int queueCapacity, OverflowPolicy policy) {
+		checkExcept();
+		if(queueCapacity < 1) {
+			throw new IllegalArgumentException("Queue capacity must be at least 1");
+		}
+		if(async) {
+			return;
+		}
+		_startAsync(queueCapacity, policy.translate());
+		async = true;
+	}
+	/**
+	 * Stop async mode. Any events still in the queue are discarded.<br>
+	 * <br>
+	 * Calling this method when not in async mode has no effect.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public void stopAsync() {
+		checkExcept();
+		if(!async) {
+			return;
+		}
+		_stopAsync();
+		async = false;
+	}
+	/**
+	 * Returns whether this {@link Hub} is in async mode.
+	 * @return Whether this {@link Hub} is in async mode.
+	 * @see #startAsync(int)
+	 */
+	public boolean isAsync() {
+		return async;
+	}
+	/**
+	 * Take queued events and store them in <em>buffer</em>, without calling any listeners.<br>
+	 * <br>
+	 * If the queue is empty, this method waits for up to <em>timeoutMs</em> milliseconds for an event to arrive.
+	 * It then returns as many events as are queued, up to the capacity of the buffer. 
+	 * @param buffer The buffer to store the events in. Its previous contents are overwritten.
+	 * @param timeoutMs The maximum amount of milliseconds to wait for an event.
+	 * @return The number of events stored in the buffer, which is 0 if the wait timed out.
+	 * @throws IllegalStateException If this {@link Hub} is not in async mode.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released, or if the event pump has stopped
+	 * because of an error.
+	 */
+	public int poll(EventBuffer buffer, int timeoutMs) {
+		checkExcept();
+		if(!async) {
+			throw new IllegalStateException("poll() can only be used in async mode");
+		}
+		buffer.size = 0;
+		buffer.size = _poll(buffer.records, buffer.myos, buffer.capacity(), timeoutMs);
+		return buffer.size;
+	}
+	/**
+	 * Returns a snapshot of the counters of the async mode queue.<br>
+	 * <br>
+	 * The counters start at zero when async mode is started and are kept after it is stopped, until it is 
+	 * started again. This method can be called from any thread.
+	 * @return The queue statistics.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public QueueStats getQueueStats() {
+		checkExcept();
+		return new QueueStats(_getQueueStats());
+	}
+	/**
+	 * Returns the number of events dropped since async mode was started, because the queue was full.<br>
+	 * <br>
+	 * If this number goes up, events are not consumed fast enough; consider a larger queue, or moving slow work
+	 * out of the consuming thread.
+	 * @return The number of dropped events.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public long getDroppedEventCount() {
+		checkExcept();
+		return _getDroppedEventCount();
+	}
+	/**
+	 * Returns the number of events currently waiting in the queue, or 0 if not in async mode.
+	 * @return The number of queued events.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public int getQueuedEventCount() {
+		checkExcept();
+		return _getQueuedEventCount();
+	}
+	
+	//Native method that returns a direct buffer over the state block of the native Myo, or null if it has none yet.
+	private native ByteBuffer _getState(long myoAddress);
+	/**
+	 * Returns a view of the latest state of a {@link Myo}, which can be read at any time without listening
+	 * to events. See {@link MyoState} for details.<br>
+	 * <br>
+	 * Every call returns a new {@link MyoState}, so call this once per {@link Myo} and keep the result.
+	 * @param myo A {@link Myo} of this {@link Hub}.
+	 * @return The state of <em>myo</em>, or {@code null} if no event from <em>myo</em> has been received yet.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public MyoState getState(Myo myo) {
+		checkExcept();
+		ByteBuffer block = _getState(myo.getNativeAddress());
+		return block != null ? new MyoState(myo, block) : null;
+	}
+	
+	/*
+	 * Recording
+	 * 
+	 * While recording, the native code writes every event to a session log as it decodes it, before any listener
+	 * sees it, so recording doesn't create any Java objects. The file is written by a native thread of its own.
+	 */
+	private boolean recording = false;
+	
+	//Native method that creates the session log and starts writing events to it.
+	private native void _startRecording(String path) throws IOException;
+	//Native method that stops recording and closes the session log.
+	private native void _stopRecording() throws IOException;
+	private native long _getRecordingDroppedEventCount();
+	/**
+	 * Start writing every event of every {@link Myo} to a session log.<br>
+	 * <br>
+	 * The log is a compact binary file: a 64 byte header, followed by blocks of up to 1024 fixed-size records of
+	 * 64 bytes each, all little-endian. Every record holds the MAC address of the {@link Myo}, the event type, the 
+	 * timestamp and the event data, which is laid out the same way as in an {@link EventBuffer} record. See 
+	 * SessionRecorder.h in the native sources for the exact format.<br>
+	 * <br>
+	 * Events are recorded whether or not any listener is registered, and in async mode as soon as the event pump
+	 * receives them. If a recording is already in progress, it is stopped first.
+	 * @param file The file to write to. It is overwritten if it exists.
+	 * @throws IOException If the file could not be created.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 * @see #stopRecording()
+	 */
+	public void startRecording(Path file) throws IOException {
+		checkExcept();
+		recording = false;
+		_startRecording(file.toAbsolutePath().toString());
+		recording = true;
+	}
+	/**
+	 * Stop recording, and close the session log once everything recorded so far has been written.<br>
+	 * <br>
+	 * Calling this method when not recording has no effect.
+	 * @throws IOException If writing the log failed at some point. The log is still valid up to the last event that
+	 * was written before the failure.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public void stopRecording() throws IOException {
+		checkExcept();
+		if(!recording) {
+			return;
+		}
+		recording = false;
+		_stopRecording();
+	}
+	/**
+	 * Returns whether events are being recorded.
+	 * @return Whether events are being recorded.
+	 * @see #startRecording(Path)
+	 */
+	public boolean isRecording() {
+		return recording;
+	}
+	/**
+	 * Returns the number of events that were left out of the current (or last) recording, because the disk could
+	 * not keep up. Events are dropped instead of holding up event delivery.
+	 * @return The number of dropped events.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public long getRecordingDroppedEventCount() {
+		checkExcept();
+		return _getRecordingDroppedEventCount();
 	}
 	
 	/*
@@ -257,14 +561,43 @@ public final class Hub {
 	 * The address of that wrapper object is then passed from the native code back to the Java addListener()
 	 * method. The Java code stores the DeviceListener reference and wrapper address into the map declared earlier.
 	 * When removeListener() is called, the code retrieves the address of the wrapper from the map, and passes
-	 * it into a native method, which removes the listener and destroys the wrapper.
+	 * it into native methods, which remove the listener and destroy the wrapper. Wrappers are created and destroyed
+	 * apart from registering them, since ReplayHub dispatches to the same kind of wrapper.
 	 * 
 	 * Because calling Java methods from C++ can be costly, some optimization is used. When addListener() is
-	 * called, it checks each DeviceListener method to see if it's overridden. That information is then passed
-	 * to the native code. When the Myo API calls a listener method that is not implemented by the Java code,
-	 * the C++ code will just return immediately, since there's no use calling an empty method.
+	 * called, it checks each DeviceListener method to see if it's overridden, and passes the result to the native
+	 * code as a bitmask of the CALLBACK_ constants below. The native dispatcher only hands a wrapper the event types
+	 * that reach one of its implemented methods, so an event type that no listener cares about is dropped before
+	 * any listener is called at all. If addListener() is given Myos, the dispatcher also skips the wrapper for
+	 * events of any other Myo.
 	 * 
 	 */
+	//Bits of the callbacks mask passed to _createListenerWrapper(). These must match ListenerWrapper::Callback.
+	private static final int CALLBACK_PAIR = 1 << 0;
+	private static final int CALLBACK_UNPAIR = 1 << 1;
+	private static final int CALLBACK_CONNECT = 1 << 2;
+	private static final int CALLBACK_DISCONNECT = 1 << 3;
+	private static final int CALLBACK_ARM_SYNC = 1 << 4;
+	private static final int CALLBACK_ARM_UNSYNC = 1 << 5;
+	private static final int CALLBACK_UNLOCK = 1 << 6;
+	private static final int CALLBACK_LOCK = 1 << 7;
+	private static final int CALLBACK_POSE = 1 << 8;
+	private static final int CALLBACK_ORIENTATION_DATA = 1 << 9;
+	private static final int CALLBACK_ACCELEROMETER_DATA = 1 << 10;
+	private static final int CALLBACK_GYROSCOPE_DATA = 1 << 11;
+	private static final int CALLBACK_RSSI = 1 << 12;
+	private static final int CALLBACK_BATTERY_LEVEL_RECEIVED = 1 << 13;
+	private static final int CALLBACK_EMG_DATA = 1 << 14;
+	private static final int CALLBACK_WARMUP_COMPLETED = 1 << 15;
+	private static final int CALLBACK_EMG_BATCH = 1 << 16;
+	private static final int CALLBACK_IMU_DATA = 1 << 17;
+	private static final int CALLBACK_ORIENTATION_RAW = 1 << 18;
+	private static final int CALLBACK_ACCELEROMETER_RAW = 1 << 19;
+	private static final int CALLBACK_GYROSCOPE_RAW = 1 << 20;
+	private static final int CALLBACK_EMG_FEATURES = 1 << 21;
+	private static final int CALLBACK_EMG_FILTERED_DATA = 1 << 22;
+	private static final int CALLBACK_EMG_FILTERED_BATCH = 1 << 23;
+	private static final int CALLBACK_ORIENTATION_EULER = 1 << 24;
 	//This method checks if a certain method is overriden by the DeviceListener object.
 	private static boolean isImplemented(DeviceListener listener, String name, Class<?>... paramTypes) {
 		try {
@@ -279,56 +612,146 @@ public final class Hub {
 		}
 		return false;
 	}
-	//Native method that creates a wrapper, registers the listener and returns the address of the wrapper.
-	//For more information see above.
-	//This long list of boolean values is used to determine if a certain method is actually used in the listener.
-	private native long _addDeviceListener(DeviceListener listener, 
-			boolean onPairImplemented,
-			boolean onUnpairImplemented,
-			boolean onConnectImplemented,
-			boolean onDisconnectImplemented,
-			boolean onArmSyncImplemented,
-			boolean onArmUnsyncImplemented,
-			boolean onUnlockImplemented,
-			boolean onLockImplemented,
-			boolean onPoseImplemented,
-			boolean onOrientationDataImplemented,
-			boolean onAccelerometerDataImplemented,
-			boolean onGyroscopeDataImplemented,
-			boolean onRssiImplemented,
-			boolean onBatteryLevelReceivedImplemented,
-			boolean onEmgDataImplemented, 
-			boolean onWarmupCompletedImplemented);
+	//Returns the CALLBACK_ bits of every method that the listener implements.
+	private static int implementedCallbacks(DeviceListener listener) {
+		int callbacks = 0;
+		if(isImplemented(listener, "onPair", Myo.class, long.class, FirmwareVersion.class)) {
+			callbacks |= CALLBACK_PAIR;
+		}
+		if(isImplemented(listener, "onUnpair", Myo.class, long.class)) {
+			callbacks |= CALLBACK_UNPAIR;
+		}
+		if(isImplemented(listener, "onConnect", Myo.class, long.class, FirmwareVersion.class)) {
+			callbacks |= CALLBACK_CONNECT;
+		}
+		if(isImplemented(listener, "onDisconnect", Myo.class, long.class)) {
+			callbacks |= CALLBACK_DISCONNECT;
+		}
+		if(isImplemented(listener, "onArmSync", Myo.class, long.class, Arm.class, XDirection.class, float.class, WarmupState.class)) {
+			callbacks |= CALLBACK_ARM_SYNC;
+		}
+		if(isImplemented(listener, "onArmUnsync", Myo.class, long.class)) {
+			callbacks |= CALLBACK_ARM_UNSYNC;
+		}
+		if(isImplemented(listener, "onUnlock", Myo.class, long.class)) {
+			callbacks |= CALLBACK_UNLOCK;
+		}
+		if(isImplemented(listener, "onLock", Myo.class, long.class)) {
+			callbacks |= CALLBACK_LOCK;
+		}
+		if(isImplemented(listener, "onPose", Myo.class, long.class, Pose.class)) {
+			callbacks |= CALLBACK_POSE;
+		}
+		if(isImplemented(listener, "onOrientationData", Myo.class, long.class, Quaternion.class)) {
+			callbacks |= CALLBACK_ORIENTATION_DATA;
+		}
+		if(isImplemented(listener, "onAccelerometerData", Myo.class, long.class, Vector3.class)) {
+			callbacks |= CALLBACK_ACCELEROMETER_DATA;
+		}
+		if(isImplemented(listener, "onGyroscopeData", Myo.class, long.class, Vector3.class)) {
+			callbacks |= CALLBACK_GYROSCOPE_DATA;
+		}
+		if(isImplemented(listener, "onRssi", Myo.class, long.class, byte.class)) {
+			callbacks |= CALLBACK_RSSI;
+		}
+		if(isImplemented(listener, "onBatteryLevelReceived", Myo.class, long.class, byte.class)) {
+			callbacks |= CALLBACK_BATTERY_LEVEL_RECEIVED;
+		}
+		if(isImplemented(listener, "onEmgData", Myo.class, long.class, byte[].class)) {
+			callbacks |= CALLBACK_EMG_DATA;
+		}
+		if(isImplemented(listener, "onWarmupCompleted", Myo.class, long.class, WarmupResult.class)) {
+			callbacks |= CALLBACK_WARMUP_COMPLETED;
+		}
+		if(isImplemented(listener, "onEmgBatch", Myo.class, long[].class, ByteBuffer.class, int.class)) {
+			callbacks |= CALLBACK_EMG_BATCH;
+		}
+		if(isImplemented(listener, "onImuData", Myo.class, long.class, float[].class)) {
+			callbacks |= CALLBACK_IMU_DATA;
+		}
+		if(isImplemented(listener, "onOrientationRaw", Myo.class, long.class, float.class, float.class, float.class, float.class)) {
+			callbacks |= CALLBACK_ORIENTATION_RAW;
+		}
+		if(isImplemented(listener, "onAccelerometerRaw", Myo.class, long.class, float.class, float.class, float.class)) {
+			callbacks |= CALLBACK_ACCELEROMETER_RAW;
+		}
+		if(isImplemented(listener, "onGyroscopeRaw", Myo.class, long.class, float.class, float.class, float.class)) {
+			callbacks |= CALLBACK_GYROSCOPE_RAW;
+		}
+		if(isImplemented(listener, "onEmgFeatures", Myo.class, long.class, float[].class)) {
+			callbacks |= CALLBACK_EMG_FEATURES;
+		}
+		if(isImplemented(listener, "onEmgFilteredData", Myo.class, long.class, float[].class)) {
+			callbacks |= CALLBACK_EMG_FILTERED_DATA;
+		}
+		if(isImplemented(listener, "onEmgFilteredBatch", Myo.class, long[].class, float[].class, int.class)) {
+			callbacks |= CALLBACK_EMG_FILTERED_BATCH;
+		}
+		if(isImplemented(listener, "onOrientationEuler", Myo.class, long.class, float.class, float.class, float.class)) {
+			callbacks |= CALLBACK_ORIENTATION_EULER;
+		}
+		return callbacks;
+	}
+	//Native method that creates a wrapper and returns its address. For more information see above.
+	//The wrapper hands out the Java Myo objects of the native peer table at peersAddress.
+	//callbacks is a bitmask of the CALLBACK_ constants of the methods that the listener implements.
+	private static native long _createListenerWrapper(long peersAddress, DeviceListener listener, int callbacks);
+	//Native method that destroys a wrapper. The wrapper must not be registered anywhere anymore.
+	static native void _deleteListenerWrapper(long address);
+	//Creates a native wrapper for the listener and returns its address.
+	//ReplayHub uses the same wrappers, so this is shared with it.
+	static long createListenerWrapper(long peersAddress, DeviceListener listener) {
+		return _createListenerWrapper(peersAddress, listener, implementedCallbacks(listener));
+	}
+	//Native method that returns the address of the peer table of the native Hub.
+	private native long _getPeers();
+	//Native method that registers a wrapper with the native Hub, or replaces the Myos of one already registered.
+	//myos holds the native addresses of the Myos the listener is limited to, and is empty if it gets every Myo.
+	private native void _addDeviceListener(long address, long[] myos);
 	/**
 	 * Register a listener to be called when device events occur. 
 	 * @param listener The listener to register.
 	 * @throws MyoException If this {@link Hub}'s resources have already been released.
 	 */
 	public void addListener(DeviceListener listener) {
+		addListener(listener, new Myo[0]);
+	}
+	/**
+	 * Register a listener to be called when device events of certain {@link Myo}s occur.<br>
+	 * <br>
+	 * The listener is not called at all for events of other {@link Myo}s, which is cheaper than checking the
+	 * {@link Myo} in each callback. If no {@link Myo}s are given, the listener gets events of every {@link Myo},
+	 * same as {@link #addListener(DeviceListener)}. Calling this method for a listener that is already registered
+	 * replaces the {@link Myo}s it is limited to.
+	 * @param listener The listener to register.
+	 * @param only The {@link Myo}s whose events the listener gets.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public void addListener(DeviceListener listener, Myo... only) {
 		checkExcept();
-		//Call native method and check if each method is implemented
-		long address = _addDeviceListener(listener,
-				isImplemented(listener, "onPair", Myo.class, long.class, FirmwareVersion.class),
-				isImplemented(listener, "onUnpair", Myo.class, long.class),
-				isImplemented(listener, "onConnect", Myo.class, long.class, FirmwareVersion.class),
-				isImplemented(listener, "onDisconnect", Myo.class, long.class),
-				isImplemented(listener, "onArmSync", Myo.class, long.class, Arm.class, XDirection.class, float.class, WarmupState.class),
-				isImplemented(listener, "onArmUnsync", Myo.class, long.class),
-				isImplemented(listener, "onUnlock", Myo.class, long.class),
-				isImplemented(listener, "onLock", Myo.class, long.class),
-				isImplemented(listener, "onPose", Myo.class, long.class, Pose.class),
-				isImplemented(listener, "onOrientationData", Myo.class, long.class, Quaternion.class),
-				isImplemented(listener, "onAccelerometerData", Myo.class, long.class, Vector3.class),
-				isImplemented(listener, "onGyroscopeData", Myo.class, long.class, Vector3.class),
-				isImplemented(listener, "onRssi", Myo.class, long.class, byte.class),
-				isImplemented(listener, "onBatteryLevelReceived", Myo.class, long.class, byte.class),
-				isImplemented(listener, "onEmgData", Myo.class, long.class, byte[].class),
-				isImplemented(listener, "onWarmupCompleted", Myo.class, long.class, WarmupResult.class));
+		long[] myos = nativeAddresses(only);
+		Long registered = deviceListenerAddresses.get(listener);
+		if(registered != null) {
+			_addDeviceListener(registered, myos);
+			return;
+		}
+		long address = createListenerWrapper(_getPeers(), listener);
+		_setEmgBatching(address, emgBatchFrames, emgBatchLatencyMs);
+		_setEmgFeatures(address, emgFeatureWindow, emgFeatureHop);
+		_addDeviceListener(address, myos);
 		//Store the wrapper address in the map
 		deviceListenerAddresses.put(listener, address);
 	}
+	//Returns the native addresses of the Myos, as passed to _addDeviceListener().
+	static long[] nativeAddresses(Myo[] myos) {
+		long[] addresses = new long[myos.length];
+		for(int i = 0; i < myos.length; i ++) {
+			addresses[i] = myos[i].getNativeAddress();
+		}
+		return addresses;
+	}
 	
-	//Native method that removes the registered listener and destroys the wrapper.
+	//Native method that removes the registered listener. The wrapper is destroyed separately.
 	private native void _removeDeviceListener(long address);
 	/**
 	 * Remove a previously registered listener. If the listener was never registered, this method will do nothing.
@@ -342,8 +765,151 @@ public final class Hub {
 			return;
 		}
 		//Take the address and pass into native method
-		_removeDeviceListener(deviceListenerAddresses.get(listener));
+		long address = deviceListenerAddresses.get(listener);
+		_removeDeviceListener(address);
+		_deleteListenerWrapper(address);
 		//Remove from map so we don't accidentally use it again and corrupt the heap
 		deviceListenerAddresses.remove(listener);
 	}
+
+	//Native method that creates the wrapper of a FrameListener, with its native FrameAssembler, and returns its
+	//address. The assembler writes frames into buffer, which is the direct buffer of frame.
+	//ReplayHub uses the same wrappers, so this is shared with it.
+	static native long _createFrameAssembler(FrameListener listener, SyncFrame frame, ByteBuffer buffer, long[] myos,
+			int tickUs, int interpolation, int maxGapUs);
+	//Native method that destroys a frame listener wrapper. The wrapper must not be registered anywhere anymore.
+	static native void _deleteFrameAssembler(long address);
+	//Creates the native wrapper of a FrameListener and returns its address. Shared with ReplayHub.
+	static long createFrameAssembler(FrameListener listener, FrameAssembler assembler) {
+		Myo[] myos = assembler.getMyos();
+		SyncFrame frame = new SyncFrame(myos);
+		return _createFrameAssembler(listener, frame, frame.frame, nativeAddresses(myos),
+				assembler.getTick(), assembler.getInterpolation(), assembler.getMaxGap());
+	}
+	//Native method that registers a frame listener wrapper for the Myos of its assembler.
+	private native void _addFrameListener(long address);
+	//Native method that removes a registered frame listener wrapper. The wrapper is destroyed separately.
+	private native void _removeFrameListener(long address);
+	/**
+	 * Register a listener to be called with synchronized frames of several {@link Myo}s.<br>
+	 * <br>
+	 * The listener gets one {@link SyncFrame} per tick, assembled from the IMU and EMG data of the {@link Myo}s of
+	 * <em>assembler</em> as described in {@link FrameAssembler}. Calling this method for a listener that is already
+	 * registered replaces its {@link FrameAssembler}, and starts over with an empty timeline.
+	 * @param listener The listener to register.
+	 * @param assembler The {@link Myo}s and settings of the frames.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public void addFrameListener(FrameListener listener, FrameAssembler assembler) {
+		checkExcept();
+		removeFrameListener(listener);
+		long address = createFrameAssembler(listener, assembler);
+		_addFrameListener(address);
+		frameListenerAddresses.put(listener, address);
+	}
+	/**
+	 * Remove a previously registered frame listener. If the listener was never registered, this method will do
+	 * nothing. Samples that had not made it into a frame yet are dropped.
+	 * @param listener The listener to remove.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public void removeFrameListener(FrameListener listener) {
+		checkExcept();
+		Long address = frameListenerAddresses.remove(listener);
+		if(address == null) {
+			return;
+		}
+		_removeFrameListener(address);
+		_deleteFrameAssembler(address);
+	}
+	
+	//EMG batching parameters applied to every registered listener.
+	//See DeviceListener.onEmgBatch() for details.
+	private int emgBatchFrames = 32;
+	private int emgBatchLatencyMs = 100;
+	//Native method that changes the batching parameters of a single listener wrapper. The wrapper takes them over
+	//on the thread that dispatches events, delivering any frames it already batched first.
+	static native void _setEmgBatching(long address, int maxFrames, int maxLatencyMs);
+	//Native method that delivers all frames batched by a listener wrapper.
+	static native void _flushEmgBatches(long address);
+	/**
+	 * Set how EMG data is batched for listeners that implement 
+	 * {@link DeviceListener#onEmgBatch(Myo, long[], java.nio.ByteBuffer, int)}.<br>
+	 * <br>
+	 * A batch is delivered once it holds <em>maxFrames</em> frames, or once its oldest frame is at least 
+	 * <em>maxLatencyMs</em> milliseconds old, whichever comes first. The age is measured on the hub's clock, 
+	 * which follows event timestamps and keeps running while no events arrive, and is checked after every event
+	 * and before {@link #run(int)} or {@link #runOnce(int)} returns. So a batch is delivered on time even if its 
+	 * {@link Myo} stops sending data. The defaults are 32 frames and 100 milliseconds.<br>
+	 * <br>
+	 * Registered listeners switch to the new parameters with the next event; listeners added later start with
+	 * them.
+	 * @param maxFrames The maximum number of frames in a batch.
+	 * @param maxLatencyMs The maximum age of the oldest frame of a batch, in milliseconds.
+	 * @throws IllegalArgumentException If <em>maxFrames</em> is less than 1 or <em>maxLatencyMs</em> is negative.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public void setEmgBatching(int maxFrames, int maxLatencyMs) {
+		checkExcept();
+		if(maxFrames < 1) {
+			throw new IllegalArgumentException("A batch must hold at least one frame");
+		}
+		if(maxLatencyMs < 0) {
+			throw new IllegalArgumentException("Latency cannot be negative");
+		}
+		emgBatchFrames = maxFrames;
+		emgBatchLatencyMs = maxLatencyMs;
+		for(long address : deviceListenerAddresses.values()) {
+			_setEmgBatching(address, maxFrames, maxLatencyMs);
+		}
+	}
+	/**
+	 * Deliver the EMG frames waiting in batches right away, whether or not their batches are full or due.<br>
+	 * <br>
+	 * The listeners get them on the calling thread. This method must not be called concurrently with 
+	 * {@link #run(int)} or {@link #runOnce(int)}.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 * @see #setEmgBatching(int, int)
+	 */
+	public void flushEmgBatches() {
+		checkExcept();
+		for(long address : deviceListenerAddresses.values()) {
+			_flushEmgBatches(address);
+		}
+	}
+
+	//EMG feature parameters applied to every registered listener.
+	//See DeviceListener.onEmgFeatures() for details.
+	private int emgFeatureWindow = 40;
+	private int emgFeatureHop = 10;
+	//Native method that changes the feature parameters of a single listener wrapper.
+	//Windows in progress are dropped.
+	static native void _setEmgFeatures(long address, int windowFrames, int hopFrames);
+	/**
+	 * Set how EMG features are computed for listeners that implement
+	 * {@link DeviceListener#onEmgFeatures(Myo, long, float[])}.<br>
+	 * <br>
+	 * Features are computed over the last <em>windowFrames</em> EMG frames of each {@link Myo}, and delivered
+	 * every <em>hopFrames</em> frames once that many frames have arrived. The defaults are a window of 40 frames
+	 * and a hop of 10 frames, which at 200 frames per second is a 200 millisecond window every 50 milliseconds.
+	 * Windows in progress are dropped, and listeners added later start with the new parameters.
+	 * @param windowFrames The number of frames the features are computed over.
+	 * @param hopFrames The number of frames between two calls.
+	 * @throws IllegalArgumentException If <em>windowFrames</em> or <em>hopFrames</em> is less than 1.
+	 * @throws MyoException If this {@link Hub}'s resources have already been released.
+	 */
+	public void setEmgFeatures(int windowFrames, int hopFrames) {
+		checkExcept();
+		if(windowFrames < 1) {
+			throw new IllegalArgumentException("A window must hold at least one frame");
+		}
+		if(hopFrames < 1) {
+			throw new IllegalArgumentException("Hop must be at least one frame");
+		}
+		emgFeatureWindow = windowFrames;
+		emgFeatureHop = hopFrames;
+		for(long address : deviceListenerAddresses.values()) {
+			_setEmgFeatures(address, windowFrames, hopFrames);
+		}
+	}
 }
@@ -1,11 +1,19 @@
 package com.thalmic.myo;
 
+import java.nio.ByteBuffer;
+import java.nio.ReadOnlyBufferException;
+
 /**
  * Represents a {@link Myo} device with a specific MAC address.<br>
  * <br>
  * This class can not be instantiated directly; instead, use {@link Hub} to get access to a {@link Myo}. 
  * There is only one {@link Myo} instance corresponding to each device; thus, if the addresses of two {@link Myo}
- * instances compare equal, they refer to the same device. 
+ * instances compare equal, they refer to the same device. <br>
+ * <br>
+ * Each {@link Hub} also hands out the same {@link Myo} object for a device in every event and in 
+ * {@link Hub#waitForMyo(int)}, so {@link Myo} objects can be compared with {@code ==} and used as keys in an
+ * {@link java.util.IdentityHashMap IdentityHashMap}. This holds until the device is unpaired; a device that
+ * pairs again afterwards gets a new object.
  *
  */
 public final class Myo {
@@ -95,16 +103,86 @@ public final class Myo {
 		}
 	}
 	
+	private static final int HISTORY_IMU = 0;
+	private static final int HISTORY_EMG = 1;
+	/**
+	 * The streams of data a {@link Myo} can keep a history of (see {@link Myo#setHistory(HistoryStream, int)}).<br>
+	 * <br>
+	 * {@link Myo#getHistory(HistoryStream, int, ByteBuffer)} copies a history as fixed-size records in the platform's
+	 * native byte order, each starting with the timestamp of the event as a long. An {@link #imu} record is 48 bytes:
+	 * <pre>
+	 *     0   long      timestamp
+	 *     8   float[4]  orientation x, y, z, w
+	 *     24  float[3]  accelerometer x, y, z
+	 *     36  float[3]  gyroscope x, y, z
+	 * </pre>
+	 * An {@link #emg} record is 16 bytes:
+	 * <pre>
+	 *     0   long      timestamp
+	 *     8   byte[8]   EMG
+	 * </pre>
+	 */
+	public enum HistoryStream {
+		/**
+		 * Orientation, accelerometer and gyroscope data, at 50 records per second.
+		 */
+		imu(48),
+		/**
+		 * EMG data, at 200 records per second.
+		 */
+		emg(16);
+		
+		private final int recordSize;
+		
+		private HistoryStream(int recordSize) {
+			this.recordSize = recordSize;
+		}
+		
+		/**
+		 * Returns the size of a record of this stream.
+		 * @return The record size, in bytes.
+		 */
+		public int recordSize() {
+			return recordSize;
+		}
+		
+		protected int translate() {
+			if(this == imu) {
+				return HISTORY_IMU;
+			}
+			return HISTORY_EMG;
+		}
+	}
+	
 	/*
 	 * This native pointer field functions in the same way as Hub. However, because the Myo objects are created
 	 * by the Myo API, there is no release() method. Instead, the release() method of the Hub will cause all 
 	 * connected Myos to be released.
 	 */
 	private long _nativePointer;
+	//Whether this Myo comes from a ReplayHub. There is no native C++ Myo behind a replayed Myo,
+	//so the native methods must never be called for it.
+	private final boolean replayed;
+	//Address of the native MyoProcessing of the hub that handed out this Myo. Used by setEmgFilter() and the
+	//orientation reference methods.
+	private long _processingPointer;
 	//Constructor has to be kept package-private.
 	//If the wrong nativeAddress is passed in, this will cause heap corruption and crash the VM.
-	Myo(long nativeAddress) {
+	Myo(long nativeAddress, boolean replayed, long processingAddress) {
 		_nativePointer = nativeAddress;
+		this.replayed = replayed;
+		_processingPointer = processingAddress;
+	}
+	
+	/**
+	 * Returns whether this {@link Myo} was handed out by a {@link ReplayHub}.<br>
+	 * <br>
+	 * A replayed {@link Myo} stands for a device in a session log, so there is nothing to send commands to; 
+	 * {@link #vibrate(VibrationType)}, {@link #unlock(UnlockType)} and the other commands do nothing for it.
+	 * @return Whether this {@link Myo} was handed out by a {@link ReplayHub}.
+	 */
+	public boolean isReplayed() {
+		return replayed;
 	}
 	
 	/**
@@ -124,6 +202,13 @@ public final class Myo {
 			return false;
 		}
 	}
+	/**
+	 * Returns a hash code consistent with {@link #equals(Object)}.
+	 */
+	@Override
+	public int hashCode() {
+		return (int) (_nativePointer ^ (_nativePointer >>> 32));
+	}
 	/**
 	 * Return the address of the native C++ {@link Myo} object.<br>
 	 * <br>
@@ -141,6 +226,9 @@ public final class Myo {
 	 * @param type The vibration type.
 	 */
 	public void vibrate(VibrationType type) {
+		if(replayed) {
+			return;
+		}
 		_vibrate(type.translate());
 	}
 	
@@ -153,6 +241,9 @@ public final class Myo {
 	 * @see DeviceListener#onRssi(Myo, long, byte)
 	 */
 	public void requestRssi() {
+		if(replayed) {
+			return;
+		}
 		_requestRssi();
 	}
 	
@@ -165,6 +256,9 @@ public final class Myo {
 	 * @see DeviceListener#onBatteryLevelReceived(Myo, long, byte)
 	 */
 	public void requestBatteryLevel() {
+		if(replayed) {
+			return;
+		}
 		_requestBattLevel();
 	}
 	
@@ -178,6 +272,9 @@ public final class Myo {
 	 * @param type The unlock type
 	 */
 	public void unlock(UnlockType type) {
+		if(replayed) {
+			return;
+		}
 		_unlock(type.translate());
 	}
 	
@@ -189,6 +286,9 @@ public final class Myo {
 	 * If {@link Myo} was unlocked, an onLock event will be generated. 
 	 */
 	public void lock() {
+		if(replayed) {
+			return;
+		}
 		_lock();
 	}
 	
@@ -200,6 +300,9 @@ public final class Myo {
 	 * Will cause {@link Myo} to vibrate.
 	 */
 	public void notifyUserAction() {
+		if(replayed) {
+			return;
+		}
 		_notifyAction();
 	}
 	
@@ -211,6 +314,135 @@ public final class Myo {
 	 * @see DeviceListener#onEmgData(Myo, long, byte[])
 	 */
 	public void setStreamEmg(StreamEmgType type) {
+		if(replayed) {
+			return;
+		}
 		_setStreamEmg(type.translate());
 	}
+	
+	//Native method that sets or clears the filter in the native MyoProcessing of the hub.
+	private native void _setEmgFilter(double[] stages);
+	/**
+	 * Sets the filter applied to the EMG data of this {@link Myo}, replacing the previous one.<br>
+	 * <br>
+	 * Filtered frames are delivered through {@link DeviceListener#onEmgFilteredData(Myo, long, float[])} and 
+	 * {@link DeviceListener#onEmgFilteredBatch(Myo, long[], float[], int)}, alongside the raw EMG events. 
+	 * The filter runs natively before the events reach Java and starts over when the {@link Myo} disconnects 
+	 * or unpairs. This works for replayed {@link Myo}s too.
+	 * @param filter The filter, or null to stop filtering.
+	 * @throws IllegalArgumentException If a stage of the filter is not valid at the EMG sample rate.
+	 * @see EmgFilter
+	 */
+	public void setEmgFilter(EmgFilter filter) {
+		_setEmgFilter(filter == null ? null : filter.encode());
+	}
+	
+	//Native method that sets or clears the smoothing in the native MyoProcessing of the hub.
+	private native void _setOrientationSmoothing(int mode, double factor, double minCutoff, double beta, double derivativeCutoff);
+	/**
+	 * Sets how the orientation of this {@link Myo} is smoothed, replacing the previous smoothing.<br>
+	 * <br>
+	 * Smoothing runs natively on every orientation event before it reaches listeners or {@link MyoState}, and
+	 * starts over when the {@link Myo} disconnects or unpairs. Session logs keep the orientation as it was
+	 * received. This works for replayed {@link Myo}s too.
+	 * @param smoothing The smoothing, or null for none.
+	 * @see OrientationSmoothing
+	 */
+	public void setOrientationSmoothing(OrientationSmoothing smoothing) {
+		if(smoothing == null) {
+			smoothing = OrientationSmoothing.NONE;
+		}
+		_setOrientationSmoothing(smoothing.mode, smoothing.factor, smoothing.minCutoff, smoothing.beta, smoothing.derivativeCutoff);
+	}
+
+	//Native methods that change the reference orientation in the native MyoProcessing of the hub.
+	private native void _setOrientationReference(double x, double y, double z, double w);
+	private native void _clearOrientationReference();
+	private native boolean _centerOrientation();
+	/**
+	 * Sets the orientation that the angles passed to 
+	 * {@link DeviceListener#onOrientationEuler(Myo, long, float, float, float)} are relative to.<br>
+	 * <br>
+	 * While the reference is set, the reference orientation reads as zero roll, pitch and yaw. This works for 
+	 * replayed {@link Myo}s too.
+	 * @param reference The reference orientation, or null to report angles relative to the orientation of the
+	 * {@link Myo} at rest.
+	 * @see #centerOrientation()
+	 */
+	public void setOrientationReference(Quaternion reference) {
+		if(reference == null) {
+			_clearOrientationReference();
+			return;
+		}
+		_setOrientationReference(reference.x(), reference.y(), reference.z(), reference.w());
+	}
+	/**
+	 * Makes the orientation of the next orientation event of this {@link Myo} the reference orientation, so that 
+	 * the current pose reads as zero roll, pitch and yaw from that event on.<br>
+	 * <br>
+	 * Euler angles are only worked out while a listener implements 
+	 * {@link DeviceListener#onOrientationEuler(Myo, long, float, float, float)}, so the reference is taken from 
+	 * the next event such a listener gets. Setting or clearing a reference before then cancels the centering.
+	 * @return false if this {@link Myo} doesn't belong to a hub that processes its orientations, in which case 
+	 * nothing changes.
+	 * @see #setOrientationReference(Quaternion)
+	 */
+	public boolean centerOrientation() {
+		return _centerOrientation();
+	}
+
+	//Native methods that set and read the history in the native MyoProcessing of the hub.
+	private native void _setHistory(int stream, int capacityMs);
+	private native int _getHistory(int stream, int durationMs, ByteBuffer buffer, int position, int remaining);
+	/**
+	 * Keeps the most recent data of one stream of this {@link Myo}, for reading a window of it at any time with 
+	 * {@link #getHistory(HistoryStream, int, ByteBuffer)}.<br>
+	 * <br>
+	 * The history is a ring in native memory that holds <em>capacityMs</em> worth of data at the stream's rate. 
+	 * It is allocated here, once, and filled as events arrive, with the same data that listeners get, so keeping
+	 * a history creates no garbage. Calling this method again replaces the history with an empty one. The history
+	 * starts over empty when the {@link Myo} unpairs, or when a {@link ReplayHub} rewinds. This works for replayed
+	 * {@link Myo}s too.
+	 * @param stream The stream to keep a history of.
+	 * @param capacityMs How much data to keep, in milliseconds, or 0 to stop keeping a history.
+	 * @throws IllegalArgumentException If <em>capacityMs</em> is negative.
+	 */
+	public void setHistory(HistoryStream stream, int capacityMs) {
+		if(capacityMs < 0) {
+			throw new IllegalArgumentException("History capacity must not be negative");
+		}
+		_setHistory(stream.translate(), capacityMs);
+	}
+	/**
+	 * Copies the last <em>durationMs</em> of the history of a stream into <em>dst</em>, such as the last 500 ms of
+	 * EMG data for a gesture classifier.<br>
+	 * <br>
+	 * The window ends at the newest record of the stream and holds the records less than <em>durationMs</em> older
+	 * than it. They are written oldest first, in the layout described in {@link HistoryStream}, starting at the
+	 * position of <em>dst</em>, which is advanced past them. If <em>dst</em> doesn't have room for the whole window,
+	 * only the newest records that fit are copied. The window is copied natively in a single call, straight into
+	 * <em>dst</em>, so reading a history does not allocate anything either. <em>dst</em> should use
+	 * {@link java.nio.ByteOrder#nativeOrder()}, so that the values read back correctly.
+	 * @param stream The stream to read.
+	 * @param durationMs The length of the window, in milliseconds.
+	 * @param dst A direct buffer that receives the records.
+	 * @return The number of records copied, which is 0 if the stream has no history or no data yet.
+	 * @throws IllegalArgumentException If <em>durationMs</em> is negative, or <em>dst</em> is not a direct buffer.
+	 * @throws ReadOnlyBufferException If <em>dst</em> is read-only.
+	 * @see #setHistory(HistoryStream, int)
+	 */
+	public int getHistory(HistoryStream stream, int durationMs, ByteBuffer dst) {
+		if(durationMs < 0) {
+			throw new IllegalArgumentException("History window must not be negative");
+		}
+		if(!dst.isDirect()) {
+			throw new IllegalArgumentException("History can only be copied into a direct buffer");
+		}
+		if(dst.isReadOnly()) {
+			throw new ReadOnlyBufferException();
+		}
+		int records = _getHistory(stream.translate(), durationMs, dst, dst.position(), dst.remaining());
+		dst.position(dst.position() + records * stream.recordSize());
+		return records;
+	}
 }
@@ -0,0 +1,333 @@
+package com.thalmic.myo;
+
+import java.lang.reflect.Field;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import sun.misc.Unsafe;
+
+/**
+ * The latest known state of a {@link Myo}, which can be read at any time without listening to events.<br>
+ * <br>
+ * The {@link Hub} keeps a state block for every {@link Myo} in native memory and updates it with every event.
+ * {@link #update()} copies the current contents of the block into this object, without any JNI calls or allocations,
+ * and the getters then return the copied values. The copy is always consistent: all values come from the same
+ * point in time, even while events keep arriving. This is meant for applications that only care about the current
+ * state, such as a game loop calling {@link #update()} once per frame.<br>
+ * <br>
+ * Use {@link Hub#getState(Myo)} to get a {@link MyoState}, and keep it around. A {@link MyoState} must not be used
+ * after its {@link Hub} has been released, and it is not safe to use one {@link MyoState} object from several
+ * threads at once; create one per thread instead.
+ *
+ */
+public final class MyoState {
+
+	/*
+	 * Layout of the native state block; this has to match struct MyoStateBlock.
+	 *
+	 * The block is protected by a seqlock. The native side makes the sequence number odd before it changes
+	 * anything, and even again afterwards. To get a consistent copy, update() reads the sequence number, copies
+	 * everything, then reads the sequence number again; if it was odd or has changed, the copy may be torn and
+	 * is taken again. The load fences keep the JIT and CPU from moving the copying outside of the two reads.
+	 */
+	private static final int SEQUENCE = 0;
+	private static final int POSE = 4;
+	private static final int IMU_TIMESTAMP = 8;
+	private static final int ORIENTATION = 16;
+	private static final int ACCELEROMETER = 32;
+	private static final int GYROSCOPE = 44;
+	private static final int EMG_TIMESTAMP = 56;
+	private static final int EMG = 64;
+	private static final int LAST_EVENT_TIMESTAMP = 72;
+	private static final int ARM = 80;
+	private static final int X_DIRECTION = 84;
+	private static final int ROTATION_ON_ARM = 88;
+	private static final int WARMUP_STATE = 92;
+	private static final int CONNECTED = 96;
+	private static final int SYNCED = 97;
+	private static final int UNLOCKED = 98;
+	private static final int BATTERY_LEVEL = 99;
+	private static final int RSSI = 100;
+	private static final int POSE_TIMESTAMP = 104;
+	private static final int PREVIOUS_IMU_TIMESTAMP = 112;
+	private static final int PREVIOUS_ORIENTATION = 120;
+
+	//Java 8 has no public API for fences
+	private static final Unsafe UNSAFE;
+	static {
+		try {
+			Field field = Unsafe.class.getDeclaredField("theUnsafe");
+			field.setAccessible(true);
+			UNSAFE = (Unsafe) field.get(null);
+		}
+		catch (ReflectiveOperationException e) {
+			throw new ExceptionInInitializerError(e);
+		}
+	}
+
+	//libmyo's order of these enums differs from the Java one
+	private static final Arm[] ARMS = { Arm.armRight, Arm.armLeft, Arm.armUnknown };
+	private static final Pose[] POSES = { Pose.rest, Pose.fist, Pose.waveIn, Pose.waveOut, Pose.fingersSpread, Pose.doubleTap };
+	private static final XDirection[] X_DIRECTIONS = XDirection.values();
+	private static final WarmupState[] WARMUP_STATES = WarmupState.values();
+
+	private final Myo myo;
+	private final ByteBuffer block;
+
+	//The copy taken by the last update()
+	private int sequence = -1;
+	private final float[] orientation = { 0, 0, 0, 1 };
+	private final float[] previousOrientation = { 0, 0, 0, 1 };
+	private final float[] accelerometer = new float[3];
+	private final float[] gyroscope = new float[3];
+	private final byte[] emg = new byte[8];
+	private long imuTimestamp, previousImuTimestamp, emgTimestamp, poseTimestamp, lastEventTimestamp;
+	private int pose, arm, xDirection, warmupState;
+	private float rotationOnArm;
+	private boolean connected, synced, unlocked;
+	private byte batteryLevel = -1, rssi = -1;
+	//Used by getOrientationAt()
+	private final Quaternionf previous = new Quaternionf();
+
+	MyoState(Myo myo, ByteBuffer block) {
+		this.myo = myo;
+		this.block = block.order(ByteOrder.nativeOrder());
+		update();
+	}
+
+	/**
+	 * Returns the {@link Myo} this state belongs to.
+	 * @return The {@link Myo} of this state.
+	 */
+	public Myo getMyo() {
+		return myo;
+	}
+
+	/**
+	 * Copy the latest state of the {@link Myo} into this object.
+	 * @return Whether anything changed since the last call, i.e. whether any event of the {@link Myo} arrived
+	 * in the meantime.
+	 */
+	public boolean update() {
+		int before, after;
+		do {
+			before = block.getInt(SEQUENCE);
+			if(before == sequence) {
+				return false;
+			}
+			UNSAFE.loadFence();
+
+			pose = block.getInt(POSE);
+			imuTimestamp = block.getLong(IMU_TIMESTAMP);
+			for(int i = 0; i < 4; i ++) {
+				orientation[i] = block.getFloat(ORIENTATION + i * 4);
+			}
+			for(int i = 0; i < 3; i ++) {
+				accelerometer[i] = block.getFloat(ACCELEROMETER + i * 4);
+				gyroscope[i] = block.getFloat(GYROSCOPE + i * 4);
+			}
+			emgTimestamp = block.getLong(EMG_TIMESTAMP);
+			for(int i = 0; i < 8; i ++) {
+				emg[i] = block.get(EMG + i);
+			}
+			lastEventTimestamp = block.getLong(LAST_EVENT_TIMESTAMP);
+			arm = block.getInt(ARM);
+			xDirection = block.getInt(X_DIRECTION);
+			rotationOnArm = block.getFloat(ROTATION_ON_ARM);
+			warmupState = block.getInt(WARMUP_STATE);
+			connected = block.get(CONNECTED) != 0;
+			synced = block.get(SYNCED) != 0;
+			unlocked = block.get(UNLOCKED) != 0;
+			batteryLevel = block.get(BATTERY_LEVEL);
+			rssi = block.get(RSSI);
+			poseTimestamp = block.getLong(POSE_TIMESTAMP);
+			previousImuTimestamp = block.getLong(PREVIOUS_IMU_TIMESTAMP);
+			for(int i = 0; i < 4; i ++) {
+				previousOrientation[i] = block.getFloat(PREVIOUS_ORIENTATION + i * 4);
+			}
+
+			UNSAFE.loadFence();
+			after = block.getInt(SEQUENCE);
+		} while((before & 1) != 0 || before != after);
+		sequence = after;
+		return true;
+	}
+
+	/**
+	 * Returns one component of the latest orientation.
+	 * @param component 0 for x, 1 for y, 2 for z, 3 for w.
+	 * @return The quaternion component.
+	 */
+	public float getOrientation(int component) {
+		return orientation[component];
+	}
+	/**
+	 * Returns the orientation at <em>timestamp</em>, interpolated between the latest orientation and the one
+	 * before it.<br>
+	 * <br>
+	 * Orientations arrive 50 times per second, which looks jerky on a faster display. To draw smooth motion at any
+	 * frame rate, ask for the orientation of one event interval (20 ms) before the current time, in the clock of
+	 * the event timestamps; that time normally falls between the two latest orientations. Times before the
+	 * previous orientation give the previous one, and times after the latest give the latest, since the
+	 * orientation is never extrapolated. Like the other getters, this works on the copy taken by {@link #update()},
+	 * and allocates nothing.
+	 * @param timestamp The time, in microseconds.
+	 * @param out The quaternion that receives the orientation.
+	 * @return <em>out</em>, after updating the components.
+	 * @see Myo#setOrientationSmoothing(OrientationSmoothing)
+	 */
+	public Quaternionf getOrientationAt(long timestamp, Quaternionf out) {
+		out.set(orientation[0], orientation[1], orientation[2], orientation[3]);
+		if(previousImuTimestamp == 0 || timestamp >= imuTimestamp) {
+			return out;
+		}
+		previous.set(previousOrientation[0], previousOrientation[1], previousOrientation[2], previousOrientation[3]);
+		if(timestamp <= previousImuTimestamp) {
+			return out.set(previous);
+		}
+		float t = (float) (timestamp - previousImuTimestamp) / (imuTimestamp - previousImuTimestamp);
+		return previous.slerpInto(out, t, out);
+	}
+	/**
+	 * Returns one component of the orientation before the latest one.
+	 * @param component 0 for x, 1 for y, 2 for z, 3 for w.
+	 * @return The quaternion component, or the identity's until two orientations were received.
+	 */
+	public float getPreviousOrientation(int component) {
+		return previousOrientation[component];
+	}
+	/**
+	 * Returns the timestamp of the orientation before the latest one, or 0 if there was none yet.
+	 * @return The timestamp, in microseconds.
+	 */
+	public long getPreviousImuTimestamp() {
+		return previousImuTimestamp;
+	}
+	/**
+	 * Returns one axis of the latest accelerometer data.
+	 * @param axis 0 for x, 1 for y, 2 for z.
+	 * @return The acceleration, in units of g.
+	 */
+	public float getAccelerometer(int axis) {
+		return accelerometer[axis];
+	}
+	/**
+	 * Returns one axis of the latest gyroscope data.
+	 * @param axis 0 for x, 1 for y, 2 for z.
+	 * @return The angular velocity, in units of deg/s.
+	 */
+	public float getGyroscope(int axis) {
+		return gyroscope[axis];
+	}
+	/**
+	 * Returns the timestamp of the latest orientation, accelerometer and gyroscope data, or 0 if there was none yet.
+	 * @return The timestamp, in microseconds.
+	 */
+	public long getImuTimestamp() {
+		return imuTimestamp;
+	}
+
+	/**
+	 * Returns the reading of one sensor from the latest EMG data.
+	 * @param sensor The sensor, from 0 to 7.
+	 * @return The EMG reading.
+	 */
+	public byte getEmg(int sensor) {
+		return emg[sensor];
+	}
+	/**
+	 * Returns the timestamp of the latest EMG data, or 0 if there was none yet.
+	 * @return The timestamp, in microseconds.
+	 */
+	public long getEmgTimestamp() {
+		return emgTimestamp;
+	}
+
+	/**
+	 * Returns the latest detected pose.
+	 * @return The current pose, or {@link Pose#unknown} if none was detected yet.
+	 */
+	public Pose getPose() {
+		return pose >= 0 && pose < POSES.length ? POSES[pose] : Pose.unknown;
+	}
+	/**
+	 * Returns the timestamp of the latest pose, or 0 if there was none yet.
+	 * @return The timestamp, in microseconds.
+	 */
+	public long getPoseTimestamp() {
+		return poseTimestamp;
+	}
+
+	/**
+	 * Returns whether the {@link Myo} is connected.
+	 * @return Whether the {@link Myo} is connected.
+	 */
+	public boolean isConnected() {
+		return connected;
+	}
+	/**
+	 * Returns whether the {@link Myo} is synced to an arm.
+	 * @return Whether the {@link Myo} is synced.
+	 */
+	public boolean isSynced() {
+		return synced;
+	}
+	/**
+	 * Returns whether the {@link Myo} is unlocked.
+	 * @return Whether the {@link Myo} is unlocked.
+	 */
+	public boolean isUnlocked() {
+		return unlocked;
+	}
+	/**
+	 * Returns the arm the {@link Myo} is synced to.
+	 * @return The arm, or {@link Arm#armUnknown} if not synced.
+	 */
+	public Arm getArm() {
+		return arm >= 0 && arm < ARMS.length ? ARMS[arm] : Arm.armUnknown;
+	}
+	/**
+	 * Returns the direction of the {@link Myo}'s +x axis on the arm.
+	 * @return The x-direction, or {@link XDirection#xDirectionUnknown} if not synced.
+	 */
+	public XDirection getXDirection() {
+		return xDirection >= 0 && xDirection < X_DIRECTIONS.length ? X_DIRECTIONS[xDirection] : XDirection.xDirectionUnknown;
+	}
+	/**
+	 * Returns the estimated rotation of the {@link Myo} on the arm, as of the last sync.
+	 * @return The rotation on the arm, in radians.
+	 */
+	public float getRotationOnArm() {
+		return rotationOnArm;
+	}
+	/**
+	 * Returns the warmup state of the {@link Myo}.
+	 * @return The warmup state.
+	 */
+	public WarmupState getWarmupState() {
+		return warmupState >= 0 && warmupState < WARMUP_STATES.length ? WARMUP_STATES[warmupState] : WarmupState.warmupStateUnknown;
+	}
+	/**
+	 * Returns the latest battery level.
+	 * @return The battery level from 0 to 100, or -1 if none was received yet.
+	 * @see Myo#requestBatteryLevel()
+	 */
+	public byte getBatteryLevel() {
+		return batteryLevel;
+	}
+	/**
+	 * Returns the latest RSSI value.
+	 * @return The RSSI, or -1 if none was received yet.
+	 * @see Myo#requestRssi()
+	 */
+	public byte getRssi() {
+		return rssi;
+	}
+	/**
+	 * Returns the timestamp of the latest event of any type, or 0 if there was none yet.
+	 * @return The timestamp, in microseconds.
+	 */
+	public long getLastEventTimestamp() {
+		return lastEventTimestamp;
+	}
+}
@@ -0,0 +1,77 @@
+package com.thalmic.myo;
+
+/**
+ * How the orientation of a {@link Myo} is smoothed, set with {@link Myo#setOrientationSmoothing(OrientationSmoothing)}.<br>
+ * <br>
+ * The orientation from the {@link Myo} jitters slightly, even while the arm is still. Smoothing runs natively on every
+ * orientation event before anything else sees it, so every orientation callback, the Euler angles and
+ * {@link MyoState} all get the smoothed orientation, without any Java allocation per event. Both kinds of smoothing
+ * interpolate along the shortest arc between rotations (slerp), so the result is always a unit quaternion.
+ * <pre>
+ * myo.setOrientationSmoothing(OrientationSmoothing.oneEuro(1.0, 0.5, 1.0));
+ * </pre>
+ * Orientation events arrive at 50 per second.
+ *
+ */
+public final class OrientationSmoothing {
+	//Same as the enums in Hub, the mode is passed to the native side as an int
+	private static final int MODE_NONE = 0;
+	private static final int MODE_EXPONENTIAL = 1;
+	private static final int MODE_ONE_EURO = 2;
+
+	/**
+	 * No smoothing: orientations are passed on as the {@link Myo} reports them.
+	 */
+	public static final OrientationSmoothing NONE = new OrientationSmoothing(MODE_NONE, 1, 0, 0, 0);
+
+	final int mode;
+	final double factor;
+	final double minCutoff;
+	final double beta;
+	final double derivativeCutoff;
+
+	private OrientationSmoothing(int mode, double factor, double minCutoff, double beta, double derivativeCutoff) {
+		this.mode = mode;
+		this.factor = factor;
+		this.minCutoff = minCutoff;
+		this.beta = beta;
+		this.derivativeCutoff = derivativeCutoff;
+	}
+
+	/**
+	 * Exponential smoothing: every orientation event moves the smoothed orientation a fixed fraction of the way to
+	 * the new orientation. This is simple, but lags behind fast movements as much as it smooths slow ones.
+	 * @param factor The fraction, from 0 (exclusive) to 1; 1 means no smoothing. At 50 events per second, 0.2 gives
+	 * a time constant of about 90 ms.
+	 * @return The smoothing.
+	 * @throws IllegalArgumentException If <em>factor</em> is out of range.
+	 */
+	public static OrientationSmoothing exponential(double factor) {
+		if(!(factor > 0 && factor <= 1)) {
+			throw new IllegalArgumentException("Smoothing factor must be above 0 and at most 1");
+		}
+		return new OrientationSmoothing(MODE_EXPONENTIAL, factor, 0, 0, 0);
+	}
+
+	/**
+	 * One-Euro filter (Casiez et al.): a low-pass filter whose cutoff frequency rises with the angular speed, so it
+	 * removes jitter while the arm is still and hardly lags while it moves.<br>
+	 * <br>
+	 * To tune it, set <em>beta</em> to 0 and lower <em>minCutoff</em> until the orientation is steady at rest, then
+	 * raise <em>beta</em> until fast movements stop lagging.
+	 * @param minCutoff The cutoff frequency at rest, in Hz. Lower values remove more jitter.
+	 * @param beta How much the cutoff frequency rises with speed, in Hz per radian per second.
+	 * @param derivativeCutoff The cutoff frequency of the filter on the speed itself, in Hz; 1 is usually right.
+	 * @return The smoothing.
+	 * @throws IllegalArgumentException If a cutoff frequency is not positive, or <em>beta</em> is negative.
+	 */
+	public static OrientationSmoothing oneEuro(double minCutoff, double beta, double derivativeCutoff) {
+		if(!(minCutoff > 0 && derivativeCutoff > 0)) {
+			throw new IllegalArgumentException("Cutoff frequencies must be positive");
+		}
+		if(!(beta >= 0)) {
+			throw new IllegalArgumentException("Beta must not be negative");
+		}
+		return new OrientationSmoothing(MODE_ONE_EURO, 1, minCutoff, beta, derivativeCutoff);
+	}
+}
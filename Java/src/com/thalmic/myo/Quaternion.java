@@ -4,7 +4,12 @@ package com.thalmic.myo;
  * A quaternion that can be used to represent a rotation. <br>
  * <br>
  * This type provides only very basic functionality to store quaternions that's sufficient to retrieve the data
- * to be placed in a full featured quaternion type. 
+ * to be placed in a full featured quaternion type. <br>
+ * <br>
+ * Methods such as {@link #multiply(Quaternion)} return a new object. Each of them has a counterpart that writes
+ * its result into an existing object instead, such as {@link #multiplyInto(Quaternion, Quaternion)} and
+ * {@link #normalizeInPlace()}, so that math done for every frame creates no garbage. For the same in single
+ * precision, see {@link Quaternionf}.
  *
  */
 public class Quaternion implements Cloneable {
@@ -56,6 +61,21 @@ public class Quaternion implements Cloneable {
 		this.z = other.z;
 		return this;
 	}
+	/**
+	 * Set the components of this quaternion.
+	 * @param x The x component of the vector component of the quaternion.
+	 * @param y The y component of the vector component of the quaternion.
+	 * @param z The z component of the vector component of the quaternion.
+	 * @param w The scalar part of the quaternion.
+	 * @return This quaternion, after updating the components.
+	 */
+	public Quaternion set(double x, double y, double z, double w) {
+		this.w = w;
+		this.x = x;
+		this.y = y;
+		this.z = z;
+		return this;
+	}
 
 	/**
 	 * Clones this quaternion.
@@ -87,9 +107,28 @@ public class Quaternion implements Cloneable {
 	 * @return A copy of this <em>vec</em> rotated by <em>quat</em>.
 	 */
 	public static Vector3 rotate(Quaternion quat, Vector3 vec) {
-		Quaternion q = new Quaternion(vec.x(), vec.y(), vec.z(), 0);
-		Quaternion result = quat.multiply(q).multiply(quat.conjugate());
-		return new Vector3(result.x, result.y, result.z);
+		return rotateInto(quat, vec, new Vector3());
+	}
+	/**
+	 * Rotate <em>vec</em> by <em>quat</em>, storing the result in <em>out</em>.<br>
+	 * <br>
+	 * This is the same as {@link #rotate(Quaternion, Vector3)}, without creating any objects. <em>out</em> may be
+	 * <em>vec</em>.
+	 * @param quat The quaternion representing the rotation.
+	 * @param vec The vector to be rotated.
+	 * @param out The vector that receives the result.
+	 * @return <em>out</em>, after updating the components.
+	 */
+	public static Vector3 rotateInto(Quaternion quat, Vector3 vec, Vector3 out) {
+		//quat * (vec, 0) * conjugate(quat), expanded
+		double px = quat.w * vec.x() + quat.y * vec.z() - quat.z * vec.y();
+		double py = quat.w * vec.y() - quat.x * vec.z() + quat.z * vec.x();
+		double pz = quat.w * vec.z() + quat.x * vec.y() - quat.y * vec.x();
+		double pw = -quat.x * vec.x() - quat.y * vec.y() - quat.z * vec.z();
+		return out.set(
+				-pw * quat.x + px * quat.w - py * quat.z + pz * quat.y,
+				-pw * quat.y + px * quat.z + py * quat.w - pz * quat.x,
+				-pw * quat.z - px * quat.y + py * quat.x + pz * quat.w);
 	}
 	/**
 	 * Return a quaternion that represents a rotation from vector <em>from</em> to <em>to</em>.<br>
@@ -170,15 +209,30 @@ public class Quaternion implements Cloneable {
 	 * @return This quaternion's conjugate.
 	 */
 	public Quaternion conjugate() {
-		return new Quaternion(-x, -y, -z, w);
+		return conjugateInto(new Quaternion());
+	}
+	/**
+	 * Store this quaternion's conjugate in <em>out</em>, which may be this quaternion.
+	 * @param out The quaternion that receives the result.
+	 * @return <em>out</em>, after updating the components.
+	 */
+	public Quaternion conjugateInto(Quaternion out) {
+		return out.set(-x, -y, -z, w);
 	}
 	/**
 	 * Return the unit quaternion corresponding to the same rotation as this one. 
 	 * @return The unit quaternion corresponding to the same rotation as this one. 
 	 */
 	public Quaternion normalized() {
+		return new Quaternion(this).normalizeInPlace();
+	}
+	/**
+	 * Normalize this quaternion, so that it becomes the unit quaternion corresponding to the same rotation.
+	 * @return This quaternion, after updating the components.
+	 */
+	public Quaternion normalizeInPlace() {
 		double mag = Math.sqrt(x * x + y * y + z * z + w * w);
-		return new Quaternion(x / mag, y / mag, z / mag, w / mag);
+		return set(x / mag, y / mag, z / mag, w / mag);
 	}
 	/**
 	 * Return the quaternion multiplied by <em>rhs</em>. <br>
@@ -190,7 +244,19 @@ public class Quaternion implements Cloneable {
 	 * @return The result of the multiplication.
 	 */
 	public Quaternion multiply(Quaternion rhs) {
-		return new Quaternion(
+		return multiplyInto(rhs, new Quaternion());
+	}
+	/**
+	 * Store this quaternion multiplied by <em>rhs</em> in <em>out</em>.<br>
+	 * <br>
+	 * This is the same as {@link #multiply(Quaternion)}, without creating any objects. <em>out</em> may be this
+	 * quaternion or <em>rhs</em>.
+	 * @param rhs The quaternion to multiply by.
+	 * @param out The quaternion that receives the result.
+	 * @return <em>out</em>, after updating the components.
+	 */
+	public Quaternion multiplyInto(Quaternion rhs, Quaternion out) {
+		return out.set(
 				w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
 	            w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
 	            w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w,
@@ -206,7 +272,6 @@ public class Quaternion implements Cloneable {
 	 * @return This quaternion updated with the result.  
 	 */
 	public Quaternion multiplyEquals(Quaternion rhs) {
-		equal(multiply(rhs));
-		return this;
+		return multiplyInto(rhs, this);
 	}
 }
@@ -0,0 +1,123 @@
+package com.thalmic.myo;
+
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
+
+/**
+ * Batch {@link Quaternion} and {@link Vector3} operations over direct {@link FloatBuffer}s, run natively.<br>
+ * <br>
+ * Quaternions and vectors are passed as one buffer per component: {x, y, z, w} for quaternions and {x, y, z} for
+ * vectors, so that element <em>i</em> of a batch is made of element <em>i</em> of each buffer. That is how a
+ * column file stores orientations, so the buffers of {@link SessionColumns#getOrientation(char)} can be used
+ * directly, without copying:
+ * <pre>
+ * FloatBuffer[] orientation = { columns.getOrientation('x'), columns.getOrientation('y'),
+ *     columns.getOrientation('z'), columns.getOrientation('w') };
+ * QuaternionBatch.rotate(orientation, accel, worldAccel, (int) columns.getImuRowCount());
+ * </pre>
+ * Every buffer must be direct and in native byte order, and hold at least <em>count</em> elements from its
+ * position; output buffers must also be writable. Outputs may be the same buffers as inputs. The positions of
+ * the buffers are left alone.<br>
+ * <br>
+ * Operations give the same results as their {@link Quaternion} counterparts, up to float rounding, and use SSE2 or
+ * AVX where the native library was built for them.
+ *
+ */
+public final class QuaternionBatch {
+	static {
+		System.loadLibrary("myo_jni");
+	}
+
+	private QuaternionBatch() {
+	}
+
+	//Native methods that run the batch kernels. Buffers are checked and sliced by the Java methods.
+	private static native void _multiply(FloatBuffer[] a, FloatBuffer[] b, FloatBuffer[] out, int count);
+	private static native void _rotate(FloatBuffer[] q, FloatBuffer[] v, FloatBuffer[] out, int count);
+	private static native void _normalize(FloatBuffer[] q, FloatBuffer[] out, int count);
+	private static native void _slerp(FloatBuffer[] a, FloatBuffer[] b, FloatBuffer t, FloatBuffer[] out, int count);
+
+	/**
+	 * Multiply quaternions element by element: out[i] = a[i] * b[i].
+	 * @param a The x, y, z and w components of the left operands.
+	 * @param b The x, y, z and w components of the right operands.
+	 * @param out The x, y, z and w components of the products.
+	 * @param count The number of elements.
+	 * @throws IllegalArgumentException If a buffer is not usable for <em>count</em> elements.
+	 * @see Quaternion#multiply(Quaternion)
+	 */
+	public static void multiply(FloatBuffer[] a, FloatBuffer[] b, FloatBuffer[] out, int count) {
+		_multiply(components(a, 4, count, false), components(b, 4, count, false), components(out, 4, count, true), count);
+	}
+
+	/**
+	 * Rotate vectors by unit quaternions element by element: out[i] = rotate(q[i], v[i]).
+	 * @param q The x, y, z and w components of the rotations.
+	 * @param v The x, y and z components of the vectors.
+	 * @param out The x, y and z components of the rotated vectors.
+	 * @param count The number of elements.
+	 * @throws IllegalArgumentException If a buffer is not usable for <em>count</em> elements.
+	 * @see Quaternion#rotate(Quaternion, Vector3)
+	 */
+	public static void rotate(FloatBuffer[] q, FloatBuffer[] v, FloatBuffer[] out, int count) {
+		_rotate(components(q, 4, count, false), components(v, 3, count, false), components(out, 3, count, true), count);
+	}
+
+	/**
+	 * Normalize quaternions element by element.
+	 * @param q The x, y, z and w components of the quaternions.
+	 * @param out The x, y, z and w components of the unit quaternions.
+	 * @param count The number of elements.
+	 * @throws IllegalArgumentException If a buffer is not usable for <em>count</em> elements.
+	 * @see Quaternion#normalized()
+	 */
+	public static void normalize(FloatBuffer[] q, FloatBuffer[] out, int count) {
+		_normalize(components(q, 4, count, false), components(out, 4, count, true), count);
+	}
+
+	/**
+	 * Spherically interpolate between unit quaternions element by element, from a[i] when t[i] is 0 to b[i] when
+	 * t[i] is 1. The interpolation always takes the shorter way between the two rotations.
+	 * @param a The x, y, z and w components of the start rotations.
+	 * @param b The x, y, z and w components of the end rotations.
+	 * @param t The interpolation parameters, from 0 to 1.
+	 * @param out The x, y, z and w components of the interpolated rotations.
+	 * @param count The number of elements.
+	 * @throws IllegalArgumentException If a buffer is not usable for <em>count</em> elements.
+	 */
+	public static void slerp(FloatBuffer[] a, FloatBuffer[] b, FloatBuffer t, FloatBuffer[] out, int count) {
+		_slerp(components(a, 4, count, false), components(b, 4, count, false), buffer(t, count, false),
+			components(out, 4, count, true), count);
+	}
+
+	//Checks the components of a batch argument, and returns them sliced at their positions.
+	private static FloatBuffer[] components(FloatBuffer[] buffers, int size, int count, boolean output) {
+		if(buffers == null || buffers.length != size) {
+			throw new IllegalArgumentException("Expected " + size + " component buffers");
+		}
+		FloatBuffer[] sliced = new FloatBuffer[size];
+		for(int i = 0; i < size; i ++) {
+			sliced[i] = buffer(buffers[i], count, output);
+		}
+		return sliced;
+	}
+
+	private static FloatBuffer buffer(FloatBuffer buffer, int count, boolean output) {
+		if(count < 0) {
+			throw new IllegalArgumentException("Count must not be negative");
+		}
+		if(buffer == null || !buffer.isDirect()) {
+			throw new IllegalArgumentException("Buffers must be direct");
+		}
+		if(buffer.order() != ByteOrder.nativeOrder()) {
+			throw new IllegalArgumentException("Buffers must be in native byte order");
+		}
+		if(buffer.remaining() < count) {
+			throw new IllegalArgumentException("Buffer holds " + buffer.remaining() + " elements, " + count + " needed");
+		}
+		if(output && buffer.isReadOnly()) {
+			throw new IllegalArgumentException("Output buffers must be writable");
+		}
+		return buffer.slice();
+	}
+}
@@ -0,0 +1,205 @@
+package com.thalmic.myo;
+
+/**
+ * A single-precision, mutable quaternion for per-frame orientation math.<br>
+ * <br>
+ * This is the counterpart of {@link Quaternion} for code that updates the same objects every frame: every
+ * operation writes its result into an existing object, so nothing is allocated once the objects exist. Floats are
+ * what the {@link Myo} delivers (see {@link DeviceListener#onOrientationRaw(Myo, long, float, float, float, float)}),
+ * and what most rendering code wants.
+ * <pre>
+ * private final Quaternionf orientation = new Quaternionf();
+ * private final Vector3f forward = new Vector3f();
+ *
+ * public void onOrientationRaw(Myo myo, long timestamp, float x, float y, float z, float w) {
+ *     orientation.set(x, y, z, w);
+ *     Quaternionf.rotateInto(orientation, forward.set(1, 0, 0), forward);
+ * }
+ * </pre>
+ *
+ */
+public final class Quaternionf {
+	private float w, x, y, z;
+
+	/**
+	 * Construct a quaternion that represents zero rotation (i.e. the multiplicative identity).
+	 */
+	public Quaternionf() {
+		w = 1;
+		x = y = z = 0;
+	}
+	/**
+	 * Construct a quaternion with the provided components.
+	 * @param x The x component of the vector component of the quaternion.
+	 * @param y The y component of the vector component of the quaternion.
+	 * @param z The z component of the vector component of the quaternion.
+	 * @param w The scalar part of the quaternion.
+	 */
+	public Quaternionf(float x, float y, float z, float w) {
+		set(x, y, z, w);
+	}
+	/**
+	 * Creates a quaternion with the components equal to another quaterion.
+	 * @param other The quaternion whose components will be copied.
+	 */
+	public Quaternionf(Quaternionf other) {
+		set(other);
+	}
+
+	/**
+	 * Set the components of this quaternion.
+	 * @param x The x component of the vector component of the quaternion.
+	 * @param y The y component of the vector component of the quaternion.
+	 * @param z The z component of the vector component of the quaternion.
+	 * @param w The scalar part of the quaternion.
+	 * @return This quaternion, after updating the components.
+	 */
+	public Quaternionf set(float x, float y, float z, float w) {
+		this.w = w;
+		this.x = x;
+		this.y = y;
+		this.z = z;
+		return this;
+	}
+	/**
+	 * Set the components of this quaternion to be those of the other.
+	 * @param other The quaternion whose components will be copied.
+	 * @return This quaternion, after updating the components.
+	 */
+	public Quaternionf set(Quaternionf other) {
+		return set(other.x, other.y, other.z, other.w);
+	}
+	/**
+	 * Set the components of this quaternion to be those of a double-precision quaternion, rounded to float.
+	 * @param other The quaternion whose components will be copied.
+	 * @return This quaternion, after updating the components.
+	 */
+	public Quaternionf set(Quaternion other) {
+		return set((float) other.x(), (float) other.y(), (float) other.z(), (float) other.w());
+	}
+
+	/**
+	 * Return the x-component of this quaternion's vector.
+	 * @return The x-component of this quaternion's vector.
+	 */
+	public float x() {
+		return x;
+	}
+	/**
+	 * Return the y-component of this quaternion's vector.
+	 * @return The y-component of this quaternion's vector.
+	 */
+	public float y() {
+		return y;
+	}
+	/**
+	 * Return the z-component of this quaternion's vector.
+	 * @return The z-component of this quaternion's vector.
+	 */
+	public float z() {
+		return z;
+	}
+	/**
+	 * Return the w-component (scalar) of this quaternion.
+	 * @return The w-component (scalar) of this quaternion.
+	 */
+	public float w() {
+		return w;
+	}
+
+	/**
+	 * Store this quaternion multiplied by <em>rhs</em> in <em>out</em>, which may be this quaternion or
+	 * <em>rhs</em>.<br>
+	 * <br>
+	 * Note that quaternion multiplication is not commutative.
+	 * @param rhs The quaternion to multiply by.
+	 * @param out The quaternion that receives the result.
+	 * @return <em>out</em>, after updating the components.
+	 * @see Quaternion#multiply(Quaternion)
+	 */
+	public Quaternionf multiplyInto(Quaternionf rhs, Quaternionf out) {
+		return out.set(
+				w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
+				w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
+				w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w,
+				w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z);
+	}
+	/**
+	 * Multiply this quaternion by <em>rhs</em>.
+	 * @param rhs The quaternion to multiply by.
+	 * @return This quaternion updated with the result.
+	 */
+	public Quaternionf multiplyEquals(Quaternionf rhs) {
+		return multiplyInto(rhs, this);
+	}
+	/**
+	 * Store this quaternion's conjugate in <em>out</em>, which may be this quaternion.
+	 * @param out The quaternion that receives the result.
+	 * @return <em>out</em>, after updating the components.
+	 */
+	public Quaternionf conjugateInto(Quaternionf out) {
+		return out.set(-x, -y, -z, w);
+	}
+	/**
+	 * Normalize this quaternion, so that it becomes the unit quaternion corresponding to the same rotation.
+	 * @return This quaternion, after updating the components.
+	 */
+	public Quaternionf normalizeInPlace() {
+		float mag = (float) Math.sqrt(x * x + y * y + z * z + w * w);
+		return set(x / mag, y / mag, z / mag, w / mag);
+	}
+
+	/**
+	 * Store the spherical linear interpolation from this unit quaternion (<em>t</em> = 0) to <em>to</em>
+	 * (<em>t</em> = 1) in <em>out</em>, which may be this quaternion or <em>to</em>. The interpolation takes
+	 * the shorter way between the two rotations.
+	 * @param to The unit quaternion to interpolate to.
+	 * @param t The interpolation parameter, from 0 to 1.
+	 * @param out The quaternion that receives the result.
+	 * @return <em>out</em>, after updating the components.
+	 * @see QuaternionBatch#slerp(java.nio.FloatBuffer[], java.nio.FloatBuffer[], java.nio.FloatBuffer, java.nio.FloatBuffer[], int)
+	 */
+	public Quaternionf slerpInto(Quaternionf to, float t, Quaternionf out) {
+		float cosAngle = x * to.x + y * to.y + z * to.z + w * to.w;
+		float sign = cosAngle < 0 ? -1 : 1;
+		cosAngle *= sign;
+		float weightFrom, weightTo;
+		if(cosAngle > 0.9995f) {
+			//Too close for sin() to be accurate; the difference from a straight line is below rounding
+			weightFrom = 1 - t;
+			weightTo = t;
+		}
+		else {
+			double angle = Math.acos(cosAngle);
+			double sinAngle = Math.sin(angle);
+			weightFrom = (float) (Math.sin((1 - t) * angle) / sinAngle);
+			weightTo = (float) (Math.sin(t * angle) / sinAngle);
+		}
+		weightTo *= sign;
+		return out.set(
+				weightFrom * x + weightTo * to.x,
+				weightFrom * y + weightTo * to.y,
+				weightFrom * z + weightTo * to.z,
+				weightFrom * w + weightTo * to.w);
+	}
+
+	/**
+	 * Rotate <em>vec</em> by <em>quat</em>, storing the result in <em>out</em>, which may be <em>vec</em>.
+	 * @param quat The quaternion representing the rotation.
+	 * @param vec The vector to be rotated.
+	 * @param out The vector that receives the result.
+	 * @return <em>out</em>, after updating the components.
+	 * @see Quaternion#rotate(Quaternion, Vector3)
+	 */
+	public static Vector3f rotateInto(Quaternionf quat, Vector3f vec, Vector3f out) {
+		//quat * (vec, 0) * conjugate(quat), expanded
+		float px = quat.w * vec.x() + quat.y * vec.z() - quat.z * vec.y();
+		float py = quat.w * vec.y() - quat.x * vec.z() + quat.z * vec.x();
+		float pz = quat.w * vec.z() + quat.x * vec.y() - quat.y * vec.x();
+		float pw = -quat.x * vec.x() - quat.y * vec.y() - quat.z * vec.z();
+		return out.set(
+				-pw * quat.x + px * quat.w - py * quat.z + pz * quat.y,
+				-pw * quat.y + px * quat.z + py * quat.w - pz * quat.x,
+				-pw * quat.z - px * quat.y + py * quat.x + pz * quat.w);
+	}
+}
@@ -0,0 +1,142 @@
+package com.thalmic.myo;
+
+import java.util.HashMap;
+
+/**
+ * A snapshot of the counters of the queue used in async mode, returned by {@link Hub#getQueueStats()}.<br>
+ * <br>
+ * For every {@link Myo} and every {@link EventType}, the queue counts how many events were
+ * <ul>
+ * <li><em>enqueued</em>, i.e. made it into the queue,
+ * <li><em>dropped</em> because the queue was full, and
+ * <li><em>coalesced</em>, i.e. replaced by a newer event of the same type under
+ * {@link Hub.OverflowPolicy#overflowPolicyCoalesce}.
+ * </ul>
+ * The getters below accept {@code null} for the {@link Myo} or the {@link EventType} to add up the counts of all
+ * {@link Myo}s or all event types. Rising drop or coalesce counts mean that the consumer of the queue cannot keep up.
+ *
+ */
+public final class QueueStats {
+
+	/*
+	 * The native method returns everything as one long array:
+	 *     [0] the number of queued events
+	 *     [1] the capacity of the queue
+	 *     [2] the number of Myos that follow
+	 * then, for each Myo, the address of the native Myo followed by the enqueued, dropped and coalesced counts,
+	 * each indexed by event type.
+	 */
+	private static final int TYPES = EventType.values().length;
+	private static final int ENQUEUED = 0;
+	private static final int DROPPED = 1;
+	private static final int COALESCED = 2;
+
+	private final int depth;
+	private final int capacity;
+	//Counts of each Myo by native address, in the same order as the native array
+	private final HashMap<Long, long[]> counts = new HashMap<Long, long[]>();
+
+	QueueStats(long[] stats) {
+		depth = (int) stats[0];
+		capacity = (int) stats[1];
+		int myoCount = (int) stats[2];
+		int offset = 3;
+		for(int i = 0; i < myoCount; i ++) {
+			long[] myoCounts = new long[3 * TYPES];
+			System.arraycopy(stats, offset + 1, myoCounts, 0, myoCounts.length);
+			counts.put(stats[offset], myoCounts);
+			offset += 1 + myoCounts.length;
+		}
+	}
+
+	/**
+	 * Returns the number of events that were in the queue when the snapshot was taken.
+	 * @return The number of queued events.
+	 */
+	public int getDepth() {
+		return depth;
+	}
+	/**
+	 * Returns the number of events the queue can hold, or 0 if the {@link Hub} was not in async mode.
+	 * @return The capacity of the queue.
+	 */
+	public int getCapacity() {
+		return capacity;
+	}
+
+	/**
+	 * Returns the total number of events that were enqueued.
+	 * @return The number of enqueued events.
+	 */
+	public long getEnqueued() {
+		return getEnqueued(null, null);
+	}
+	/**
+	 * Returns the total number of events that were dropped because the queue was full.
+	 * @return The number of dropped events.
+	 */
+	public long getDropped() {
+		return getDropped(null, null);
+	}
+	/**
+	 * Returns the total number of events that were replaced by a newer event.
+	 * @return The number of coalesced events.
+	 */
+	public long getCoalesced() {
+		return getCoalesced(null, null);
+	}
+
+	/**
+	 * Returns the number of events of a {@link Myo} and type that were enqueued.
+	 * @param myo The {@link Myo}, or {@code null} for all {@link Myo}s.
+	 * @param type The event type, or {@code null} for all types.
+	 * @return The number of enqueued events.
+	 */
+	public long getEnqueued(Myo myo, EventType type) {
+		return sum(myo, type, ENQUEUED);
+	}
+	/**
+	 * Returns the number of events of a {@link Myo} and type that were dropped because the queue was full.
+	 * @param myo The {@link Myo}, or {@code null} for all {@link Myo}s.
+	 * @param type The event type, or {@code null} for all types.
+	 * @return The number of dropped events.
+	 */
+	public long getDropped(Myo myo, EventType type) {
+		return sum(myo, type, DROPPED);
+	}
+	/**
+	 * Returns the number of events of a {@link Myo} and type that were replaced by a newer event.
+	 * @param myo The {@link Myo}, or {@code null} for all {@link Myo}s.
+	 * @param type The event type, or {@code null} for all types.
+	 * @return The number of coalesced events.
+	 */
+	public long getCoalesced(Myo myo, EventType type) {
+		return sum(myo, type, COALESCED);
+	}
+
+	private long sum(Myo myo, EventType type, int counter) {
+		long total = 0;
+		if(myo != null) {
+			long[] myoCounts = counts.get(myo.getNativeAddress());
+			if(myoCounts != null) {
+				total = sum(myoCounts, type, counter);
+			}
+		}
+		else {
+			for(long[] myoCounts : counts.values()) {
+				total += sum(myoCounts, type, counter);
+			}
+		}
+		return total;
+	}
+	private static long sum(long[] myoCounts, EventType type, int counter) {
+		if(type != null) {
+			return myoCounts[counter * TYPES + type.ordinal()];
+		}
+		long total = 0;
+		for(int i = 0; i < TYPES; i ++) {
+			total += myoCounts[counter * TYPES + i];
+		}
+		return total;
+	}
+}
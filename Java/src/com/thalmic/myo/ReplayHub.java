@@ -0,0 +1,372 @@
+package com.thalmic.myo;
+
+import java.io.IOException;
+import java.nio.file.Path;
+import java.util.Collection;
+import java.util.HashMap;
+
+/**
+ * A {@link ReplayHub} plays back a session log recorded with {@link Hub#startRecording(Path)}.<br>
+ * <br>
+ * It is used the same way as a {@link Hub}: listeners are registered with {@link #addListener(DeviceListener)},
+ * and events are delivered to them on the thread that calls {@link #run(int)} or {@link #runOnce(int)}. The events
+ * go through the same native dispatch code as live ones, with their recorded timestamps, so a program can be run
+ * against a recording without any changes to its listeners. No Myo Connect is needed.<br>
+ * <br>
+ * Each device in the log gets a {@link Myo} object of its own, which is handed out the same way a {@link Hub}
+ * does (see {@link Myo}). These are replayed {@link Myo}s (see {@link Myo#isReplayed()}); commands sent to them
+ * are ignored.<br>
+ * <br>
+ * The log is memory-mapped rather than read into memory. A log that was cut short, say because the program that
+ * recorded it crashed, is replayed up to the last complete block of events.
+ */
+public final class ReplayHub {
+
+	static {
+		System.loadLibrary("myo_jni");
+	}
+
+	//Whether the resources have been released.
+	private boolean deleted = false;
+	/**
+	 * Returns whether the resources associated with this {@link ReplayHub} have been released.
+	 * If this method returns true, subsequent calls to any method, excluding this one and {@link #release()},
+	 * will throw a {@link MyoException}.
+	 * @return Whether the resources associated with this {@link ReplayHub} have been released.
+	 * @see #release()
+	 */
+	public boolean isReleased() {
+		return deleted;
+	}
+
+	//Verifies that the ReplayHub is still valid.
+	private void checkExcept() {
+		if(deleted) {
+			throw new MyoException("This ReplayHub has already been released");
+		}
+	}
+
+	//Same as in Hub, this maps DeviceListener objects to the addresses of their native wrappers.
+	private HashMap<DeviceListener, Long> deviceListenerAddresses = new HashMap<DeviceListener, Long>();
+	//Same as in Hub, this maps FrameListener objects to the addresses of their native wrappers.
+	private HashMap<FrameListener, Long> frameListenerAddresses = new HashMap<FrameListener, Long>();
+
+	//The address of the native ReplayHub object. Works the same way as the one in Hub.
+	private long _nativePointer;
+
+	//Native method that maps the session log and creates the native ReplayHub.
+	//This method also sets the value of _nativePointer.
+	private native void _open(String path) throws IOException;
+	/**
+	 * Open a session log for replay.<br>
+	 * <br>
+	 * The replay starts at the first event, at real time speed.
+	 * @param file The session log.
+	 * @throws IOException If the file could not be read, or is not a session log.
+	 */
+	public ReplayHub(Path file) throws IOException {
+		_open(file.toAbsolutePath().toString());
+	}
+
+	//Releases the native ReplayHub object and unmaps the session log.
+	private native void _release();
+	/**
+	 * Releases any resources associated with this {@link ReplayHub}, including the mapping of the session log.<br>
+	 * <br>
+	 * After this method is called, {@link #isReleased()} will start returning true. Calling this method on a
+	 * {@link ReplayHub} that has already been released will have no effect. This method also removes all device
+	 * listeners and frame listeners.
+	 */
+	public void release() {
+		if(!deleted) {
+			Collection<Long> addresses = deviceListenerAddresses.values();
+			for(long address : addresses) {
+				_removeDeviceListener(address);
+				Hub._deleteListenerWrapper(address);
+			}
+			deviceListenerAddresses.clear();
+			for(long address : frameListenerAddresses.values()) {
+				_removeFrameListener(address);
+				Hub._deleteFrameAssembler(address);
+			}
+			frameListenerAddresses.clear();
+
+			_release();
+			deleted = true;
+		}
+	}
+
+	private native void _setSpeed(double speed);
+	private double speed = 1;
+	/**
+	 * Set how fast events are replayed.<br>
+	 * <br>
+	 * At a speed of 1, events are delivered as far apart as they were recorded; at a speed of 2, twice as fast,
+	 * and so on. At a speed of 0, events are delivered as fast as the listeners can take them. The speed can be
+	 * changed at any time between calls to {@link #run(int)}.
+	 * @param speed The replay speed, or 0 to replay as fast as possible.
+	 * @throws IllegalArgumentException If <em>speed</em> is negative or not a number.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public void setSpeed(double speed) {
+		checkExcept();
+		if(!(speed >= 0) || Double.isInfinite(speed)) {
+			throw new IllegalArgumentException("Speed must be 0 or a positive number");
+		}
+		this.speed = speed;
+		_setSpeed(speed);
+	}
+	/**
+	 * Returns the replay speed.
+	 * @return The replay speed, or 0 if events are replayed as fast as possible.
+	 * @see #setSpeed(double)
+	 */
+	public double getSpeed() {
+		return speed;
+	}
+
+	//Native method that replays events for the given duration.
+	private native void _run(int duration);
+	/**
+	 * Replay events for the specified duration (in milliseconds).<br>
+	 * <br>
+	 * During that time, this method will block, just like {@link Hub#run(int)}. The replay only moves on while
+	 * this method or {@link #runOnce(int)} is running, so events are never skipped because of a pause between calls.
+	 * Returns early once every event has been replayed.
+	 * @param durationMs The duration to replay events for, in milliseconds.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 * @see #isFinished()
+	 */
+	public void run(int durationMs) {
+		checkExcept();
+		_run(durationMs);
+	}
+
+	//Native method that replays a single event.
+	private native void _runOnce(int duration);
+	/**
+	 * Replay a single event, waiting up to the specified duration (in milliseconds) for it to become due.<br>
+	 * <br>
+	 * Returns right away if every event has already been replayed.
+	 * @param durationMs The maximum time to wait for the next event, in milliseconds.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 * @see #run(int)
+	 */
+	public void runOnce(int durationMs) {
+		checkExcept();
+		_runOnce(durationMs);
+	}
+
+	private native void _rewind();
+	/**
+	 * Start the replay over from the first event.<br>
+	 * <br>
+	 * Devices keep their {@link Myo} objects, unless they were unpaired during the replay.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public void rewind() {
+		checkExcept();
+		_rewind();
+	}
+
+	private native boolean _isFinished();
+	/**
+	 * Returns whether every event in the session log has been replayed.
+	 * @return Whether the replay is finished.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public boolean isFinished() {
+		checkExcept();
+		return _isFinished();
+	}
+
+	private native long _getEventCount();
+	/**
+	 * Returns the number of events in the session log.
+	 * @return The number of events in the session log.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public long getEventCount() {
+		checkExcept();
+		return _getEventCount();
+	}
+
+	private native long _getReplayedEventCount();
+	/**
+	 * Returns the number of events replayed since the start (or the last {@link #rewind()}).
+	 * @return The number of events replayed.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public long getReplayedEventCount() {
+		checkExcept();
+		return _getReplayedEventCount();
+	}
+
+	private native boolean _isTruncated();
+	/**
+	 * Returns whether the session log was cut short. Events after the last complete block are not replayed.
+	 * @return Whether the session log was cut short.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public boolean isTruncated() {
+		checkExcept();
+		return _isTruncated();
+	}
+
+	//Native method that returns the address of the peer table of the native ReplayHub.
+	private native long _getPeers();
+	//Native method that registers a wrapper created by Hub.createListenerWrapper(), or replaces the Myos of one
+	//already registered. Same as in Hub.
+	private native void _addDeviceListener(long address, long[] myos);
+	//Native method that removes a registered wrapper. The wrapper is destroyed separately.
+	private native void _removeDeviceListener(long address);
+	/**
+	 * Register a listener to be called when replayed events occur.
+	 * @param listener The listener to register.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public void addListener(DeviceListener listener) {
+		addListener(listener, new Myo[0]);
+	}
+	/**
+	 * Register a listener to be called when replayed events of certain {@link Myo}s occur.<br>
+	 * <br>
+	 * Works the same way as {@link Hub#addListener(DeviceListener, Myo...)}, with the {@link Myo}s handed out by
+	 * this {@link ReplayHub}.
+	 * @param listener The listener to register.
+	 * @param only The {@link Myo}s whose events the listener gets.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public void addListener(DeviceListener listener, Myo... only) {
+		checkExcept();
+		long[] myos = Hub.nativeAddresses(only);
+		Long registered = deviceListenerAddresses.get(listener);
+		if(registered != null) {
+			_addDeviceListener(registered, myos);
+			return;
+		}
+		long address = Hub.createListenerWrapper(_getPeers(), listener);
+		Hub._setEmgBatching(address, emgBatchFrames, emgBatchLatencyMs);
+		Hub._setEmgFeatures(address, emgFeatureWindow, emgFeatureHop);
+		_addDeviceListener(address, myos);
+		deviceListenerAddresses.put(listener, address);
+	}
+	/**
+	 * Remove a previously registered listener. If the listener was never registered, this method will do nothing.
+	 * @param listener The listener to remove.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public void removeListener(DeviceListener listener) {
+		checkExcept();
+		Long address = deviceListenerAddresses.remove(listener);
+		if(address == null) {
+			return;
+		}
+		_removeDeviceListener(address);
+		Hub._deleteListenerWrapper(address);
+	}
+
+	//Native method that registers a wrapper created by Hub.createFrameAssembler(), same as in Hub.
+	private native void _addFrameListener(long address);
+	//Native method that removes a registered frame listener wrapper. The wrapper is destroyed separately.
+	private native void _removeFrameListener(long address);
+	/**
+	 * Register a listener to be called with synchronized frames of several replayed {@link Myo}s.<br>
+	 * <br>
+	 * Works the same way as {@link Hub#addFrameListener(FrameListener, FrameAssembler)}, with the {@link Myo}s handed
+	 * out by this {@link ReplayHub}. Frames are assembled from the recorded timestamps, so a replay produces the same
+	 * frames at any speed.
+	 * @param listener The listener to register.
+	 * @param assembler The {@link Myo}s and settings of the frames.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public void addFrameListener(FrameListener listener, FrameAssembler assembler) {
+		checkExcept();
+		removeFrameListener(listener);
+		long address = Hub.createFrameAssembler(listener, assembler);
+		_addFrameListener(address);
+		frameListenerAddresses.put(listener, address);
+	}
+	/**
+	 * Remove a previously registered frame listener. If the listener was never registered, this method will do
+	 * nothing.
+	 * @param listener The listener to remove.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public void removeFrameListener(FrameListener listener) {
+		checkExcept();
+		Long address = frameListenerAddresses.remove(listener);
+		if(address == null) {
+			return;
+		}
+		_removeFrameListener(address);
+		Hub._deleteFrameAssembler(address);
+	}
+
+	//EMG batching parameters applied to every registered listener, same as in Hub.
+	private int emgBatchFrames = 32;
+	private int emgBatchLatencyMs = 100;
+	/**
+	 * Set how EMG data is batched for listeners that implement
+	 * {@link DeviceListener#onEmgBatch(Myo, long[], java.nio.ByteBuffer, int)}.<br>
+	 * <br>
+	 * Works the same way as {@link Hub#setEmgBatching(int, int)}. Batches are formed by recorded timestamps, so
+	 * they come out the same at any replay speed.
+	 * @param maxFrames The maximum number of frames in a batch.
+	 * @param maxLatencyMs The maximum age of the oldest frame of a batch, in milliseconds.
+	 * @throws IllegalArgumentException If <em>maxFrames</em> is less than 1 or <em>maxLatencyMs</em> is negative.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public void setEmgBatching(int maxFrames, int maxLatencyMs) {
+		checkExcept();
+		if(maxFrames < 1) {
+			throw new IllegalArgumentException("A batch must hold at least one frame");
+		}
+		if(maxLatencyMs < 0) {
+			throw new IllegalArgumentException("Latency cannot be negative");
+		}
+		emgBatchFrames = maxFrames;
+		emgBatchLatencyMs = maxLatencyMs;
+		for(long address : deviceListenerAddresses.values()) {
+			Hub._setEmgBatching(address, maxFrames, maxLatencyMs);
+		}
+	}
+	/**
+	 * Deliver the EMG frames waiting in batches right away. Works the same way as {@link Hub#flushEmgBatches()}.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public void flushEmgBatches() {
+		checkExcept();
+		for(long address : deviceListenerAddresses.values()) {
+			Hub._flushEmgBatches(address);
+		}
+	}
+
+	//EMG feature parameters applied to every registered listener, same as in Hub.
+	private int emgFeatureWindow = 40;
+	private int emgFeatureHop = 10;
+	/**
+	 * Set how EMG features are computed for listeners that implement
+	 * {@link DeviceListener#onEmgFeatures(Myo, long, float[])}.<br>
+	 * <br>
+	 * Works the same way as {@link Hub#setEmgFeatures(int, int)}.
+	 * @param windowFrames The number of frames the features are computed over.
+	 * @param hopFrames The number of frames between two calls.
+	 * @throws IllegalArgumentException If <em>windowFrames</em> or <em>hopFrames</em> is less than 1.
+	 * @throws MyoException If this {@link ReplayHub}'s resources have already been released.
+	 */
+	public void setEmgFeatures(int windowFrames, int hopFrames) {
+		checkExcept();
+		if(windowFrames < 1) {
+			throw new IllegalArgumentException("A window must hold at least one frame");
+		}
+		if(hopFrames < 1) {
+			throw new IllegalArgumentException("Hop must be at least one frame");
+		}
+		emgFeatureWindow = windowFrames;
+		emgFeatureHop = hopFrames;
+		for(long address : deviceListenerAddresses.values()) {
+			Hub._setEmgFeatures(address, windowFrames, hopFrames);
+		}
+	}
+}
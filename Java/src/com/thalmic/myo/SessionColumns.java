@@ -0,0 +1,290 @@
+package com.thalmic.myo;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
+import java.nio.LongBuffer;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.Set;
+
+/**
+ * The EMG and IMU data of a session log in columnar form, memory-mapped from a column file.<br>
+ * <br>
+ * A column file holds one contiguous array per channel, so that training data can be loaded without going through
+ * the log event by event. Column files are created from session logs (see {@link Hub#startRecording(Path)}) by
+ * {@link #export(Path, Path)}, and opened with {@link #open(Path)}.<br>
+ * <br>
+ * EMG and IMU data come at different rates, so they form two separate tables with their own row counts:
+ * <ul>
+ * <li>EMG: {@code emg.timestamp} (long), {@code emg.myo} (byte), and {@code emg.0} to {@code emg.7} (byte)</li>
+ * <li>IMU: {@code imu.timestamp} (long), {@code imu.myo} (byte), {@code quat.x}, {@code quat.y}, {@code quat.z},
+ * {@code quat.w}, {@code accel.x}, {@code accel.y}, {@code accel.z}, {@code gyro.x}, {@code gyro.y} and
+ * {@code gyro.z} (float)</li>
+ * </ul>
+ * The {@code myo} columns hold the index of the device of each row, see {@link #getMacAddress(int)}.
+ * Timestamps are in microseconds, as in {@link DeviceListener}.<br>
+ * <br>
+ * Every column is a read-only view of the mapped file; nothing is copied, and pages are only read from disk as
+ * they are touched. The buffers stay valid after the file is deleted. See ColumnExport.h in the native sources
+ * for the exact format.
+ */
+public final class SessionColumns {
+
+	static {
+		System.loadLibrary("myo_jni");
+	}
+
+	//Layout of the file header and column descriptors; see ColumnExport.h
+	private static final byte[] MAGIC = { 'M', 'Y', 'O', 'C', 'O', 'L', 'S', 0 };
+	private static final int VERSION = 1;
+	private static final int HEADER_SIZE = 64;
+	private static final int DESCRIPTOR_SIZE = 40;
+	private static final int NAME_SIZE = 16;
+	private static final int STREAM_EMG = 0;
+
+	private final int myoCount;
+	private final long[] macAddresses;
+	private final long emgRows;
+	private final long imuRows;
+	private final long createdTime;
+	//Mapped columns by name, in file order. Every buffer is little-endian.
+	private final Map<String, ByteBuffer> columns = new LinkedHashMap<String, ByteBuffer>();
+
+	//Native method that reads the session log and writes the column file.
+	private static native void _export(String sessionLog, String columnFile) throws IOException;
+	/**
+	 * Convert a session log into a column file.<br>
+	 * <br>
+	 * Only EMG and IMU events are exported. If the log was cut short, everything up to its last complete block
+	 * is exported.
+	 * @param sessionLog The session log to read.
+	 * @param columnFile The column file to write. It is overwritten if it exists.
+	 * @throws IOException If the session log could not be read or the column file could not be written.
+	 */
+	public static void export(Path sessionLog, Path columnFile) throws IOException {
+		_export(sessionLog.toAbsolutePath().toString(), columnFile.toAbsolutePath().toString());
+	}
+
+	/**
+	 * Open a column file created by {@link #export(Path, Path)}.
+	 * @param columnFile The column file.
+	 * @return The columns of the file.
+	 * @throws IOException If the file could not be read or is not a column file.
+	 */
+	public static SessionColumns open(Path columnFile) throws IOException {
+		FileChannel channel = FileChannel.open(columnFile, StandardOpenOption.READ);
+		try {
+			return new SessionColumns(channel);
+		}
+		finally {
+			//Mappings stay valid after the channel is closed
+			channel.close();
+		}
+	}
+
+	private SessionColumns(FileChannel channel) throws IOException {
+		long fileSize = channel.size();
+		if(fileSize < HEADER_SIZE) {
+			throw new IOException("Not a column file");
+		}
+		ByteBuffer header = channel.map(FileChannel.MapMode.READ_ONLY, 0, HEADER_SIZE).order(ByteOrder.LITTLE_ENDIAN);
+		for(int i = 0; i < MAGIC.length; i ++) {
+			if(header.get(i) != MAGIC[i]) {
+				throw new IOException("Not a column file");
+			}
+		}
+		if(header.getInt(8) != VERSION || header.getInt(12) != HEADER_SIZE || header.getInt(20) != DESCRIPTOR_SIZE) {
+			throw new IOException("Unsupported column file version");
+		}
+		int columnCount = header.getInt(16);
+		myoCount = header.getInt(24);
+		emgRows = header.getLong(32);
+		imuRows = header.getLong(40);
+		createdTime = header.getLong(48);
+
+		long tableSize = (long) myoCount * 8 + (long) columnCount * DESCRIPTOR_SIZE;
+		if(myoCount < 0 || columnCount < 0 || HEADER_SIZE + tableSize > fileSize) {
+			throw new IOException("Column file is damaged");
+		}
+		ByteBuffer table = channel.map(FileChannel.MapMode.READ_ONLY, HEADER_SIZE, tableSize).order(ByteOrder.LITTLE_ENDIAN);
+		macAddresses = new long[myoCount];
+		for(int i = 0; i < myoCount; i ++) {
+			macAddresses[i] = table.getLong();
+		}
+		byte[] name = new byte[NAME_SIZE];
+		for(int i = 0; i < columnCount; i ++) {
+			table.get(name);
+			int length = 0;
+			while(length < NAME_SIZE && name[length] != 0) {
+				length ++;
+			}
+			table.getInt(); //type
+			int stream = table.getInt();
+			long offset = table.getLong();
+			long size = table.getLong();
+			long rows = stream == STREAM_EMG ? emgRows : imuRows;
+			if(offset < 0 || size < 0 || offset + size > fileSize || (rows > 0 && size % rows != 0)) {
+				throw new IOException("Column file is damaged");
+			}
+			if(size > Integer.MAX_VALUE) {
+				throw new IOException("Column too large to map");
+			}
+			MappedByteBuffer column = channel.map(FileChannel.MapMode.READ_ONLY, offset, size);
+			column.order(ByteOrder.LITTLE_ENDIAN);
+			columns.put(new String(name, 0, length, StandardCharsets.US_ASCII), column);
+		}
+	}
+
+	/**
+	 * Returns the number of rows of each EMG column.
+	 * @return The number of EMG frames.
+	 */
+	public long getEmgRowCount() {
+		return emgRows;
+	}
+	/**
+	 * Returns the number of rows of each IMU column.
+	 * @return The number of IMU frames.
+	 */
+	public long getImuRowCount() {
+		return imuRows;
+	}
+	/**
+	 * Returns the number of devices in the file. The {@code myo} columns hold values from 0 to this number minus 1.
+	 * @return The number of devices.
+	 */
+	public int getMyoCount() {
+		return myoCount;
+	}
+	/**
+	 * Returns the MAC address of a device, as the lower 48 bits of a long.
+	 * @param myoIndex The index of the device, as found in the {@code myo} columns.
+	 * @return The MAC address of the device.
+	 * @throws IndexOutOfBoundsException If there is no device with that index.
+	 */
+	public long getMacAddress(int myoIndex) {
+		return macAddresses[myoIndex];
+	}
+	/**
+	 * Returns the time at which the session log was started, in microseconds since the Unix epoch.
+	 * @return The time the session was recorded.
+	 */
+	public long getCreatedTime() {
+		return createdTime;
+	}
+	/**
+	 * Returns the names of all columns in the file, in file order.
+	 * @return The names of the columns.
+	 */
+	public Set<String> getColumnNames() {
+		return Collections.unmodifiableSet(columns.keySet());
+	}
+
+	/**
+	 * Returns a column as raw little-endian bytes.<br>
+	 * <br>
+	 * The buffer is a new read-only view of the mapped column, so its position and limit can be changed freely.
+	 * @param name The name of the column.
+	 * @return The column, or {@code null} if there is no column with that name.
+	 */
+	public ByteBuffer getColumn(String name) {
+		ByteBuffer column = columns.get(name);
+		return column != null ? column.duplicate().order(ByteOrder.LITTLE_ENDIAN) : null;
+	}
+	//Returns the column, or throws if the file doesn't have it.
+	private ByteBuffer requireColumn(String name) {
+		ByteBuffer column = getColumn(name);
+		if(column == null) {
+			throw new IllegalStateException("Column file has no " + name + " column");
+		}
+		return column;
+	}
+
+	/**
+	 * Returns the timestamps of the EMG frames.
+	 * @return The {@code emg.timestamp} column.
+	 */
+	public LongBuffer getEmgTimestamps() {
+		return requireColumn("emg.timestamp").asLongBuffer();
+	}
+	/**
+	 * Returns the device index of each EMG frame.
+	 * @return The {@code emg.myo} column.
+	 * @see #getMacAddress(int)
+	 */
+	public ByteBuffer getEmgMyos() {
+		return requireColumn("emg.myo");
+	}
+	/**
+	 * Returns the samples of one EMG sensor.
+	 * @param sensor The sensor, from 0 to 7.
+	 * @return The {@code emg.<sensor>} column.
+	 * @throws IllegalArgumentException If <em>sensor</em> is not between 0 and 7.
+	 */
+	public ByteBuffer getEmg(int sensor) {
+		if(sensor < 0 || sensor > 7) {
+			throw new IllegalArgumentException("EMG sensor must be between 0 and 7");
+		}
+		return requireColumn("emg." + sensor);
+	}
+
+	/**
+	 * Returns the timestamps of the IMU frames.
+	 * @return The {@code imu.timestamp} column.
+	 */
+	public LongBuffer getImuTimestamps() {
+		return requireColumn("imu.timestamp").asLongBuffer();
+	}
+	/**
+	 * Returns the device index of each IMU frame.
+	 * @return The {@code imu.myo} column.
+	 * @see #getMacAddress(int)
+	 */
+	public ByteBuffer getImuMyos() {
+		return requireColumn("imu.myo");
+	}
+	/**
+	 * Returns one component of the orientation quaternions.
+	 * @param component The component, 'x', 'y', 'z' or 'w'.
+	 * @return The {@code quat.<component>} column.
+	 * @throws IllegalArgumentException If <em>component</em> is not one of the above.
+	 */
+	public FloatBuffer getOrientation(char component) {
+		if(component != 'x' && component != 'y' && component != 'z' && component != 'w') {
+			throw new IllegalArgumentException("Quaternion component must be x, y, z or w");
+		}
+		return requireColumn("quat." + component).asFloatBuffer();
+	}
+	/**
+	 * Returns one axis of the accelerometer data, in units of g.
+	 * @param axis The axis, 'x', 'y' or 'z'.
+	 * @return The {@code accel.<axis>} column.
+	 * @throws IllegalArgumentException If <em>axis</em> is not one of the above.
+	 */
+	public FloatBuffer getAccelerometer(char axis) {
+		return requireColumn("accel." + checkAxis(axis)).asFloatBuffer();
+	}
+	/**
+	 * Returns one axis of the gyroscope data, in units of deg/s.
+	 * @param axis The axis, 'x', 'y' or 'z'.
+	 * @return The {@code gyro.<axis>} column.
+	 * @throws IllegalArgumentException If <em>axis</em> is not one of the above.
+	 */
+	public FloatBuffer getGyroscope(char axis) {
+		return requireColumn("gyro." + checkAxis(axis)).asFloatBuffer();
+	}
+	private static char checkAxis(char axis) {
+		if(axis != 'x' && axis != 'y' && axis != 'z') {
+			throw new IllegalArgumentException("Axis must be x, y or z");
+		}
+		return axis;
+	}
+}
@@ -0,0 +1,176 @@
+package com.thalmic.myo;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+/**
+ * The data of several {@link Myo}s at one tick, as assembled by a {@link FrameAssembler}.<br>
+ * <br>
+ * A {@link SyncFrame} is a view of a direct buffer that the native code writes each frame into before calling
+ * {@link FrameListener#onFrame(SyncFrame)}. Reading it does not allocate anything, but the contents are only valid
+ * during that call. Devices are numbered in the order they were given to the {@link FrameAssembler}.<br>
+ * <br>
+ * {@link #getBuffer()} gives access to the raw frame, for code that wants to copy it in one go. In the platform's
+ * native byte order, it holds a 16 byte header:
+ * <pre>
+ *     0   long   timestamp of the tick, in microseconds
+ *     8   int    number of devices
+ *     12  int    ticks skipped since the previous frame
+ * </pre>
+ * followed by an 80 byte block per device:
+ * <pre>
+ *     0   int       flags: 1 if the IMU data is valid, 2 if the EMG data is valid
+ *     8   float[4]  orientation x, y, z, w
+ *     24  float[3]  accelerometer x, y, z
+ *     36  float[3]  gyroscope x, y, z
+ *     48  float[8]  EMG
+ * </pre>
+ *
+ */
+public final class SyncFrame {
+
+	//Layout of a frame; this has to match structs SyncFrameHeader and SyncFrameDevice.
+	private static final int TIMESTAMP = 0;
+	private static final int DEVICE_COUNT = 8;
+	private static final int SKIPPED_TICKS = 12;
+	static final int HEADER_SIZE = 16;
+	static final int DEVICE_SIZE = 80;
+	private static final int FLAGS = 0;
+	private static final int ORIENTATION = 8;
+	private static final int ACCELEROMETER = 24;
+	private static final int GYROSCOPE = 36;
+	private static final int EMG = 48;
+
+	private static final int FLAG_IMU = 1;
+	private static final int FLAG_EMG = 2;
+
+	private final Myo[] myos;
+	final ByteBuffer frame;
+	private final ByteBuffer readOnly;
+
+	//Frames are created by the hubs when a FrameListener is registered.
+	SyncFrame(Myo[] myos) {
+		this.myos = myos;
+		frame = ByteBuffer.allocateDirect(HEADER_SIZE + myos.length * DEVICE_SIZE).order(ByteOrder.nativeOrder());
+		readOnly = frame.asReadOnlyBuffer().order(ByteOrder.nativeOrder());
+	}
+
+	/**
+	 * Returns the time of this frame's tick, in microseconds on the same clock as event timestamps.
+	 * @return The timestamp of the tick.
+	 */
+	public long getTimestamp() {
+		return frame.getLong(TIMESTAMP);
+	}
+	/**
+	 * Returns the number of ticks that were skipped just before this frame because no {@link Myo} had any data near
+	 * them, such as while all of them were disconnected.
+	 * @return The number of skipped ticks.
+	 */
+	public int getSkippedTicks() {
+		return frame.getInt(SKIPPED_TICKS);
+	}
+	/**
+	 * Returns the number of devices in this frame.
+	 * @return The number of devices.
+	 */
+	public int getDeviceCount() {
+		return frame.getInt(DEVICE_COUNT);
+	}
+	/**
+	 * Returns the {@link Myo} of a device. This is the same object the hub hands out to listeners.
+	 * @param device The index of the device.
+	 * @return The {@link Myo}.
+	 */
+	public Myo getMyo(int device) {
+		return myos[checkIndex(device, myos.length, "Device")];
+	}
+
+	/**
+	 * Returns whether this frame has IMU data for a device. If not, the device has sent no IMU data near the tick,
+	 * and the orientation is the identity while the accelerometer and gyroscope are zero.
+	 * @param device The index of the device.
+	 * @return Whether the IMU data is valid.
+	 */
+	public boolean hasImu(int device) {
+		return (frame.getInt(offset(device) + FLAGS) & FLAG_IMU) != 0;
+	}
+	/**
+	 * Returns whether this frame has EMG data for a device. If not, the device has sent no EMG data near the tick,
+	 * and the EMG values are zero.
+	 * @param device The index of the device.
+	 * @return Whether the EMG data is valid.
+	 */
+	public boolean hasEmg(int device) {
+		return (frame.getInt(offset(device) + FLAGS) & FLAG_EMG) != 0;
+	}
+
+	/**
+	 * Returns one component of the orientation of a device.
+	 * @param device The index of the device.
+	 * @param component 0 for x, 1 for y, 2 for z, 3 for w.
+	 * @return The quaternion component.
+	 */
+	public float getOrientation(int device, int component) {
+		return frame.getFloat(offset(device) + ORIENTATION + checkIndex(component, 4, "Component") * 4);
+	}
+	/**
+	 * Store the orientation of a device in <em>out</em>.
+	 * @param device The index of the device.
+	 * @param out The quaternion that receives the orientation.
+	 * @return <em>out</em>, after updating the components.
+	 */
+	public Quaternionf getOrientation(int device, Quaternionf out) {
+		int base = offset(device) + ORIENTATION;
+		return out.set(frame.getFloat(base), frame.getFloat(base + 4), frame.getFloat(base + 8), frame.getFloat(base + 12));
+	}
+	/**
+	 * Returns one axis of the accelerometer data of a device.
+	 * @param device The index of the device.
+	 * @param axis 0 for x, 1 for y, 2 for z.
+	 * @return The acceleration, in units of g.
+	 */
+	public float getAccelerometer(int device, int axis) {
+		return frame.getFloat(offset(device) + ACCELEROMETER + checkIndex(axis, 3, "Axis") * 4);
+	}
+	/**
+	 * Returns one axis of the gyroscope data of a device.
+	 * @param device The index of the device.
+	 * @param axis 0 for x, 1 for y, 2 for z.
+	 * @return The angular velocity, in degrees per second.
+	 */
+	public float getGyroscope(int device, int axis) {
+		return frame.getFloat(offset(device) + GYROSCOPE + checkIndex(axis, 3, "Axis") * 4);
+	}
+	/**
+	 * Returns the reading of one EMG sensor of a device. With linear interpolation, this is in between the readings
+	 * of two samples, hence the float.
+	 * @param device The index of the device.
+	 * @param sensor The sensor, from 0 to 7.
+	 * @return The EMG reading.
+	 */
+	public float getEmg(int device, int sensor) {
+		return frame.getFloat(offset(device) + EMG + checkIndex(sensor, 8, "Sensor") * 4);
+	}
+
+	/**
+	 * Returns a read-only view of the raw frame. The layout is described above. The same buffer is returned every
+	 * time, and its contents change with every frame.
+	 * @return The raw frame.
+	 */
+	public ByteBuffer getBuffer() {
+		return readOnly;
+	}
+
+	//Verifies that the index refers to a valid device and returns the offset of its block.
+	private int offset(int device) {
+		return HEADER_SIZE + checkIndex(device, myos.length, "Device") * DEVICE_SIZE;
+	}
+
+	private static int checkIndex(int index, int count, String what) {
+		if(index < 0 || index >= count) {
+			throw new IndexOutOfBoundsException(what + " " + index + " out of bounds for " + count);
+		}
+		return index;
+	}
+}
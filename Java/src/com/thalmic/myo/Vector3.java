@@ -5,7 +5,11 @@ package com.thalmic.myo;
  * <br>
  * This type provides very basic functionality to store a three dimensional vector that's sufficient to retrieve
  * the data to be placed in a full featured vector type. A few common vector operations, such as dot product and
- * cross product, are also provided. 
+ * cross product, are also provided. <br>
+ * <br>
+ * {@link #normalized()} and {@link #cross(Vector3)} return a new object; {@link #normalizeInPlace()} and 
+ * {@link #crossInto(Vector3, Vector3)} write into an existing one instead, so that math done for every frame
+ * creates no garbage. For the same in single precision, see {@link Vector3f}.
  */
 public class Vector3 implements Cloneable {
 	
@@ -60,6 +64,19 @@ public class Vector3 implements Cloneable {
 		this.z = other.z;
 		return this;
 	}
+	/**
+	 * Set the components of this vector.
+	 * @param x The x component.
+	 * @param y The y component.
+	 * @param z The z component.
+	 * @return This vector, after updating the components.
+	 */
+	public Vector3 set(double x, double y, double z) {
+		this.x = x;
+		this.y = y;
+		this.z = z;
+		return this;
+	}
 	
 	/**
 	 * Return a copy of the component of this vector at <em>index</em>, which should be 0, 1, or 2.<br>
@@ -116,8 +133,15 @@ public class Vector3 implements Cloneable {
 	 * @return A normalized copy of this vector.
 	 */
 	public Vector3 normalized() {
+		return new Vector3(this).normalizeInPlace();
+	}
+	/**
+	 * Normalize this vector.
+	 * @return This vector, after updating the components.
+	 */
+	public Vector3 normalizeInPlace() {
 		double mag = magnitude();
-		return new Vector3(this.x / mag, this.y / mag, this.z / mag);
+		return set(this.x / mag, this.y / mag, this.z / mag);
 	}
 	/**
 	 * Return the dot product of this vector and <em>rhs</em>. 
@@ -133,7 +157,17 @@ public class Vector3 implements Cloneable {
 	 * @return The cross product of this vector and <em>rhs</em>.
 	 */
 	public Vector3 cross(Vector3 rhs) {
-		return new Vector3(
+		return crossInto(rhs, new Vector3());
+	}
+	/**
+	 * Store the cross product of this vector and <em>rhs</em> in <em>out</em>, which may be this vector or
+	 * <em>rhs</em>.
+	 * @param rhs The vector to take the cross product with.
+	 * @param out The vector that receives the result.
+	 * @return <em>out</em>, after updating the components.
+	 */
+	public Vector3 crossInto(Vector3 rhs, Vector3 out) {
+		return out.set(
 				y * rhs.z - z * rhs.y,
 	            z * rhs.x - x * rhs.z,
 	            x * rhs.y - y * rhs.x
@@ -0,0 +1,132 @@
+package com.thalmic.myo;
+
+/**
+ * A single-precision, mutable vector of three components for per-frame math.<br>
+ * <br>
+ * This is the counterpart of {@link Vector3} for code that updates the same objects every frame: every operation
+ * writes its result into an existing object, so nothing is allocated once the objects exist. See
+ * {@link Quaternionf}.
+ */
+public final class Vector3f {
+	private float x, y, z;
+
+	/**
+	 * Construct a vector of all zeroes.
+	 */
+	public Vector3f() {
+		x = y = z = 0;
+	}
+	/**
+	 * Construct a vector with the three provided components.
+	 * @param x The x component.
+	 * @param y The y component.
+	 * @param z The z component.
+	 */
+	public Vector3f(float x, float y, float z) {
+		set(x, y, z);
+	}
+	/**
+	 * Construct a vector with the same components as <em>other</em>.
+	 * @param other The vector whose components will be copied.
+	 */
+	public Vector3f(Vector3f other) {
+		set(other);
+	}
+
+	/**
+	 * Set the components of this vector.
+	 * @param x The x component.
+	 * @param y The y component.
+	 * @param z The z component.
+	 * @return This vector, after updating the components.
+	 */
+	public Vector3f set(float x, float y, float z) {
+		this.x = x;
+		this.y = y;
+		this.z = z;
+		return this;
+	}
+	/**
+	 * Set the components of this vector to be the same as <em>other</em>.
+	 * @param other The vector whose components will be copied.
+	 * @return This vector, after updating the components.
+	 */
+	public Vector3f set(Vector3f other) {
+		return set(other.x, other.y, other.z);
+	}
+	/**
+	 * Set the components of this vector to be those of a double-precision vector, rounded to float.
+	 * @param other The vector whose components will be copied.
+	 * @return This vector, after updating the components.
+	 */
+	public Vector3f set(Vector3 other) {
+		return set((float) other.x(), (float) other.y(), (float) other.z());
+	}
+
+	/**
+	 * Return the x-component of this vector.
+	 * @return The x-component of this vector.
+	 */
+	public float x() {
+		return x;
+	}
+	/**
+	 * Return the y-component of this vector.
+	 * @return The y-component of this vector.
+	 */
+	public float y() {
+		return y;
+	}
+	/**
+	 * Return the z-component of this vector.
+	 * @return The z-component of this vector.
+	 */
+	public float z() {
+		return z;
+	}
+
+	/**
+	 * Return the magnitude of this vector.
+	 * @return The magnitude of this vector.
+	 */
+	public float magnitude() {
+		return (float) Math.sqrt(x * x + y * y + z * z);
+	}
+	/**
+	 * Normalize this vector.
+	 * @return This vector, after updating the components.
+	 */
+	public Vector3f normalizeInPlace() {
+		float mag = magnitude();
+		return set(x / mag, y / mag, z / mag);
+	}
+	/**
+	 * Return the dot product of this vector and <em>rhs</em>.
+	 * @param rhs The vector to take the dot product with.
+	 * @return The dot product of this vector and <em>rhs</em>.
+	 */
+	public float dot(Vector3f rhs) {
+		return x * rhs.x + y * rhs.y + z * rhs.z;
+	}
+	/**
+	 * Store the cross product of this vector and <em>rhs</em> in <em>out</em>, which may be this vector or
+	 * <em>rhs</em>.
+	 * @param rhs The vector to take the cross product with.
+	 * @param out The vector that receives the result.
+	 * @return <em>out</em>, after updating the components.
+	 */
+	public Vector3f crossInto(Vector3f rhs, Vector3f out) {
+		return out.set(
+				y * rhs.z - z * rhs.y,
+				z * rhs.x - x * rhs.z,
+				x * rhs.y - y * rhs.x);
+	}
+	/**
+	 * Return the angle between this vector and <em>rhs</em>, in radians.
+	 * @param rhs The vector with whom to take the angle.
+	 * @return The angle between this vector and <em>rhs</em>.
+	 */
+	public float angleTo(Vector3f rhs) {
+		return (float) Math.acos(dot(rhs) / (rhs.magnitude() * magnitude()));
+	}
+}
@@ -0,0 +1,229 @@
+package com.thalmic.myo.test;
+
+import java.io.BufferedReader;
+import java.io.FileInputStream;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryMXBean;
+import java.util.Locale;
+import java.util.Map;
+
+import com.thalmic.myo.DeviceListener;
+import com.thalmic.myo.Hub;
+import com.thalmic.myo.Myo;
+import com.thalmic.myo.Quaternion;
+import com.thalmic.myo.Vector3;
+
+/**
+ * Checks that a long {@link Hub#run(int)} doesn't leak JNI local references.<br>
+ * <br>
+ * Every listener callback creates local references (the Myo, the Quaternion or Vector3, ...) on the thread running
+ * the hub. These stay alive until the native method that created them returns, which for {@link Hub#run(int)} is
+ * only at the end of the whole run, unless each callback pops them again. A leaking callback shows up as heap that
+ * no garbage collection can free, since every leaked reference keeps its object alive, and as native memory taken
+ * by the JVM's reference table.<br>
+ * <br>
+ * This needs the native library built against the simulated libmyo (see the README). A single {@link Hub#run(int)}
+ * call runs for {@value #RUN_MINUTES} simulated minutes of 50 Hz IMU data from {@value #MYOS} armbands, with
+ * orientation, accelerometer and gyroscope callbacks implemented. The heap after a full garbage collection and the
+ * resident set size are sampled from within the callbacks after every simulated minute, and the test fails if they
+ * grow between the end of the first minute and the end of the run. It exits with a non-zero status on failure.
+ *
+ */
+public final class LocalReferenceTest {
+
+	private static final int MYOS = 4;
+	private static final int IMU_RATE = 50;
+	private static final int RUN_MINUTES = 10;
+	private static final long MINUTE_US = 60L * 1000 * 1000;
+
+	//Allowed growth between the first and the last sample. Without popping local references every callback, the
+	//run leaks about 3 objects per IMU event, which is well over 10 MB here.
+	private static final long MAX_HEAP_GROWTH = 2L << 20;
+	private static final long MAX_RSS_GROWTH = 8L << 20;
+
+	//The child process prints its result on a line starting with this
+	private static final String RESULT_PREFIX = "RESULT ";
+
+	private LocalReferenceTest() {
+	}
+
+	public static void main(String[] args) throws Exception {
+		if(args.length == 1 && args[0].equals("--run")) {
+			run();
+			return;
+		}
+
+		String[] result = fork();
+		long heapGrowth = Long.parseLong(result[0]);
+		long rssGrowth = Long.parseLong(result[1]);
+		long events = Long.parseLong(result[2]);
+		System.out.println(String.format(Locale.ROOT, "%d IMU events, heap growth %d bytes, RSS growth %d bytes",
+				events, heapGrowth, rssGrowth));
+
+		boolean failed = false;
+		if(events < (long) MYOS * IMU_RATE * 60 * (RUN_MINUTES - 1)) {
+			System.out.println("FAIL: the run delivered too few events");
+			failed = true;
+		}
+		if(heapGrowth > MAX_HEAP_GROWTH) {
+			System.out.println("FAIL: the heap grew by more than " + MAX_HEAP_GROWTH + " bytes during the run");
+			failed = true;
+		}
+		if(rssGrowth > MAX_RSS_GROWTH) {
+			System.out.println("FAIL: the resident set grew by more than " + MAX_RSS_GROWTH + " bytes during the run");
+			failed = true;
+		}
+		if(failed) {
+			System.exit(1);
+		}
+		System.out.println("PASS");
+	}
+
+	//Runs the test in a new JVM, so that the simulator can be configured through the environment, and returns its
+	//heap growth, RSS growth and number of events.
+	private static String[] fork() throws IOException, InterruptedException {
+		String java = System.getProperty("java.home") + "/bin/java";
+		//The heap is fixed and touched up front, so that it growing doesn't count as resident set growth
+		ProcessBuilder builder = new ProcessBuilder(java,
+				"-Xms64m", "-Xmx64m", "-XX:+AlwaysPreTouch",
+				"-cp", System.getProperty("java.class.path"),
+				"-Djava.library.path=" + System.getProperty("java.library.path"),
+				LocalReferenceTest.class.getName(), "--run");
+		Map<String, String> env = builder.environment();
+		env.put("MYO_SIM_COUNT", Integer.toString(MYOS));
+		env.put("MYO_SIM_IMU_RATE", Integer.toString(IMU_RATE));
+		env.put("MYO_SIM_REALTIME", "0");
+		env.put("MYO_SIM_CONNECTION_INTERVAL", "0");
+		builder.redirectError(ProcessBuilder.Redirect.INHERIT);
+
+		Process process = builder.start();
+		String result = null;
+		BufferedReader reader = new BufferedReader(new InputStreamReader(process.getInputStream(), "UTF-8"));
+		try {
+			String line;
+			while((line = reader.readLine()) != null) {
+				if(line.startsWith(RESULT_PREFIX)) {
+					result = line.substring(RESULT_PREFIX.length());
+				}
+			}
+		}
+		finally {
+			reader.close();
+		}
+		int exitCode = process.waitFor();
+		if(exitCode != 0 || result == null) {
+			throw new IOException("Test process failed with exit code " + exitCode);
+		}
+		return result.split(" ");
+	}
+
+	private static void run() throws IOException {
+		Sampler sampler = new Sampler();
+		Hub hub = new Hub("com.thalmic.myo.test");
+		try {
+			hub.addListener(new ImuListener(sampler));
+			//One call for the whole run, since local references leaked by callbacks are only freed when it returns
+			hub.run((int) (RUN_MINUTES * MINUTE_US / 1000));
+			if(sampler.error != null) {
+				throw sampler.error;
+			}
+			if(sampler.samples < 2) {
+				throw new IOException("The run ended after " + sampler.samples + " sample(s)");
+			}
+			System.out.println(RESULT_PREFIX + (sampler.lastHeap - sampler.firstHeap) + " "
+					+ (sampler.lastRss - sampler.firstRss) + " " + sampler.events);
+			System.out.flush();
+		}
+		finally {
+			hub.release();
+		}
+	}
+
+	//Takes a sample once every simulated minute, from within a callback so that the hub's native frame (and any
+	//references leaked into it) is still alive
+	private static final class Sampler {
+		private final MemoryMXBean memory = ManagementFactory.getMemoryMXBean();
+		long events;
+		long firstTimestamp = -1;
+		long nextSample = MINUTE_US;
+		int samples;
+		long firstHeap;
+		long firstRss;
+		long lastHeap;
+		long lastRss;
+		IOException error;
+
+		void onEvent(long timestamp) {
+			events ++;
+			if(firstTimestamp < 0) {
+				firstTimestamp = timestamp;
+			}
+			if(timestamp - firstTimestamp < nextSample || error != null) {
+				return;
+			}
+			nextSample += MINUTE_US;
+			try {
+				long heap = heapAfterGc();
+				long rss = residentSetSize();
+				if(samples == 0) {
+					firstHeap = heap;
+					firstRss = rss;
+				}
+				lastHeap = heap;
+				lastRss = rss;
+				samples ++;
+			}
+			catch(IOException e) {
+				error = e;
+			}
+		}
+
+		private long heapAfterGc() {
+			for(int i = 0; i < 3; i ++) {
+				System.gc();
+			}
+			return memory.getHeapMemoryUsage().getUsed();
+		}
+	}
+
+	//VmRSS of this process, in bytes
+	private static long residentSetSize() throws IOException {
+		BufferedReader reader = new BufferedReader(new InputStreamReader(new FileInputStream("/proc/self/status"), "UTF-8"));
+		try {
+			String line;
+			while((line = reader.readLine()) != null) {
+				if(line.startsWith("VmRSS:")) {
+					String[] fields = line.substring("VmRSS:".length()).trim().split("\\s+");
+					return Long.parseLong(fields[0]) * 1024;
+				}
+			}
+		}
+		finally {
+			reader.close();
+		}
+		throw new IOException("No VmRSS in /proc/self/status");
+	}
+
+	private static final class ImuListener extends DeviceListener {
+		private final Sampler sampler;
+
+		ImuListener(Sampler sampler) {
+			this.sampler = sampler;
+		}
+
+		@Override
+		public void onOrientationData(Myo myo, long timestamp, Quaternion rotation) {
+			sampler.onEvent(timestamp);
+		}
+
+		@Override
+		public void onAccelerometerData(Myo myo, long timestamp, Vector3 accel) {
+		}
+
+		@Override
+		public void onGyroscopeData(Myo myo, long timestamp, Vector3 gyro) {
+		}
+	}
+}
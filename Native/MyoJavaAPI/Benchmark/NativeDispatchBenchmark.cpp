@@ -0,0 +1,174 @@
+#include "LibmyoSimulator.h"
+#include "MyoEvent.h"
+#include "MyoState.h"
+#include "EventQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <myo/myo.hpp>
+
+using namespace std;
+
+/*
+ * Measures the native half of event dispatch, without a JVM: the stages every event goes through before the first
+ * JNI call. Each stage is run against the simulated libmyo, as fast as the stage can go, with 1, 4 and 16 Myos
+ * streaming IMU and EMG data:
+ *
+ *   libmyo    - the simulator alone, which is the baseline every other stage includes
+ *   decode    - decoding into a MyoEvent and updating the MyoStateBlock, which HubWrapper does for every event
+ *   dispatch  - decode, then dispatchEvent() to an EventListener, like Hub.run() outside of async mode
+ *   queue     - decode, then through the SpscQueue to a consumer thread, like Hub.run() in async mode
+ *
+ * Per-event times are measured around the work of the stage in the libmyo handler, so they leave out the simulator.
+ * The results are printed to standard output as JSON. Needs to be built with MYO_SIMULATED defined; see the README.
+ */
+
+namespace {
+
+const unsigned int simulatedSeconds = 20;
+const unsigned int myoCounts[] = { 1, 4, 16 };
+
+enum Stage {
+	stageLibmyo,
+	stageDecode,
+	stageDispatch,
+	stageQueue
+};
+const char *stageNames[] = { "libmyo", "decode", "dispatch", "queue" };
+
+class CountingListener : public EventListener {
+public:
+	uint64_t count = 0;
+
+	void onImuData(myo::Myo*, uint64_t, const float*) override {
+		count++;
+	}
+	void onEmgData(myo::Myo*, uint64_t, const int8_t*) override {
+		count++;
+	}
+};
+
+struct Context {
+	Stage stage;
+	uint64_t events = 0;
+	vector<uint32_t> times;
+	unordered_map<libmyo_myo_t, MyoStateBlock> states;
+	CountingListener listener;
+	SpscQueue<MyoEvent> *queue = nullptr;
+};
+
+libmyo_handler_result_t handler(void *user_data, libmyo_event_t event) {
+	Context *context = static_cast<Context*>(user_data);
+	libmyo_myo_t opaqueMyo = libmyo_event_get_myo(event);
+	if (libmyo_event_get_type(event) == libmyo_event_paired) {
+		libmyo_set_stream_emg(opaqueMyo, libmyo_stream_emg_enabled, nullptr);
+	}
+	context->events++;
+
+	auto start = chrono::steady_clock::now();
+	if (context->stage != stageLibmyo) {
+		MyoEvent decoded;
+		//The Myo is only used as an address here, so the opaque handle stands in for it
+		decodeEvent(event, reinterpret_cast<myo::Myo*>(opaqueMyo), decoded);
+		context->states[opaqueMyo].update(decoded);
+
+		if (context->stage == stageDispatch) {
+			dispatchEvent(decoded, &context->listener);
+		}
+		else if (context->stage == stageQueue) {
+			while (!context->queue->push(decoded)) {
+				this_thread::yield();
+			}
+		}
+	}
+	auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+	context->times.push_back(static_cast<uint32_t>(elapsed));
+	return libmyo_handler_continue;
+}
+
+uint32_t percentile(const vector<uint32_t> &sorted, double fraction) {
+	if (sorted.empty()) {
+		return 0;
+	}
+	size_t index = static_cast<size_t>(fraction * sorted.size());
+	return sorted[min(index, sorted.size() - 1)];
+}
+
+void runStage(Stage stage, unsigned int myoCount, bool first) {
+	SimulatorConfig config;
+	config.myoCount = myoCount;
+	config.realTime = false;
+	configureSimulator(config);
+
+	Context context;
+	context.stage = stage;
+	context.times.reserve(static_cast<size_t>(myoCount) * (config.imuRate + config.emgRate) * simulatedSeconds * 11 / 10);
+
+	SpscQueue<MyoEvent> queue(4096);
+	atomic<bool> producing(true);
+	uint64_t consumed = 0;
+	thread consumer;
+	if (stage == stageQueue) {
+		context.queue = &queue;
+		consumer = thread([&queue, &producing, &consumed] {
+			MyoEvent event;
+			for (;;) {
+				if (queue.pop(event)) {
+					consumed++;
+				}
+				else if (!producing.load(memory_order_acquire)) {
+					//Anything pushed before the flag was cleared is visible now
+					while (queue.pop(event)) {
+						consumed++;
+					}
+					return;
+				}
+				else {
+					this_thread::yield();
+				}
+			}
+		});
+	}
+
+	libmyo_hub_t hub;
+	libmyo_init_hub(&hub, "com.thalmic.myo.benchmark", nullptr);
+	libmyo_set_locking_policy(hub, libmyo_locking_policy_none, nullptr);
+	auto start = chrono::steady_clock::now();
+	libmyo_run(hub, simulatedSeconds * 1000, &handler, &context, nullptr);
+	producing.store(false, memory_order_release);
+	if (consumer.joinable()) {
+		consumer.join();
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	libmyo_shutdown_hub(hub, nullptr);
+
+	sort(context.times.begin(), context.times.end());
+	printf("%s\n{\"stage\":\"%s\",\"myos\":%u,\"events\":%llu,\"eventsPerSecond\":%.1f,\"p50Ns\":%u,\"p99Ns\":%u,\"p999Ns\":%u,\"maxNs\":%u}",
+		first ? "" : ",", stageNames[stage], myoCount, static_cast<unsigned long long>(context.events), context.events / seconds,
+		percentile(context.times, 0.5), percentile(context.times, 0.99), percentile(context.times, 0.999),
+		context.times.empty() ? 0 : context.times.back());
+	if (stage == stageQueue && consumed != context.events) {
+		fprintf(stderr, "Queue stage lost events: %llu pushed, %llu popped\n",
+			static_cast<unsigned long long>(context.events), static_cast<unsigned long long>(consumed));
+	}
+}
+
+}
+
+int main() {
+	printf("{\"benchmark\":\"nativeDispatch\",\"simulatedSeconds\":%u,\"results\":[", simulatedSeconds);
+	bool first = true;
+	for (int stage = stageLibmyo; stage <= stageQueue; stage++) {
+		for (unsigned int myoCount : myoCounts) {
+			runStage(static_cast<Stage>(stage), myoCount, first);
+			first = false;
+		}
+	}
+	printf("\n]}\n");
+	return 0;
+}
@@ -0,0 +1,216 @@
+#include "ColumnExport.h"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+//A column, and how to get its value out of a record of its stream
+struct ColumnSpec {
+	const char *name;
+	ColumnType type;
+	ColumnStream stream;
+	//Index into the EMG samples or the IMU floats; unused for timestamp and myo columns
+	int index;
+};
+
+enum {
+	indexTimestamp = -1,
+	indexMyo = -2
+};
+
+const ColumnSpec columns[] = {
+	{ "emg.timestamp", columnUint64, columnStreamEmg, indexTimestamp },
+	{ "emg.myo", columnUint8, columnStreamEmg, indexMyo },
+	{ "emg.0", columnInt8, columnStreamEmg, 0 },
+	{ "emg.1", columnInt8, columnStreamEmg, 1 },
+	{ "emg.2", columnInt8, columnStreamEmg, 2 },
+	{ "emg.3", columnInt8, columnStreamEmg, 3 },
+	{ "emg.4", columnInt8, columnStreamEmg, 4 },
+	{ "emg.5", columnInt8, columnStreamEmg, 5 },
+	{ "emg.6", columnInt8, columnStreamEmg, 6 },
+	{ "emg.7", columnInt8, columnStreamEmg, 7 },
+	{ "imu.timestamp", columnUint64, columnStreamImu, indexTimestamp },
+	{ "imu.myo", columnUint8, columnStreamImu, indexMyo },
+	{ "quat.x", columnFloat, columnStreamImu, 0 },
+	{ "quat.y", columnFloat, columnStreamImu, 1 },
+	{ "quat.z", columnFloat, columnStreamImu, 2 },
+	{ "quat.w", columnFloat, columnStreamImu, 3 },
+	{ "accel.x", columnFloat, columnStreamImu, 4 },
+	{ "accel.y", columnFloat, columnStreamImu, 5 },
+	{ "accel.z", columnFloat, columnStreamImu, 6 },
+	{ "gyro.x", columnFloat, columnStreamImu, 7 },
+	{ "gyro.y", columnFloat, columnStreamImu, 8 },
+	{ "gyro.z", columnFloat, columnStreamImu, 9 }
+};
+const uint32_t columnCount = sizeof(columns) / sizeof(columns[0]);
+
+size_t typeSize(ColumnType type) {
+	switch (type) {
+	case columnUint64:
+		return 8;
+	case columnFloat:
+		return 4;
+	default:
+		return 1;
+	}
+}
+
+uint64_t align(uint64_t offset) {
+	return (offset + columnAlignment - 1) / columnAlignment * columnAlignment;
+}
+
+uint32_t streamEventType(ColumnStream stream) {
+	return stream == columnStreamEmg ? libmyo_event_emg : libmyo_event_orientation;
+}
+
+class ColumnWriter {
+public:
+	ColumnWriter(const string &path) : path(path), written(0) {
+		file = fopen(path.c_str(), "wb");
+		if (!file) {
+			throw runtime_error("Cannot create column file " + path);
+		}
+	}
+	~ColumnWriter() {
+		if (file) {
+			fclose(file);
+		}
+	}
+
+	void write(const void *data, size_t size) {
+		if (size > 0 && fwrite(data, size, 1, file) != 1) {
+			throw runtime_error("Cannot write to column file " + path);
+		}
+		written += size;
+	}
+	//Pads with zeros up to offset
+	void padTo(uint64_t offset) {
+		static const uint8_t zeros[columnAlignment] = {};
+		write(zeros, static_cast<size_t>(offset - written));
+	}
+	void close() {
+		int result = fclose(file);
+		file = nullptr;
+		if (result != 0) {
+			throw runtime_error("Cannot write to column file " + path);
+		}
+	}
+
+private:
+	string path;
+	FILE *file;
+	uint64_t written;
+};
+
+//Writes one column, going through all records of its stream. Values are buffered, so the file is written in
+//large sequential chunks.
+template<typename T, typename F>
+void writeColumn(ColumnWriter &writer, const SessionReader &reader, uint32_t eventType, F value) {
+	vector<T> buffer;
+	buffer.reserve(16384);
+	for (const SessionReader::Block &block : reader.blocks()) {
+		for (uint32_t i = 0; i < block.count; i++) {
+			const SessionRecord &record = block.records[i];
+			if (record.type != eventType) {
+				continue;
+			}
+			buffer.push_back(value(record));
+			if (buffer.size() == buffer.capacity()) {
+				writer.write(buffer.data(), buffer.size() * sizeof(T));
+				buffer.clear();
+			}
+		}
+	}
+	writer.write(buffer.data(), buffer.size() * sizeof(T));
+}
+
+}
+
+void exportColumns(const SessionReader &reader, const string &path) {
+	//First pass: count the rows of each stream and number the Myos in the order they first appear
+	ColumnFileHeader header = {};
+	vector<uint64_t> macAddresses;
+	unordered_map<uint64_t, uint8_t> myoIndices;
+	for (const SessionReader::Block &block : reader.blocks()) {
+		for (uint32_t i = 0; i < block.count; i++) {
+			const SessionRecord &record = block.records[i];
+			if (record.type == libmyo_event_emg) {
+				header.emgRows++;
+			}
+			else if (record.type == libmyo_event_orientation) {
+				header.imuRows++;
+			}
+			else {
+				continue;
+			}
+			if (myoIndices.find(record.macAddress) == myoIndices.end()) {
+				if (macAddresses.size() > UINT8_MAX) {
+					throw runtime_error("Session log has too many Myos for a column file");
+				}
+				myoIndices.emplace(record.macAddress, static_cast<uint8_t>(macAddresses.size()));
+				macAddresses.push_back(record.macAddress);
+			}
+		}
+	}
+
+	memcpy(header.magic, columnFileMagic, sizeof(header.magic));
+	header.version = columnFileVersion;
+	header.headerSize = sizeof(ColumnFileHeader);
+	header.columnCount = columnCount;
+	header.columnDescriptorSize = sizeof(ColumnDescriptor);
+	header.myoCount = static_cast<uint32_t>(macAddresses.size());
+	header.createdTime = reader.header().createdTime;
+
+	ColumnDescriptor descriptors[columnCount] = {};
+	uint64_t offset = align(sizeof(ColumnFileHeader) + macAddresses.size() * sizeof(uint64_t) + sizeof(descriptors));
+	for (uint32_t c = 0; c < columnCount; c++) {
+		ColumnDescriptor &descriptor = descriptors[c];
+		strncpy(descriptor.name, columns[c].name, sizeof(descriptor.name));
+		descriptor.type = columns[c].type;
+		descriptor.stream = columns[c].stream;
+		descriptor.offset = offset;
+		descriptor.size = (columns[c].stream == columnStreamEmg ? header.emgRows : header.imuRows) * typeSize(columns[c].type);
+		offset = align(offset + descriptor.size);
+	}
+
+	ColumnWriter writer(path);
+	writer.write(&header, sizeof(header));
+	writer.write(macAddresses.data(), macAddresses.size() * sizeof(uint64_t));
+	writer.write(descriptors, sizeof(descriptors));
+
+	//One pass over the records per column keeps the output sequential. The records stay in the page cache
+	//after the first pass, so the later ones are cheap.
+	for (uint32_t c = 0; c < columnCount; c++) {
+		const ColumnSpec &spec = columns[c];
+		uint32_t eventType = streamEventType(spec.stream);
+		int index = spec.index;
+		writer.padTo(descriptors[c].offset);
+		if (index == indexTimestamp) {
+			writeColumn<uint64_t>(writer, reader, eventType, [](const SessionRecord &record) {
+				return record.timestamp;
+			});
+		}
+		else if (index == indexMyo) {
+			writeColumn<uint8_t>(writer, reader, eventType, [&myoIndices](const SessionRecord &record) {
+				return myoIndices.find(record.macAddress)->second;
+			});
+		}
+		else if (spec.stream == columnStreamEmg) {
+			writeColumn<int8_t>(writer, reader, eventType, [index](const SessionRecord &record) {
+				return record.data.emg[index];
+			});
+		}
+		else {
+			writeColumn<float>(writer, reader, eventType, [index](const SessionRecord &record) {
+				return record.data.imu[index];
+			});
+		}
+	}
+	writer.padTo(offset);
+	writer.close();
+}
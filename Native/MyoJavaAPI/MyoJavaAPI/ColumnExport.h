@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "SessionReader.h"
+
+/*
+ * The column file format.
+ *
+ * A column file holds the EMG and IMU data of a session log with one contiguous array per channel, so that a
+ * dataset can be memory-mapped and used as is instead of being parsed event by event. EMG and IMU data come at
+ * different rates, so they are two separate tables ("streams") with a timestamp column each.
+ *
+ * The file starts with a ColumnFileHeader, followed by the MAC address (uint64_t) of each Myo, and then a
+ * ColumnDescriptor for each column. The "myo" columns of both streams hold indices into the MAC addresses. Every
+ * column starts at a multiple of columnAlignment bytes. Everything is little-endian.
+ *
+ *   emg.timestamp  uint64   emg.myo  uint8   emg.0 ... emg.7  int8
+ *   imu.timestamp  uint64   imu.myo  uint8   quat.x, quat.y, quat.z, quat.w, accel.x ... accel.z, gyro.x ... gyro.z  float
+ */
+struct ColumnFileHeader {
+	//"MYOCOLS" followed by a zero byte
+	char magic[8];
+	uint32_t version;
+	uint32_t headerSize;
+	uint32_t columnCount;
+	uint32_t columnDescriptorSize;
+	uint32_t myoCount;
+	uint32_t reserved0;
+	uint64_t emgRows;
+	uint64_t imuRows;
+	//createdTime of the session log
+	uint64_t createdTime;
+	uint8_t reserved[8];
+};
+
+enum ColumnType {
+	columnUint64 = 0,
+	columnFloat = 1,
+	columnInt8 = 2,
+	columnUint8 = 3
+};
+
+enum ColumnStream {
+	columnStreamEmg = 0,
+	columnStreamImu = 1
+};
+
+struct ColumnDescriptor {
+	//Zero-padded
+	char name[16];
+	uint32_t type; //ColumnType
+	uint32_t stream; //ColumnStream
+	//From the start of the file
+	uint64_t offset;
+	uint64_t size;
+};
+
+const char columnFileMagic[8] = { 'M', 'Y', 'O', 'C', 'O', 'L', 'S', 0 };
+const uint32_t columnFileVersion = 1;
+const uint32_t columnAlignment = 64;
+
+static_assert(sizeof(ColumnFileHeader) == 64, "ColumnFileHeader is part of the file format");
+static_assert(sizeof(ColumnDescriptor) == 40, "ColumnDescriptor is part of the file format");
+
+//Writes the EMG and IMU data of the session log to a column file. Throws a runtime_error if writing fails.
+void exportColumns(const SessionReader &reader, const std::string &path);
@@ -0,0 +1,145 @@
+#include "EmgFeatureExtractor.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EMG_FEATURES_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+EmgFeatureExtractor::EmgFeatureExtractor(uint32_t windowFrames, uint32_t hopFrames) : ring(windowFrames), hop(hopFrames) {
+	reset();
+}
+
+void EmgFeatureExtractor::reset() {
+	next = 0;
+	count = 0;
+	//Features are due as soon as the window is first full
+	sinceDue = hop - 1;
+	history = 0;
+	memset(previous, 0, sizeof(previous));
+	memset(beforePrevious, 0, sizeof(beforePrevious));
+	memset(sums, 0, sizeof(sums));
+}
+
+bool EmgFeatureExtractor::push(const int8_t *emg) {
+	Contribution added;
+	contributions(emg, added);
+	Contribution &slot = ring[next];
+	if (count == ring.size()) {
+		accumulate(added, &slot);
+	}
+	else {
+		accumulate(added, nullptr);
+		count++;
+	}
+	slot = added;
+	next = next + 1 == ring.size() ? 0 : next + 1;
+
+	memcpy(beforePrevious, previous, sizeof(previous));
+	memcpy(previous, emg, sizeof(previous));
+	if (history < 2) {
+		history++;
+	}
+
+	if (count < ring.size() || ++sinceDue < hop) {
+		return false;
+	}
+	sinceDue = 0;
+	return true;
+}
+
+void EmgFeatureExtractor::features(float *out) const {
+	float n = count > 0 ? static_cast<float>(count) : 1.0f;
+	for (int s = 0; s < sensors; s++) {
+		out[featureRms * sensors + s] = sqrt(sums[featureRms][s] / n);
+		out[featureMeanAbsoluteValue * sensors + s] = sums[featureMeanAbsoluteValue][s] / n;
+		out[featureWaveformLength * sensors + s] = static_cast<float>(sums[featureWaveformLength][s]);
+		out[featureZeroCrossings * sensors + s] = static_cast<float>(sums[featureZeroCrossings][s]);
+		out[featureSlopeSignChanges * sensors + s] = static_cast<float>(sums[featureSlopeSignChanges][s]);
+	}
+}
+
+#ifdef EMG_FEATURES_SSE2
+
+//Sign-extends 8 samples to 16 bits
+static inline __m128i loadSamples(const int8_t *samples) {
+	__m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(samples));
+	return _mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8);
+}
+
+static inline __m128i abs16(__m128i x) {
+	return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+void EmgFeatureExtractor::contributions(const int8_t *emg, Contribution &contribution) const {
+	const __m128i zero = _mm_setzero_si128();
+	__m128i x = loadSamples(emg);
+	__m128i p = loadSamples(previous);
+	__m128i pp = loadSamples(beforePrevious);
+	__m128i hasPrevious = history >= 1 ? _mm_set1_epi16(-1) : zero;
+	__m128i hasBeforePrevious = history >= 2 ? _mm_set1_epi16(-1) : zero;
+
+	//Samples are at most 128 in magnitude, so neither the square nor the product of two samples overflows 16 bits
+	__m128i square = _mm_mullo_epi16(x, x);
+	__m128i absolute = abs16(x);
+	__m128i absDiff = _mm_and_si128(abs16(_mm_sub_epi16(x, p)), hasPrevious);
+	__m128i crossing = _mm_and_si128(_mm_cmplt_epi16(_mm_mullo_epi16(x, p), zero), hasPrevious);
+	//The previous sample is an extremum if it differs from both of its neighbours in the same direction
+	__m128i rise = _mm_sub_epi16(p, pp);
+	__m128i fall = _mm_sub_epi16(p, x);
+	__m128i extremum = _mm_or_si128(
+		_mm_and_si128(_mm_cmpgt_epi16(rise, zero), _mm_cmpgt_epi16(fall, zero)),
+		_mm_and_si128(_mm_cmplt_epi16(rise, zero), _mm_cmplt_epi16(fall, zero)));
+	extremum = _mm_and_si128(extremum, hasBeforePrevious);
+
+	//Comparisons give -1 for true; shifting the sign bit down turns that into 1
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(contribution.values[featureRms]), square);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(contribution.values[featureMeanAbsoluteValue]), absolute);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(contribution.values[featureWaveformLength]), absDiff);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(contribution.values[featureZeroCrossings]), _mm_srli_epi16(crossing, 15));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(contribution.values[featureSlopeSignChanges]), _mm_srli_epi16(extremum, 15));
+}
+
+void EmgFeatureExtractor::accumulate(const Contribution &added, const Contribution *removed) {
+	for (int feature = 0; feature < featureCount; feature++) {
+		__m128i delta = _mm_loadu_si128(reinterpret_cast<const __m128i*>(added.values[feature]));
+		if (removed) {
+			//Squares are at most 16384, so the difference of two contributions still fits in 16 bits
+			delta = _mm_sub_epi16(delta, _mm_loadu_si128(reinterpret_cast<const __m128i*>(removed->values[feature])));
+		}
+		__m128i sign = _mm_srai_epi16(delta, 15);
+		__m128i *sum = reinterpret_cast<__m128i*>(sums[feature]);
+		_mm_storeu_si128(sum, _mm_add_epi32(_mm_loadu_si128(sum), _mm_unpacklo_epi16(delta, sign)));
+		_mm_storeu_si128(sum + 1, _mm_add_epi32(_mm_loadu_si128(sum + 1), _mm_unpackhi_epi16(delta, sign)));
+	}
+}
+
+#else
+
+void EmgFeatureExtractor::contributions(const int8_t *emg, Contribution &contribution) const {
+	for (int s = 0; s < sensors; s++) {
+		int x = emg[s];
+		int p = previous[s];
+		int rise = p - beforePrevious[s];
+		int fall = p - x;
+		contribution.values[featureRms][s] = static_cast<int16_t>(x * x);
+		contribution.values[featureMeanAbsoluteValue][s] = static_cast<int16_t>(abs(x));
+		contribution.values[featureWaveformLength][s] = history >= 1 ? static_cast<int16_t>(abs(x - p)) : 0;
+		contribution.values[featureZeroCrossings][s] = history >= 1 && x * p < 0;
+		contribution.values[featureSlopeSignChanges][s] = history >= 2 && ((rise > 0 && fall > 0) || (rise < 0 && fall < 0));
+	}
+}
+
+void EmgFeatureExtractor::accumulate(const Contribution &added, const Contribution *removed) {
+	for (int feature = 0; feature < featureCount; feature++) {
+		for (int s = 0; s < sensors; s++) {
+			sums[feature][s] += added.values[feature][s] - (removed ? removed->values[feature][s] : 0);
+		}
+	}
+}
+
+#endif
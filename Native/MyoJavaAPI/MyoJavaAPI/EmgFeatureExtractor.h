@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/*
+ * Time-domain features of the EMG data of one Myo over a sliding window of frames.
+ *
+ * For each of the 8 sensors the extractor keeps running sums over the last windowFrames frames: the sum of squares
+ * (for the RMS), the sum of absolute values (for the mean absolute value), the waveform length (the sum of the
+ * absolute differences between consecutive samples), the number of zero crossings (consecutive samples of
+ * opposite signs) and the number of slope sign changes (samples that are a strict local minimum or maximum).
+ *
+ * Every frame's contribution to each sum is kept in a ring, so adding a frame adds its contributions and subtracts
+ * those of the frame that leaves the window; the cost of a frame doesn't depend on the window size. A frame of 8
+ * samples, widened to 16 bits, fits in one SSE2 register, so all 8 sensors are updated at once where SSE2 is
+ * available. The pair and triple features of a frame are taken with the frames before it, even if those have
+ * already left the window.
+ */
+class EmgFeatureExtractor {
+
+public:
+	static const int sensors = 8;
+
+	//Order of the features in the output of features(); must match EmgFeature.java
+	enum Feature {
+		featureRms,
+		featureMeanAbsoluteValue,
+		featureWaveformLength,
+		featureZeroCrossings,
+		featureSlopeSignChanges,
+		featureCount
+	};
+
+	//Features are due every hopFrames frames, once the window is full. Both must be at least 1.
+	EmgFeatureExtractor(uint32_t windowFrames, uint32_t hopFrames);
+
+	//Adds a frame of 8 samples. Returns true if a feature vector is due.
+	bool push(const int8_t *emg);
+	//Writes featureCount * sensors values to out; feature f of sensor s goes to out[f * sensors + s].
+	void features(float *out) const;
+	//Forgets every frame, as if the extractor had just been created.
+	void reset();
+
+	uint32_t windowFrames() const {
+		return static_cast<uint32_t>(ring.size());
+	}
+	uint32_t hopFrames() const {
+		return hop;
+	}
+
+private:
+	//What a frame adds to each running sum
+	struct Contribution {
+		int16_t values[featureCount][sensors];
+	};
+
+	std::vector<Contribution> ring;
+	uint32_t hop;
+	//Slot of the next frame, number of frames in the window, and frames since features were last due
+	uint32_t next;
+	uint32_t count;
+	uint32_t sinceDue;
+	//Frames seen since the last reset, up to 2; the pair and triple features need that many frames before
+	uint32_t history;
+	int8_t previous[sensors];
+	int8_t beforePrevious[sensors];
+	int32_t sums[featureCount][sensors];
+
+	void contributions(const int8_t *emg, Contribution &contribution) const;
+	//Adds the contributions of added to the sums, and subtracts those of removed unless it is nullptr
+	void accumulate(const Contribution &added, const Contribution *removed);
+};
@@ -0,0 +1,232 @@
+#include "EmgFilter.h"
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define EMG_FILTER_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+using namespace myo;
+
+static const double pi = 3.14159265358979323846;
+
+EmgFilterChain::EmgFilterChain(const vector<EmgFilterStage> &specs) {
+	for (const EmgFilterStage &spec : specs) {
+		Stage stage = Stage();
+		stage.type = spec.type;
+		stage.b0 = stage.b1 = stage.b2 = stage.a1 = stage.a2 = 0;
+
+		switch (spec.type) {
+		case EmgFilterStage::notch:
+		case EmgFilterStage::highPass:
+		case EmgFilterStage::lowPass: {
+			if (!(spec.frequency > 0 && spec.frequency < sampleRate / 2.0)) {
+				throw invalid_argument("Filter frequency must be between 0 and half the sample rate");
+			}
+			double q = spec.type == EmgFilterStage::notch ? spec.q : 1 / sqrt(2.0);
+			if (!(q > 0)) {
+				throw invalid_argument("Notch quality factor must be positive");
+			}
+			//From the Audio EQ Cookbook
+			double w0 = 2 * pi * spec.frequency / sampleRate;
+			double cosw0 = cos(w0);
+			double alpha = sin(w0) / (2 * q);
+			double b0, b1, b2;
+			if (spec.type == EmgFilterStage::notch) {
+				b0 = 1;
+				b1 = -2 * cosw0;
+				b2 = 1;
+			}
+			else if (spec.type == EmgFilterStage::highPass) {
+				b0 = (1 + cosw0) / 2;
+				b1 = -(1 + cosw0);
+				b2 = (1 + cosw0) / 2;
+			}
+			else {
+				b0 = (1 - cosw0) / 2;
+				b1 = 1 - cosw0;
+				b2 = (1 - cosw0) / 2;
+			}
+			double a0 = 1 + alpha;
+			stage.b0 = static_cast<float>(b0 / a0);
+			stage.b1 = static_cast<float>(b1 / a0);
+			stage.b2 = static_cast<float>(b2 / a0);
+			stage.a1 = static_cast<float>(-2 * cosw0 / a0);
+			stage.a2 = static_cast<float>((1 - alpha) / a0);
+			break;
+		}
+		case EmgFilterStage::rectify:
+			break;
+		case EmgFilterStage::envelope:
+			if (spec.frames < 1) {
+				throw invalid_argument("Envelope must span at least one frame");
+			}
+			stage.ring.resize(spec.frames * sensors);
+			break;
+		default:
+			throw invalid_argument("Unknown filter stage");
+		}
+		stages.push_back(stage);
+	}
+	reset();
+}
+
+void EmgFilterChain::reset() {
+	for (Stage &stage : stages) {
+		memset(stage.z1, 0, sizeof(stage.z1));
+		memset(stage.z2, 0, sizeof(stage.z2));
+		memset(stage.sums, 0, sizeof(stage.sums));
+		stage.next = 0;
+		stage.count = 0;
+	}
+}
+
+#ifdef EMG_FILTER_SSE2
+
+void EmgFilterChain::process(const int8_t *emg, float *out) {
+	//Two registers of 4 sensors each
+	__m128 x[2];
+	__m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(emg));
+	__m128i words = _mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8);
+	x[0] = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16));
+	x[1] = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(words, words), 16));
+
+	for (Stage &stage : stages) {
+		switch (stage.type) {
+		case EmgFilterStage::rectify: {
+			const __m128 signBit = _mm_set1_ps(-0.0f);
+			x[0] = _mm_andnot_ps(signBit, x[0]);
+			x[1] = _mm_andnot_ps(signBit, x[1]);
+			break;
+		}
+		case EmgFilterStage::envelope: {
+			float *slot = &stage.ring[stage.next * sensors];
+			bool full = stage.count * sensors == stage.ring.size();
+			for (int half = 0; half < 2; half++) {
+				__m128 old = full ? _mm_loadu_ps(slot + half * 4) : _mm_setzero_ps();
+				_mm_storeu_ps(slot + half * 4, x[half]);
+				//The sums are doubles, so each half of the 4 floats goes into its own register
+				__m128 delta = _mm_sub_ps(x[half], old);
+				double *sums = stage.sums + half * 4;
+				_mm_storeu_pd(sums, _mm_add_pd(_mm_loadu_pd(sums), _mm_cvtps_pd(delta)));
+				_mm_storeu_pd(sums + 2, _mm_add_pd(_mm_loadu_pd(sums + 2), _mm_cvtps_pd(_mm_movehl_ps(delta, delta))));
+			}
+			if (!full) {
+				stage.count++;
+			}
+			stage.next = (stage.next + 1) * sensors == stage.ring.size() ? 0 : stage.next + 1;
+			__m128d scale = _mm_set1_pd(1.0 / stage.count);
+			for (int half = 0; half < 2; half++) {
+				__m128 low = _mm_cvtpd_ps(_mm_mul_pd(_mm_loadu_pd(stage.sums + half * 4), scale));
+				__m128 high = _mm_cvtpd_ps(_mm_mul_pd(_mm_loadu_pd(stage.sums + half * 4 + 2), scale));
+				x[half] = _mm_movelh_ps(low, high);
+			}
+			break;
+		}
+		default: {
+			__m128 b0 = _mm_set1_ps(stage.b0), b1 = _mm_set1_ps(stage.b1), b2 = _mm_set1_ps(stage.b2);
+			__m128 a1 = _mm_set1_ps(stage.a1), a2 = _mm_set1_ps(stage.a2);
+			for (int half = 0; half < 2; half++) {
+				__m128 z1 = _mm_loadu_ps(stage.z1 + half * 4);
+				__m128 z2 = _mm_loadu_ps(stage.z2 + half * 4);
+				__m128 y = _mm_add_ps(_mm_mul_ps(b0, x[half]), z1);
+				z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x[half]), _mm_mul_ps(a1, y)), z2);
+				z2 = _mm_sub_ps(_mm_mul_ps(b2, x[half]), _mm_mul_ps(a2, y));
+				_mm_storeu_ps(stage.z1 + half * 4, z1);
+				_mm_storeu_ps(stage.z2 + half * 4, z2);
+				x[half] = y;
+			}
+			break;
+		}
+		}
+	}
+
+	_mm_storeu_ps(out, x[0]);
+	_mm_storeu_ps(out + 4, x[1]);
+}
+
+#else
+
+void EmgFilterChain::process(const int8_t *emg, float *out) {
+	float x[sensors];
+	for (int s = 0; s < sensors; s++) {
+		x[s] = emg[s];
+	}
+
+	for (Stage &stage : stages) {
+		switch (stage.type) {
+		case EmgFilterStage::rectify:
+			for (int s = 0; s < sensors; s++) {
+				x[s] = fabs(x[s]);
+			}
+			break;
+		case EmgFilterStage::envelope: {
+			float *slot = &stage.ring[stage.next * sensors];
+			bool full = stage.count * sensors == stage.ring.size();
+			for (int s = 0; s < sensors; s++) {
+				stage.sums[s] += x[s] - (full ? slot[s] : 0.0f);
+				slot[s] = x[s];
+			}
+			if (!full) {
+				stage.count++;
+			}
+			stage.next = (stage.next + 1) * sensors == stage.ring.size() ? 0 : stage.next + 1;
+			for (int s = 0; s < sensors; s++) {
+				x[s] = static_cast<float>(stage.sums[s] / stage.count);
+			}
+			break;
+		}
+		default:
+			for (int s = 0; s < sensors; s++) {
+				float y = stage.b0 * x[s] + stage.z1[s];
+				stage.z1[s] = stage.b1 * x[s] - stage.a1 * y + stage.z2[s];
+				stage.z2[s] = stage.b2 * x[s] - stage.a2 * y;
+				x[s] = y;
+			}
+			break;
+		}
+	}
+
+	memcpy(out, x, sizeof(x));
+}
+
+#endif
+
+void EmgFilterBank::set(Myo *myo, const vector<EmgFilterStage> &stages) {
+	unique_ptr<EmgFilterChain> chain(new EmgFilterChain(stages));
+	lock_guard<std::mutex> lock(mutex);
+	filters[myo] = move(chain);
+}
+
+void EmgFilterBank::clear(Myo *myo) {
+	lock_guard<std::mutex> lock(mutex);
+	filters.erase(myo);
+}
+
+bool EmgFilterBank::process(Myo *myo, const int8_t *emg, float *out) {
+	lock_guard<std::mutex> lock(mutex);
+	auto it = filters.find(myo);
+	if (it == filters.end()) {
+		return false;
+	}
+	it->second->process(emg, out);
+	return true;
+}
+
+void EmgFilterBank::reset(Myo *myo) {
+	lock_guard<std::mutex> lock(mutex);
+	auto it = filters.find(myo);
+	if (it != filters.end()) {
+		it->second->reset();
+	}
+}
+
+void EmgFilterBank::resetAll() {
+	lock_guard<std::mutex> lock(mutex);
+	for (auto &entry : filters) {
+		entry.second->reset();
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <myo/myo.hpp>
+#include "com_thalmic_myo_EmgFilter.h"
+
+//One stage of an EMG filter, as described by a Java EmgFilter
+struct EmgFilterStage {
+	enum Type {
+		//Biquad band-stop around frequency, with quality factor q
+		notch = com_thalmic_myo_EmgFilter_STAGE_NOTCH,
+		//Second order Butterworth filters with their cutoff at frequency
+		highPass = com_thalmic_myo_EmgFilter_STAGE_HIGH_PASS,
+		lowPass = com_thalmic_myo_EmgFilter_STAGE_LOW_PASS,
+		//Absolute value of every sample
+		rectify = com_thalmic_myo_EmgFilter_STAGE_RECTIFY,
+		//Mean of the last frames samples
+		envelope = com_thalmic_myo_EmgFilter_STAGE_ENVELOPE
+	};
+
+	int type;
+	double frequency;
+	double q;
+	uint32_t frames;
+};
+
+/*
+ * A chain of filter stages applied to the EMG data of one Myo.
+ *
+ * Every stage works on all 8 sensors at once: the biquads keep their state for the 8 sensors side by side, so that
+ * a frame goes through each biquad as two 4-wide SSE operations where SSE is available. Biquads run in transposed
+ * direct form II with float state; the envelope keeps its running sums in double, so that they don't drift over a
+ * long session.
+ */
+class EmgFilterChain {
+
+public:
+	static const int sensors = 8;
+	//Rate of Myo EMG data, in frames per second
+	static const int sampleRate = 200;
+
+	//Throws an invalid_argument if a stage isn't valid at sampleRate.
+	explicit EmgFilterChain(const std::vector<EmgFilterStage> &stages);
+
+	//Filters a frame of 8 samples into out.
+	void process(const int8_t *emg, float *out);
+	//Forgets all previous samples.
+	void reset();
+
+private:
+	struct Stage {
+		int type;
+		//Biquad coefficients, normalized so that a0 is 1, and state
+		float b0, b1, b2, a1, a2;
+		float z1[sensors];
+		float z2[sensors];
+		//Envelope window, its running sums, next slot and number of frames in it
+		std::vector<float> ring;
+		double sums[sensors];
+		uint32_t next;
+		uint32_t count;
+	};
+
+	std::vector<Stage> stages;
+};
+
+/*
+ * The EMG filters of the Myos of one hub.
+ *
+ * Java sets and clears filters through Myo.setEmgFilter(), from whatever thread it likes, while the hub filters
+ * every EMG event on the thread that dispatches it, so everything is done under a lock.
+ */
+class EmgFilterBank {
+
+public:
+	//Replaces the filter of the Myo. Throws an invalid_argument if a stage isn't valid.
+	void set(myo::Myo *myo, const std::vector<EmgFilterStage> &stages);
+	void clear(myo::Myo *myo);
+	//Filters a frame of the Myo into out. Returns false, leaving out alone, if the Myo has no filter.
+	bool process(myo::Myo *myo, const int8_t *emg, float *out);
+	//Starts the filter of the Myo over, if it has one. Called when the Myo disconnects or unpairs.
+	void reset(myo::Myo *myo);
+	void resetAll();
+
+private:
+	std::unordered_map<myo::Myo*, std::unique_ptr<EmgFilterChain>> filters;
+	std::mutex mutex;
+};
@@ -0,0 +1,130 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "MyoEvent.h"
+
+/*
+ * The listeners of a hub, sorted by the event types they want.
+ *
+ * Every listener says which event types it handles through EventListener::eventMask(), and may be limited to a set
+ * of Myos. For each event type the dispatcher keeps the list of listeners that handle it, in registration order,
+ * so dispatching an event only touches the listeners that want it: an event type nobody handles costs one branch,
+ * not a virtual call per listener. The lists are rebuilt whenever a listener is added or removed, which is rare
+ * next to dispatching.
+ *
+ * Listeners that want ticks (see EventListener::onTick()) are kept in a list of their own, which the hub runs after
+ * every event it dispatches. So are the orientation listeners that want Euler angles, so the hub can skip working
+ * them out for Myos nobody wants them for.
+ */
+class EventDispatcher {
+
+public:
+	//Adds the listener, or replaces its Myos if it was already added. An empty myos means every Myo.
+	void add(EventListener *listener, const std::vector<myo::Myo*> &myos = std::vector<myo::Myo*>()) {
+		auto it = find(listener);
+		if (it == subscriptions.end()) {
+			subscriptions.push_back(Subscription());
+			it = subscriptions.end() - 1;
+		}
+		it->listener = listener;
+		it->mask = listener->eventMask();
+		it->myos = myos;
+		rebuild();
+	}
+
+	void remove(EventListener *listener) {
+		auto it = find(listener);
+		if (it != subscriptions.end()) {
+			subscriptions.erase(it);
+			rebuild();
+		}
+	}
+
+	bool empty() const {
+		return subscriptions.empty();
+	}
+
+	//Calls onTick() on every listener that wants ticks. Costs one branch if none do.
+	void tick(uint64_t now) const {
+		for (EventListener *listener : tickListeners) {
+			listener->onTick(now);
+		}
+	}
+
+	//Whether a listener that handles orientation events of the Myo wants their Euler angles
+	bool wantsOrientationEuler(myo::Myo *myo) const {
+		for (const Entry &entry : eulerListeners) {
+			if (!entry.myos || std::find(entry.myos->begin(), entry.myos->end(), myo) != entry.myos->end()) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	//Calls the listener method for the event on every listener that handles its type and its Myo.
+	//derived is passed on to dispatchEvent().
+	void dispatch(const MyoEvent &event, const DerivedData &derived = DerivedData()) const {
+		if (event.type >= static_cast<uint32_t>(numEventTypes)) {
+			return;
+		}
+		const std::vector<Entry> &entries = byType[event.type];
+		if (entries.empty()) {
+			return;
+		}
+		myo::Myo *myo = event.myo();
+		for (const Entry &entry : entries) {
+			if (entry.myos && std::find(entry.myos->begin(), entry.myos->end(), myo) == entry.myos->end()) {
+				continue;
+			}
+			dispatchEvent(event, entry.listener, derived);
+		}
+	}
+
+private:
+	struct Subscription {
+		EventListener *listener;
+		uint32_t mask;
+		std::vector<myo::Myo*> myos;
+	};
+	struct Entry {
+		EventListener *listener;
+		//Points into subscriptions, or nullptr if the listener gets events of every Myo
+		const std::vector<myo::Myo*> *myos;
+	};
+
+	std::vector<Subscription> subscriptions;
+	std::vector<Entry> byType[numEventTypes];
+	std::vector<EventListener*> tickListeners;
+	std::vector<Entry> eulerListeners;
+
+	std::vector<Subscription>::iterator find(EventListener *listener) {
+		return std::find_if(subscriptions.begin(), subscriptions.end(), [listener](const Subscription &subscription) {
+			return subscription.listener == listener;
+		});
+	}
+
+	void rebuild() {
+		tickListeners.clear();
+		for (const Subscription &subscription : subscriptions) {
+			if (subscription.listener->wantsTicks()) {
+				tickListeners.push_back(subscription.listener);
+			}
+		}
+		for (int type = 0; type < numEventTypes; type++) {
+			byType[type].clear();
+			for (const Subscription &subscription : subscriptions) {
+				if (subscription.mask & eventBit(static_cast<libmyo_event_type_t>(type))) {
+					Entry entry = { subscription.listener, subscription.myos.empty() ? nullptr : &subscription.myos };
+					byType[type].push_back(entry);
+				}
+			}
+		}
+		eulerListeners.clear();
+		for (const Entry &entry : byType[libmyo_event_orientation]) {
+			if (entry.listener->wantsOrientationEuler()) {
+				eulerListeners.push_back(entry);
+			}
+		}
+	}
+};
@@ -0,0 +1,122 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/*
+ * A bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * The capacity is rounded up to a power of two so that indices can be wrapped with a mask. Every slot carries a
+ * sequence number, as in Dmitry Vyukov's bounded queue, which says whether the slot is free for the push at its
+ * index or holds the item to take at its index. tail is only written by the producer. head is advanced by the
+ * consumer, and by the producer only when it discards the oldest item to make room; both sides claim an item by
+ * advancing head with a compare-and-swap before reading it, and then hand the slot back to the producer through its
+ * sequence number. So exactly one side gets each item, and a slot is never written while it is being read.
+ * Neither side reads the other side's index to push or pop; they only meet in the slots.
+ */
+template<typename T>
+class SpscQueue {
+
+public:
+	explicit SpscQueue(size_t capacity) : slotCount(1), head(0), tail(0) {
+		while (slotCount < capacity) {
+			slotCount <<= 1;
+		}
+		slots.reset(new Slot[slotCount]);
+		for (size_t i = 0; i < slotCount; i++) {
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		mask = slotCount - 1;
+	}
+
+	//Producer only. Returns false if the queue is full, or if the slot is still being read by the side that took
+	//its last item.
+	bool push(const T &item) {
+		size_t t = tail.load(std::memory_order_relaxed);
+		Slot &slot = slots[t & mask];
+		if (slot.sequence.load(std::memory_order_acquire) != t) {
+			return false;
+		}
+		slot.item = item;
+		slot.sequence.store(t + 1, std::memory_order_release);
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	//Producer only. Removes the oldest item, storing it in item. Returns false if the queue isn't full, so that
+	//nothing is discarded while push() is only waiting for the consumer to finish reading a slot.
+	bool discardOldest(T &item) {
+		size_t h = head.load(std::memory_order_acquire);
+		if (tail.load(std::memory_order_relaxed) - h < slotCount) {
+			return false;
+		}
+		return take(item);
+	}
+
+	//Consumer only. Returns false if the queue is empty.
+	bool pop(T &item) {
+		return take(item);
+	}
+
+	//Both of these can be called from any thread, but are only a snapshot.
+	bool empty() const {
+		return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+	}
+	size_t size() const {
+		size_t h = head.load(std::memory_order_acquire);
+		return tail.load(std::memory_order_acquire) - h;
+	}
+
+	size_t capacity() const {
+		return slotCount;
+	}
+
+private:
+	struct Slot {
+		//The index of the push that may fill the slot, or that index + 1 once it holds the item
+		std::atomic<size_t> sequence;
+		T item;
+	};
+
+	std::unique_ptr<Slot[]> slots;
+	size_t slotCount;
+	size_t mask;
+
+	//The padding keeps the consumer and producer indices on separate cache lines.
+	//(alignas would do the same, but heap allocations aren't guaranteed to honour it before C++17.)
+	char padding0[64];
+	//Consumer side
+	std::atomic<size_t> head;
+	char padding1[64];
+	//Producer side
+	std::atomic<size_t> tail;
+	char padding2[64];
+
+	//Claims the item at head and reads it, then frees its slot for the push one lap later
+	bool take(T &item) {
+		size_t h = head.load(std::memory_order_relaxed);
+		for (;;) {
+			Slot &slot = slots[h & mask];
+			size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			ptrdiff_t filled = static_cast<ptrdiff_t>(sequence - (h + 1));
+			if (filled < 0) {
+				//Not pushed yet
+				return false;
+			}
+			if (filled > 0) {
+				//The other side took this item and may have freed the slot already
+				h = head.load(std::memory_order_relaxed);
+				continue;
+			}
+			//On failure h is reloaded, and the next item is tried
+			if (head.compare_exchange_weak(h, h + 1, std::memory_order_relaxed)) {
+				item = slot.item;
+				slot.sequence.store(h + slotCount, std::memory_order_release);
+				return true;
+			}
+		}
+	}
+
+	SpscQueue(const SpscQueue&);
+	SpscQueue& operator=(const SpscQueue&);
+};
@@ -0,0 +1,251 @@
+#include "FrameAssembler.h"
+#include <algorithm>
+#include <cstring>
+#include "QuaternionBatch.h"
+
+using namespace std;
+using namespace myo;
+
+namespace {
+
+//Most samples a history keeps, should a stream run far ahead of the others
+const size_t maxHistory = 4096;
+
+uint64_t roundUp(uint64_t time, uint64_t tick) {
+	return (time + tick - 1) / tick * tick;
+}
+
+}
+
+FrameAssembler::Sample& FrameAssembler::History::insert(uint64_t timestamp) {
+	if (count == maxHistory) {
+		pop();
+	}
+	if (count == ring.size()) {
+		vector<Sample> grown(max<size_t>(16, ring.size() * 2));
+		for (size_t i = 0; i < count; i++) {
+			grown[i] = at(i);
+		}
+		ring.swap(grown);
+		head = 0;
+	}
+	//Timestamps of one stream are nearly always in order, so this rarely moves anything
+	size_t i = count++;
+	while (i > 0 && slot(i - 1).timestamp > timestamp) {
+		slot(i) = slot(i - 1);
+		i--;
+	}
+	Sample &sample = slot(i);
+	sample.timestamp = timestamp;
+	return sample;
+}
+
+FrameAssembler::FrameAssembler(const vector<Myo*> &myos, uint64_t tickUs, int interpolation, uint64_t maxGapUs, void *frame) :
+	devices(myos), histories(myos.size() * streamCount), tick(max<uint64_t>(1, tickUs)), interpolation(interpolation),
+	maxGap(maxGapUs), frame(static_cast<unsigned char*>(frame)), started(false), nextTick(0), newestTimestamp(0), skippedTicks(0) {
+}
+
+int FrameAssembler::deviceIndex(Myo *myo) const {
+	auto it = find(devices.begin(), devices.end(), myo);
+	return it != devices.end() ? static_cast<int>(it - devices.begin()) : -1;
+}
+
+void FrameAssembler::addImu(Myo *myo, uint64_t timestamp, const float *imu) {
+	int device = deviceIndex(myo);
+	if (device < 0) {
+		return;
+	}
+	Sample &sample = history(device, streamImu).insert(timestamp);
+	memcpy(sample.values, imu, imuValues * sizeof(float));
+	added(timestamp);
+}
+
+void FrameAssembler::addEmg(Myo *myo, uint64_t timestamp, const int8_t *emg) {
+	int device = deviceIndex(myo);
+	if (device < 0) {
+		return;
+	}
+	Sample &sample = history(device, streamEmg).insert(timestamp);
+	for (size_t i = 0; i < emgValues; i++) {
+		sample.values[i] = emg[i];
+	}
+	added(timestamp);
+}
+
+void FrameAssembler::forget(Myo *myo) {
+	int device = deviceIndex(myo);
+	if (device < 0) {
+		return;
+	}
+	for (int stream = 0; stream < streamCount; stream++) {
+		history(device, stream).clear();
+	}
+}
+
+void FrameAssembler::added(uint64_t timestamp) {
+	if (!started) {
+		started = true;
+		nextTick = roundUp(timestamp, tick);
+		newestTimestamp = timestamp;
+		return;
+	}
+	newestTimestamp = max(newestTimestamp, timestamp);
+}
+
+bool FrameAssembler::due(uint64_t time) {
+	if (newestTimestamp < time) {
+		return false;
+	}
+	if (newestTimestamp - time > maxGap) {
+		return true;
+	}
+	for (const History &h : histories) {
+		if (h.size() == 0) {
+			continue;
+		}
+		uint64_t latest = h.newest().timestamp;
+		//Inactive streams don't hold anything back
+		if (newestTimestamp - latest > maxGap) {
+			continue;
+		}
+		if (latest < time) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FrameAssembler::hasDataNear(uint64_t time) {
+	for (const History &h : histories) {
+		for (size_t i = 0; i < h.size(); i++) {
+			uint64_t t = h.at(i).timestamp;
+			if (t + maxGap >= time && t <= time + maxGap) {
+				return true;
+			}
+			if (t > time) {
+				break;
+			}
+		}
+	}
+	return false;
+}
+
+bool FrameAssembler::valuesAt(const History &h, int stream, uint64_t time, float *out) const {
+	const Sample *before = nullptr;
+	const Sample *after = nullptr;
+	for (size_t i = 0; i < h.size(); i++) {
+		const Sample &sample = h.at(i);
+		if (sample.timestamp <= time) {
+			before = &sample;
+		}
+		if (sample.timestamp >= time) {
+			after = &sample;
+			break;
+		}
+	}
+	if (before && time - before->timestamp > maxGap) {
+		before = nullptr;
+	}
+	if (after && after->timestamp - time > maxGap) {
+		after = nullptr;
+	}
+	if (!before && !after) {
+		return false;
+	}
+
+	size_t count = stream == streamImu ? imuValues : emgValues;
+	if (interpolation == linear && before && after && before != after) {
+		float t = static_cast<float>(time - before->timestamp) / (after->timestamp - before->timestamp);
+		size_t first = 0;
+		if (stream == streamImu) {
+			//The orientation goes through slerp, with the same kernel as the batch operations
+			float *o = out;
+			QuaternionArrays<float> from = { const_cast<float*>(before->values), const_cast<float*>(before->values) + 1,
+				const_cast<float*>(before->values) + 2, const_cast<float*>(before->values) + 3 };
+			QuaternionArrays<float> to = { const_cast<float*>(after->values), const_cast<float*>(after->values) + 1,
+				const_cast<float*>(after->values) + 2, const_cast<float*>(after->values) + 3 };
+			QuaternionArrays<float> result = { o, o + 1, o + 2, o + 3 };
+			slerpBatch<float>(from, to, &t, result, 1);
+			first = 4;
+		}
+		for (size_t i = first; i < count; i++) {
+			out[i] = before->values[i] + t * (after->values[i] - before->values[i]);
+		}
+		return true;
+	}
+
+	const Sample *nearestSample = before;
+	if (!before || (after && after->timestamp - time < time - before->timestamp)) {
+		nearestSample = after;
+	}
+	memcpy(out, nearestSample->values, count * sizeof(float));
+	return true;
+}
+
+void FrameAssembler::assemble(uint64_t time) {
+	SyncFrameHeader *header = reinterpret_cast<SyncFrameHeader*>(frame);
+	header->timestamp = time;
+	header->deviceCount = static_cast<uint32_t>(devices.size());
+	header->skippedTicks = skippedTicks;
+	skippedTicks = 0;
+
+	SyncFrameDevice *blocks = reinterpret_cast<SyncFrameDevice*>(frame + sizeof(SyncFrameHeader));
+	for (size_t device = 0; device < devices.size(); device++) {
+		SyncFrameDevice &block = blocks[device];
+		block.flags = 0;
+		block.reserved = 0;
+		if (valuesAt(history(device, streamImu), streamImu, time, block.imu)) {
+			block.flags |= SyncFrameDevice::imuValid;
+		}
+		else {
+			//Identity orientation and no motion
+			memset(block.imu, 0, sizeof(block.imu));
+			block.imu[3] = 1;
+		}
+		if (valuesAt(history(device, streamEmg), streamEmg, time, block.emg)) {
+			block.flags |= SyncFrameDevice::emgValid;
+		}
+		else {
+			memset(block.emg, 0, sizeof(block.emg));
+		}
+	}
+}
+
+void FrameAssembler::prune(uint64_t time) {
+	for (History &h : histories) {
+		//Keep the last sample at or before the time, which the next tick may interpolate from
+		while (h.size() >= 2 && h.at(1).timestamp <= time) {
+			h.pop();
+		}
+	}
+}
+
+bool FrameAssembler::next() {
+	if (!started) {
+		return false;
+	}
+	while (due(nextTick)) {
+		if (!hasDataNear(nextTick)) {
+			//Jump to the first tick that the oldest sample after this one is near
+			uint64_t earliest = UINT64_MAX;
+			for (const History &h : histories) {
+				for (size_t i = 0; i < h.size(); i++) {
+					if (h.at(i).timestamp > nextTick) {
+						earliest = min(earliest, h.at(i).timestamp);
+						break;
+					}
+				}
+			}
+			uint64_t resume = earliest == UINT64_MAX || earliest < maxGap ? 0 : roundUp(earliest - maxGap, tick);
+			resume = max(resume, nextTick + tick);
+			skippedTicks += static_cast<uint32_t>((resume - nextTick) / tick);
+			nextTick = resume;
+			continue;
+		}
+		assemble(nextTick);
+		nextTick += tick;
+		prune(nextTick);
+		return true;
+	}
+	return false;
+}
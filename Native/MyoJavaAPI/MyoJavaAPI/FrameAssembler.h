@@ -0,0 +1,159 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <myo/myo.hpp>
+#include "com_thalmic_myo_FrameAssembler.h"
+
+/*
+ * The layout of a synchronized frame: a header, then one block per Myo in the order the assembler was given them.
+ * See SyncFrame.java for the reading side; the offsets there have to match these structs.
+ */
+struct SyncFrameHeader {
+	//Time of the tick, in microseconds
+	uint64_t timestamp;
+	uint32_t deviceCount;
+	//Ticks skipped since the previous frame because no Myo had data near them
+	uint32_t skippedTicks;
+};
+
+struct SyncFrameDevice {
+	enum Flags {
+		imuValid = 1 << 0,
+		emgValid = 1 << 1
+	};
+
+	uint32_t flags;
+	uint32_t reserved;
+	//Orientation x, y, z, w, then accelerometer x, y, z, then gyroscope x, y, z, as in MyoEvent
+	float imu[10];
+	float emg[8];
+};
+
+static_assert(sizeof(SyncFrameHeader) == 16, "SyncFrameHeader must match the layout in SyncFrame.java");
+static_assert(sizeof(SyncFrameDevice) == 80, "SyncFrameDevice must match the layout in SyncFrame.java");
+
+/*
+ * Puts the IMU and EMG samples of several Myos onto one timeline, as a frame per tick.
+ *
+ * Ticks are the multiples of the tick length, so the frames of any two assemblers with the same tick line up. For
+ * every tick, each Myo's IMU and EMG values are taken from the samples around the tick: the nearest one, or a linear
+ * interpolation between the samples on either side (slerp for the orientation). Only samples within maxGap of the
+ * tick count; if there are none, the values of that stream are flagged as missing in the frame, which is how gaps
+ * show up.
+ *
+ * Samples of different Myos arrive interleaved and with jittered timestamps, so a tick is only assembled once every
+ * stream that is still active has a sample at or after it, or once the newest sample of any stream is more than
+ * maxGap past it. A stream is active while its newest sample is within maxGap of the newest sample overall, so a
+ * Myo that stops sending, or a Myo without EMG streaming, holds frames back by at most maxGap. Ticks that no stream
+ * has data near, such as while every Myo is disconnected, are skipped and counted instead of assembled.
+ *
+ * Samples are kept in rings that grow to the number of samples in flight and are reused after that, so assembling
+ * does not allocate once it is running. The assembler is used from the thread that dispatches events only.
+ */
+class FrameAssembler {
+
+public:
+	enum Interpolation {
+		nearest = com_thalmic_myo_FrameAssembler_INTERPOLATION_NEAREST,
+		linear = com_thalmic_myo_FrameAssembler_INTERPOLATION_LINEAR
+	};
+
+	static const size_t imuValues = 10;
+	static const size_t emgValues = 8;
+
+	//frame must have room for frameSize(myos.size()) bytes, and stay valid as long as the assembler.
+	FrameAssembler(const std::vector<myo::Myo*> &myos, uint64_t tickUs, int interpolation, uint64_t maxGapUs, void *frame);
+
+	static size_t frameSize(size_t devices) {
+		return sizeof(SyncFrameHeader) + devices * sizeof(SyncFrameDevice);
+	}
+	const std::vector<myo::Myo*>& myos() const {
+		return devices;
+	}
+
+	//Samples of Myos that are not part of the frame are ignored.
+	void addImu(myo::Myo *myo, uint64_t timestamp, const float *imu);
+	void addEmg(myo::Myo *myo, uint64_t timestamp, const int8_t *emg);
+	//Drops the samples of the Myo, so that nothing is interpolated across a disconnect.
+	void forget(myo::Myo *myo);
+
+	//Assembles the next due tick into the frame. Returns false, leaving the frame alone, if no tick is due yet.
+	//Call this after adding samples until it returns false.
+	bool next();
+
+private:
+	struct Sample {
+		uint64_t timestamp;
+		float values[imuValues];
+	};
+
+	//Samples of one stream of one Myo, oldest first
+	class History {
+	public:
+		History() : head(0), count(0) {
+		}
+		size_t size() const {
+			return count;
+		}
+		const Sample& at(size_t i) const {
+			return ring[(head + i) % ring.size()];
+		}
+		const Sample& newest() const {
+			return at(count - 1);
+		}
+		//Returns a slot at the right place for the timestamp, which is usually the end.
+		Sample& insert(uint64_t timestamp);
+		//Drops the oldest sample.
+		void pop() {
+			head = (head + 1) % ring.size();
+			count--;
+		}
+		void clear() {
+			count = 0;
+		}
+
+	private:
+		std::vector<Sample> ring;
+		size_t head;
+		size_t count;
+
+		Sample& slot(size_t i) {
+			return ring[(head + i) % ring.size()];
+		}
+	};
+
+	enum Stream {
+		streamImu,
+		streamEmg,
+		streamCount
+	};
+
+	std::vector<myo::Myo*> devices;
+	//streamCount histories per device
+	std::vector<History> histories;
+	uint64_t tick;
+	int interpolation;
+	uint64_t maxGap;
+	unsigned char *frame;
+
+	bool started;
+	uint64_t nextTick;
+	uint64_t newestTimestamp;
+	uint32_t skippedTicks;
+
+	int deviceIndex(myo::Myo *myo) const;
+	History& history(size_t device, int stream) {
+		return histories[device * streamCount + stream];
+	}
+	void added(uint64_t timestamp);
+	//Whether the tick can be assembled already
+	bool due(uint64_t time);
+	//Whether any stream has a sample within maxGap of the time
+	bool hasDataNear(uint64_t time);
+	//Writes the values of a stream at the time to out; returns false if there are no samples near enough.
+	bool valuesAt(const History &history, int stream, uint64_t time, float *out) const;
+	void assemble(uint64_t time);
+	//Drops the samples that no tick from time on can use anymore.
+	void prune(uint64_t time);
+};
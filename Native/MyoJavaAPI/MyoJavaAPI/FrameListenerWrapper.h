@@ -0,0 +1,90 @@
+#pragma once
+#include <jni.h>
+#include <vector>
+#include <myo/myo.hpp>
+#include "JNICache.h"
+#include "MyoEvent.h"
+#include "FrameAssembler.h"
+
+/*
+ * The native side of a Java FrameListener.
+ *
+ * Feeds the IMU and EMG events of the Myos of its FrameAssembler into the assembler, and calls the Java listener
+ * once for every frame it assembles. The frame is written straight into the direct buffer of the Java SyncFrame
+ * passed to the listener, so an upcall carries the data of every Myo without creating any Java object. Like a
+ * ListenerWrapper, it belongs to no particular hub; it is registered for the Myos of its assembler only.
+ */
+class FrameListenerWrapper : public EventListener {
+
+public:
+	FrameAssembler assembler;
+
+	FrameListenerWrapper(JNIEnv *env, jobject listener, jobject frame, void *frameAddress, const std::vector<myo::Myo*> &myos,
+		uint64_t tickUs, int interpolation, uint64_t maxGapUs) :
+		assembler(myos, tickUs, interpolation, maxGapUs, frameAddress) {
+
+		jlistener = env->NewGlobalRef(listener);
+		jframe = env->NewGlobalRef(frame);
+		if (!jlistener || !jframe) {
+			THROW_JNI_EXCEPTION(env, "Failed to make global reference for object; JVM is out of memory");
+			return;
+		}
+		jclass listenerClass = env->GetObjectClass(listener);
+		onFrameMid = env->GetMethodID(listenerClass, "onFrame", "(Lcom/thalmic/myo/SyncFrame;)V");
+		env->DeleteLocalRef(listenerClass);
+	}
+
+	~FrameListenerWrapper() {
+		JNIEnv *env = jniCache.getJNIEnv();
+		if (jframe) {
+			env->DeleteGlobalRef(jframe);
+		}
+		if (jlistener) {
+			env->DeleteGlobalRef(jlistener);
+		}
+	}
+
+	//Samples go into the assembler; disconnects and unpairs keep it from interpolating across the gap.
+	uint32_t eventMask() const override {
+		return eventBit(libmyo_event_orientation) | eventBit(libmyo_event_emg) |
+			eventBit(libmyo_event_disconnected) | eventBit(libmyo_event_unpaired);
+	}
+
+	void onImuData(myo::Myo *myo, uint64_t timestamp, const float *imu) override {
+		assembler.addImu(myo, timestamp, imu);
+		deliver();
+	}
+
+	void onEmgData(myo::Myo *myo, uint64_t timestamp, const int8_t *emg) override {
+		assembler.addEmg(myo, timestamp, emg);
+		deliver();
+	}
+
+	void onDisconnect(myo::Myo *myo, uint64_t timestamp) override {
+		assembler.forget(myo);
+	}
+
+	void onUnpair(myo::Myo *myo, uint64_t timestamp) override {
+		assembler.forget(myo);
+	}
+
+private:
+	jobject jlistener;
+	jobject jframe;
+	jmethodID onFrameMid;
+
+	void deliver() {
+		JNIEnv *env = nullptr;
+		while (assembler.next()) {
+			if (!env) {
+				env = jniCache.getJNIEnv();
+			}
+			env->CallVoidMethod(jlistener, onFrameMid, jframe);
+			//Several frames may be delivered in a row, which JNI doesn't allow with an exception pending
+			JNI_CHECK_EXCEPT(env);
+		}
+	}
+
+	FrameListenerWrapper(const FrameListenerWrapper&);
+	FrameListenerWrapper& operator=(const FrameListenerWrapper&);
+};
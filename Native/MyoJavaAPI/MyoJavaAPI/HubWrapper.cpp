@@ -0,0 +1,381 @@
+#include "HubWrapper.h"
+#include <stdexcept>
+
+using namespace std;
+using namespace myo;
+
+HubWrapper::HubWrapper(const string &applicationIdentifier) : Hub(applicationIdentifier), peers(&processing), clockStarted(false),
+	clockTimestamp(0), recording(false),
+	pumpRunning(false), consumerWaiting(false), droppedCount(0) {
+}
+
+HubWrapper::~HubWrapper() {
+	//The pump thread has to be gone before Hub shuts down the libmyo hub
+	stopAsync();
+	stopRecording();
+}
+
+void HubWrapper::release(JNIEnv *env) {
+	stopAsync();
+	stopRecording();
+	peers.releaseAll(env);
+}
+
+bool HubWrapper::decode(libmyo_event_t event, MyoEvent &decoded) {
+	libmyo_myo_t opaqueMyo = libmyo_event_get_myo(event);
+	Myo *myo = lookupMyo(opaqueMyo);
+	if (!myo && libmyo_event_get_type(event) == libmyo_event_paired) {
+		myo = addMyo(opaqueMyo);
+	}
+	if (!myo) {
+		//Ignore events for Myos we don't know about, like Hub::onDeviceEvent() does
+		return false;
+	}
+	decodeEvent(event, myo, decoded);
+	if (decoded.type == libmyo_event_unpaired) {
+		//Listeners still get the Myo for this event; later events of the handle are ignored until it pairs again
+		retireMyo(opaqueMyo);
+	}
+
+	//Logs keep the raw orientation, so they are written before smoothing
+	if (recording.load(memory_order_acquire)) {
+		lock_guard<mutex> lock(recorderMutex);
+		if (recorder) {
+			recorder->record(decoded, event);
+		}
+	}
+	processing.smooth(decoded);
+	processing.history.record(decoded);
+
+	//The map is only changed by this thread, so it can be read without the lock here.
+	//Myos found by waitForMyo() don't have a block yet, so it is created on their first event instead of on pairing.
+	auto it = stateBlocks.find(myo);
+	if (it == stateBlocks.end()) {
+		lock_guard<mutex> lock(stateMutex);
+		it = stateBlocks.emplace(myo, unique_ptr<MyoStateBlock>(new MyoStateBlock())).first;
+	}
+	it->second->update(decoded);
+	return true;
+}
+
+void HubWrapper::startRecording(const string &path) {
+	stopRecording();
+	unique_ptr<SessionRecorder> newRecorder(new SessionRecorder(path));
+	lock_guard<mutex> lock(recorderMutex);
+	recorder = move(newRecorder);
+	recording.store(true, memory_order_release);
+}
+
+string HubWrapper::stopRecording() {
+	lock_guard<mutex> lock(recorderMutex);
+	if (!recording.load(memory_order_relaxed)) {
+		return string();
+	}
+	recording.store(false, memory_order_release);
+	//The recorder is kept around for its counters until the next recording starts
+	return recorder->stop();
+}
+
+uint64_t HubWrapper::droppedRecordEvents() {
+	lock_guard<mutex> lock(recorderMutex);
+	return recorder ? recorder->droppedEvents() : 0;
+}
+
+MyoStateBlock* HubWrapper::getState(Myo *myo) {
+	lock_guard<mutex> lock(stateMutex);
+	auto it = stateBlocks.find(myo);
+	return it != stateBlocks.end() ? it->second.get() : nullptr;
+}
+
+void HubWrapper::dispatch(JNIEnv *env, const MyoEvent &event) {
+	processing.dispatch(event, dispatcher);
+	if (event.type == libmyo_event_unpaired) {
+		peers.release(env, event.myo());
+	}
+	//Events of different Myos aren't always in timestamp order, so the clock only moves forward
+	if (!clockStarted || event.timestamp > clockTimestamp) {
+		clockStarted = true;
+		clockTimestamp = event.timestamp;
+		clockTime = chrono::steady_clock::now();
+	}
+	dispatcher.tick(clockTimestamp);
+}
+
+void HubWrapper::tick() {
+	if (!clockStarted) {
+		return;
+	}
+	uint64_t elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - clockTime).count();
+	dispatcher.tick(clockTimestamp + elapsed);
+}
+
+void HubWrapper::run(JNIEnv *env, unsigned int duration_ms) {
+	if (isAsync()) {
+		auto deadline = chrono::steady_clock::now() + chrono::milliseconds(duration_ms);
+		MyoEvent event;
+		while (waitForEvents(deadline)) {
+			while (queue->pop(event)) {
+				dispatch(env, event);
+			}
+		}
+		tick();
+		return;
+	}
+
+	struct local {
+		static libmyo_handler_result_t handler(void* user_data, libmyo_event_t event) {
+			RunContext *context = static_cast<RunContext*>(user_data);
+
+			MyoEvent decoded;
+			if (context->hub->decode(event, decoded)) {
+				context->hub->dispatch(context->env, decoded);
+			}
+
+			return libmyo_handler_continue;
+		}
+	};
+	RunContext context = { this, env };
+	libmyo_run(_hub, duration_ms, &local::handler, &context, ThrowOnError());
+	tick();
+}
+
+void HubWrapper::runOnce(JNIEnv *env, unsigned int duration_ms) {
+	if (isAsync()) {
+		MyoEvent event;
+		if (waitForEvents(chrono::steady_clock::now() + chrono::milliseconds(duration_ms)) && queue->pop(event)) {
+			dispatch(env, event);
+		}
+		tick();
+		return;
+	}
+
+	struct local {
+		static libmyo_handler_result_t handler(void* user_data, libmyo_event_t event) {
+			RunContext *context = static_cast<RunContext*>(user_data);
+
+			MyoEvent decoded;
+			if (context->hub->decode(event, decoded)) {
+				context->hub->dispatch(context->env, decoded);
+			}
+
+			return libmyo_handler_stop;
+		}
+	};
+	RunContext context = { this, env };
+	libmyo_run(_hub, duration_ms, &local::handler, &context, ThrowOnError());
+	tick();
+}
+
+HubWrapper::QueueCounters::QueueCounters() {
+	for (int i = 0; i < numEventTypes; i++) {
+		enqueued[i] = 0;
+		dropped[i] = 0;
+		coalesced[i] = 0;
+	}
+}
+
+void HubWrapper::startAsync(size_t queueCapacity, OverflowPolicy policy) {
+	if (isAsync()) {
+		return;
+	}
+	queue.reset(new SpscQueue<MyoEvent>(queueCapacity));
+	overflowPolicy = policy;
+	pendingEvents.clear();
+	{
+		lock_guard<mutex> lock(countersMutex);
+		queueCounters.clear();
+	}
+	droppedCount = 0;
+	pumpError.clear();
+	pumpRunning = true;
+	pumpThread = thread(&HubWrapper::pump, this);
+}
+
+void HubWrapper::stopAsync() {
+	if (!isAsync()) {
+		return;
+	}
+	pumpRunning = false;
+	pumpThread.join();
+	queue.reset();
+}
+
+void HubWrapper::pump() {
+	struct local {
+		static libmyo_handler_result_t handler(void* user_data, libmyo_event_t event) {
+			HubWrapper *hub = static_cast<HubWrapper*>(user_data);
+
+			MyoEvent decoded;
+			if (hub->decode(event, decoded)) {
+				hub->enqueue(decoded);
+			}
+
+			return hub->pumpRunning.load(memory_order_relaxed) ? libmyo_handler_continue : libmyo_handler_stop;
+		}
+	};
+
+	try {
+		//Short slices so that stopAsync() never has to wait long for the thread to notice
+		while (pumpRunning) {
+			libmyo_run(_hub, 100, &local::handler, this, ThrowOnError());
+			//Coalesced events shouldn't have to wait for the next event to arrive
+			flushPendingEvents();
+		}
+	}
+	catch (exception &e) {
+		lock_guard<mutex> lock(waitMutex);
+		pumpError = e.what();
+	}
+	lock_guard<mutex> lock(waitMutex);
+	pumpRunning = false;
+	waitCondition.notify_one();
+}
+
+HubWrapper::QueueCounters& HubWrapper::countersFor(Myo *myo) {
+	auto it = queueCounters.find(myo);
+	if (it != queueCounters.end()) {
+		return it->second;
+	}
+	lock_guard<mutex> lock(countersMutex);
+	return queueCounters[myo];
+}
+
+void HubWrapper::notifyConsumer() {
+	//Pairs with the fence in waitForEvents(): either the consumer sees the new event,
+	//or we see that it is waiting and wake it up
+	atomic_thread_fence(memory_order_seq_cst);
+	if (consumerWaiting.load(memory_order_relaxed)) {
+		lock_guard<mutex> lock(waitMutex);
+		waitCondition.notify_one();
+	}
+}
+
+void HubWrapper::enqueueBlocking(const MyoEvent &event) {
+	while (!queue->push(event)) {
+		if (!pumpRunning) {
+			//Stopping; nobody is going to make room any more
+			countersFor(event.myo()).dropped[event.type].fetch_add(1, memory_order_relaxed);
+			droppedCount.fetch_add(1, memory_order_relaxed);
+			return;
+		}
+		notifyConsumer();
+		this_thread::sleep_for(chrono::microseconds(100));
+	}
+	countersFor(event.myo()).enqueued[event.type].fetch_add(1, memory_order_relaxed);
+	notifyConsumer();
+}
+
+bool HubWrapper::flushPendingEvents() {
+	size_t flushed = 0;
+	while (flushed < pendingEvents.size() && queue->push(pendingEvents[flushed])) {
+		const MyoEvent &event = pendingEvents[flushed++];
+		countersFor(event.myo()).enqueued[event.type].fetch_add(1, memory_order_relaxed);
+	}
+	if (flushed > 0) {
+		pendingEvents.erase(pendingEvents.begin(), pendingEvents.begin() + flushed);
+		notifyConsumer();
+	}
+	return pendingEvents.empty();
+}
+
+void HubWrapper::enqueue(const MyoEvent &event) {
+	QueueCounters &counters = countersFor(event.myo());
+
+	switch (overflowPolicy) {
+	case overflowBlock:
+		enqueueBlocking(event);
+		return;
+
+	case overflowDropNewest:
+		if (queue->push(event)) {
+			counters.enqueued[event.type].fetch_add(1, memory_order_relaxed);
+			notifyConsumer();
+		}
+		else {
+			counters.dropped[event.type].fetch_add(1, memory_order_relaxed);
+			droppedCount.fetch_add(1, memory_order_relaxed);
+		}
+		return;
+
+	case overflowDropOldest:
+		//discardOldest() only discards from a full queue; otherwise the consumer is just done reading a slot
+		while (!queue->push(event)) {
+			MyoEvent oldest;
+			if (queue->discardOldest(oldest)) {
+				countersFor(oldest.myo()).dropped[oldest.type].fetch_add(1, memory_order_relaxed);
+				droppedCount.fetch_add(1, memory_order_relaxed);
+			}
+		}
+		counters.enqueued[event.type].fetch_add(1, memory_order_relaxed);
+		notifyConsumer();
+		return;
+
+	case overflowCoalesce:
+		//Pending events go first, so that events of a Myo stay in order
+		if (flushPendingEvents() && queue->push(event)) {
+			counters.enqueued[event.type].fetch_add(1, memory_order_relaxed);
+			notifyConsumer();
+			return;
+		}
+		switch (event.type) {
+		case libmyo_event_orientation:
+		case libmyo_event_rssi:
+		case libmyo_event_battery_level:
+			for (MyoEvent &pending : pendingEvents) {
+				if (pending.myoAddress == event.myoAddress && pending.type == event.type) {
+					pending = event;
+					counters.coalesced[event.type].fetch_add(1, memory_order_relaxed);
+					return;
+				}
+			}
+			pendingEvents.push_back(event);
+			return;
+		case libmyo_event_emg:
+			counters.dropped[event.type].fetch_add(1, memory_order_relaxed);
+			droppedCount.fetch_add(1, memory_order_relaxed);
+			return;
+		default:
+			while (!flushPendingEvents() && pumpRunning) {
+				notifyConsumer();
+				this_thread::sleep_for(chrono::microseconds(100));
+			}
+			enqueueBlocking(event);
+			return;
+		}
+	}
+}
+
+bool HubWrapper::waitForEvents(chrono::steady_clock::time_point deadline) {
+	if (!queue->empty()) {
+		return true;
+	}
+	unique_lock<mutex> lock(waitMutex);
+	consumerWaiting.store(true, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	waitCondition.wait_until(lock, deadline, [this] {
+		return !queue->empty() || !pumpRunning;
+	});
+	consumerWaiting.store(false, memory_order_relaxed);
+
+	if (queue->empty() && !pumpError.empty()) {
+		throw runtime_error("Event pump stopped: " + pumpError);
+	}
+	return !queue->empty();
+}
+
+jint HubWrapper::poll(JNIEnv *env, MyoEvent *records, jobjectArray myos, jint capacity, unsigned int timeout_ms) {
+	if (capacity <= 0 || !waitForEvents(chrono::steady_clock::now() + chrono::milliseconds(timeout_ms))) {
+		return 0;
+	}
+	jint count = 0;
+	while (count < capacity && queue->pop(records[count])) {
+		Myo *myo = records[count].myo();
+		env->SetObjectArrayElement(myos, count, peers.get(env, myo));
+		if (records[count].type == libmyo_event_unpaired) {
+			//The array still holds on to the peer, so it stays valid for the caller
+			peers.release(env, myo);
+		}
+		count++;
+	}
+	return count;
+}
@@ -0,0 +1,196 @@
+#pragma once
+#include <jni.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <myo/myo.hpp>
+#include "MyoEvent.h"
+#include "EventQueue.h"
+#include "MyoState.h"
+#include "SessionRecorder.h"
+#include "MyoPeers.h"
+#include "EventDispatcher.h"
+#include "MyoProcessing.h"
+
+/*
+ * The native object behind a Java Hub.
+ *
+ * On top of the C++ Hub, this keeps the Java Myo object (the "peer") of each native Myo in peers. The peer of a Myo
+ * is dropped once the Myo is unpaired and when the Hub is released.
+ *
+ * Every event goes through processing on its way to the listeners, which smooths orientations, filters EMG frames
+ * and derives Euler angles from orientations (see MyoProcessing). Smoothing happens as the event is decoded.
+ *
+ * Every decoded event also updates the MyoStateBlock of its Myo, which Java can read at any time through a MyoState,
+ * and is written to the session log while recording (see startRecording()).
+ *
+ * Events are decoded into MyoEvents before they are dispatched to listeners. In async mode (see startAsync()) a
+ * native thread runs libmyo and pushes those events into a queue, and run(), runOnce() and poll() only ever read
+ * from that queue. Everything except the pump thread itself, including all JNI calls, happens on the thread that
+ * consumes the queue.
+ */
+class HubWrapper : public myo::Hub {
+
+public:
+	MyoProcessing processing;
+	MyoPeers peers;
+
+	HubWrapper(const std::string &applicationIdentifier);
+	~HubWrapper();
+
+	//The destructor of Hub can't release Java references, so release() has to be called before deleting.
+	void release(JNIEnv *env);
+
+	//Listeners are dispatched to as EventListeners, so these hide Hub::addListener() and Hub::removeListener() to
+	//only accept those. A listener only gets events of the types in its eventMask(), and of the given Myos if there
+	//are any (see EventDispatcher). Adding a listener again replaces its Myos.
+	//Events that Hub::waitForMyo() runs into go through Hub::onDeviceEvent(), which knows nothing of masks or Myos.
+	void addListener(EventListener *listener, const std::vector<myo::Myo*> &myos = std::vector<myo::Myo*>()) {
+		Hub::addListener(listener);
+		dispatcher.add(listener, myos);
+	}
+	void removeListener(EventListener *listener) {
+		Hub::removeListener(listener);
+		dispatcher.remove(listener);
+	}
+
+	//Hub::run() and Hub::runOnce() are not virtual, so these replace them instead of overriding them.
+	//They behave the same, except that the peer of an unpaired Myo is dropped after all listeners have seen the event.
+	//In async mode they dispatch events from the queue instead of running libmyo.
+	void run(JNIEnv *env, unsigned int duration_ms);
+	void runOnce(JNIEnv *env, unsigned int duration_ms);
+
+	//What the pump thread does with an event when the queue is full
+	enum OverflowPolicy {
+		//Wait for the consumer to make room
+		overflowBlock,
+		//Discard the oldest queued event
+		overflowDropOldest,
+		//Discard the new event
+		overflowDropNewest,
+		//Keep only the latest orientation, RSSI and battery level event of each Myo until there is room,
+		//discard EMG events, and wait for room for everything else
+		overflowCoalesce
+	};
+
+	//Counts of queued events by event type, for one Myo
+	struct QueueCounters {
+		std::atomic<uint64_t> enqueued[numEventTypes];
+		std::atomic<uint64_t> dropped[numEventTypes];
+		std::atomic<uint64_t> coalesced[numEventTypes];
+
+		QueueCounters();
+	};
+
+	//Starts the pump thread. Does nothing if it is already running.
+	void startAsync(size_t queueCapacity, OverflowPolicy policy);
+	//Stops the pump thread. Events still in the queue are discarded.
+	void stopAsync();
+	bool isAsync() const {
+		return pumpThread.joinable();
+	}
+
+	//Copies up to capacity queued events into records, and their Myo peers into myos.
+	//Waits up to timeout_ms for the first event if the queue is empty. Returns the number of events copied.
+	jint poll(JNIEnv *env, MyoEvent *records, jobjectArray myos, jint capacity, unsigned int timeout_ms);
+
+	uint64_t droppedEvents() const {
+		return droppedCount.load(std::memory_order_relaxed);
+	}
+	size_t queuedEvents() const {
+		return queue ? queue->size() : 0;
+	}
+	size_t queueCapacity() const {
+		return queue ? queue->capacity() : 0;
+	}
+	//Returns the state block of the Myo, or nullptr if no event of the Myo has been seen yet. Can be called from any thread.
+	//Blocks stay allocated until the Hub is deleted.
+	MyoStateBlock* getState(myo::Myo *myo);
+
+	//Starts writing every event to a session log. Throws a runtime_error if the file can't be created.
+	//Any previous recording is stopped first. Can be called from any thread.
+	void startRecording(const std::string &path);
+	//Stops recording and closes the log. Returns the error that stopped the recording, or an empty string.
+	//Does nothing if not recording. Can be called from any thread.
+	std::string stopRecording();
+	bool isRecording() const {
+		return recording.load(std::memory_order_acquire);
+	}
+	//Number of events dropped by the current (or last) recording, because the log could not be written fast enough
+	uint64_t droppedRecordEvents();
+
+	//Calls f(Myo*, const QueueCounters&) for every Myo that has had events queued since async mode was started.
+	//Can be called from any thread.
+	template<typename F>
+	void forEachQueueCounters(F f) {
+		std::lock_guard<std::mutex> lock(countersMutex);
+		for (auto &entry : queueCounters) {
+			f(entry.first, entry.second);
+		}
+	}
+
+private:
+	struct RunContext {
+		HubWrapper *hub;
+		JNIEnv *env;
+	};
+
+	EventDispatcher dispatcher;
+
+	//The hub's clock for EventListener::onTick(): the newest dispatched timestamp, and when it was dispatched.
+	//Only used by the dispatching thread.
+	bool clockStarted;
+	uint64_t clockTimestamp;
+	std::chrono::steady_clock::time_point clockTime;
+
+	//Only the thread decoding events adds entries, and only while holding stateMutex
+	std::unordered_map<myo::Myo*, std::unique_ptr<MyoStateBlock>> stateBlocks;
+	std::mutex stateMutex;
+
+	//Held by the decoding thread while it records an event, which is only checked for while recording is set
+	std::unique_ptr<SessionRecorder> recorder;
+	std::mutex recorderMutex;
+	std::atomic<bool> recording;
+
+	std::unique_ptr<SpscQueue<MyoEvent>> queue;
+	OverflowPolicy overflowPolicy;
+	//Events of the coalesce policy waiting for room in the queue, oldest first. Only used by the pump thread.
+	std::vector<MyoEvent> pendingEvents;
+	//Only the pump thread adds entries, and only while holding countersMutex
+	std::unordered_map<myo::Myo*, QueueCounters> queueCounters;
+	std::mutex countersMutex;
+	std::thread pumpThread;
+	std::atomic<bool> pumpRunning;
+	std::atomic<bool> consumerWaiting;
+	std::atomic<uint64_t> droppedCount;
+	//Guards pumpError, and is held while notifying a waiting consumer
+	std::mutex waitMutex;
+	std::condition_variable waitCondition;
+	std::string pumpError;
+
+	//Looks up (or on pairing, adds) the Myo of the event and decodes it, then records, smooths and stores it in the
+	//state block of the Myo. Returns false for unknown Myos.
+	bool decode(libmyo_event_t event, MyoEvent &decoded);
+	void dispatch(JNIEnv *env, const MyoEvent &event);
+	//Ticks the listeners with the newest timestamp plus the time since it was dispatched, once there has been an
+	//event. Called when run() and runOnce() return, so that deadlines pass while no events arrive.
+	void tick();
+
+	void pump();
+	QueueCounters& countersFor(myo::Myo *myo);
+	//Pump thread only. These push an event into the queue according to the overflow policy.
+	void enqueue(const MyoEvent &event);
+	void enqueueBlocking(const MyoEvent &event);
+	void notifyConsumer();
+	//Moves as many pending events into the queue as there is room for. Returns true if none are left.
+	bool flushPendingEvents();
+	//Waits until there are queued events or the deadline passes. Returns false if the queue is still empty.
+	//Throws a runtime_error if the pump thread stopped because of an error.
+	bool waitForEvents(std::chrono::steady_clock::time_point deadline);
+};
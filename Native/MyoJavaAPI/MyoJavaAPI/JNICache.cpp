@@ -0,0 +1,148 @@
+#include "JNICache.h"
+#include <string>
+
+using namespace std;
+
+JNICache jniCache;
+
+JNIEnv* JNICache::getJNIEnv() {
+	JNIEnv *env;
+	int result = jvm->GetEnv((void **)&env, JNI_VERSION_1_8);
+	if (result == JNI_EDETACHED) {
+		result = jvm->AttachCurrentThread((void **)&env, nullptr);
+		if (result != JNI_OK) {
+			THROW_JNI_EXCEPTION(env, (string("Unexpected error: Cannot attach current thread: ") + to_string(result)).c_str());
+			return nullptr;
+		}
+	}
+	else if (result != JNI_OK) {
+		THROW_JNI_EXCEPTION(env, (string("Unexpected error: Cannot get JNI environment: ") + to_string(result)).c_str());
+		return nullptr;
+	}
+	return env;
+}
+
+//Returns a global reference to the class, or nullptr if it can't be found.
+static jclass findClass(JNIEnv *env, const char *name) {
+	jclass clazz = env->FindClass(name);
+	if (!clazz) {
+		return nullptr;
+	}
+	jclass ref = (jclass)env->NewGlobalRef(clazz);
+	env->DeleteLocalRef(clazz);
+	return ref;
+}
+
+//Returns a global reference to the enum constant with the given name.
+static jobject getEnumConstant(JNIEnv *env, const char *className, const char *name) {
+	jclass clazz = env->FindClass(className);
+	if (!clazz) {
+		return nullptr;
+	}
+	jfieldID fid = env->GetStaticFieldID(clazz, name, (string("L") + className + ";").c_str());
+	jobject constant = fid ? env->GetStaticObjectField(clazz, fid) : nullptr;
+	env->DeleteLocalRef(clazz);
+	if (!constant) {
+		return nullptr;
+	}
+	jobject ref = env->NewGlobalRef(constant);
+	env->DeleteLocalRef(constant);
+	return ref;
+}
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void * /*reserved*/) {
+	JNIEnv *env;
+	if (vm->GetEnv((void **)&env, JNI_VERSION_1_8) != JNI_OK) {
+		return JNI_ERR;
+	}
+	JNICache &c = jniCache;
+	c.jvm = vm;
+
+	c.myoClass = findClass(env, "com/thalmic/myo/Myo");
+	c.firmwareVersionClass = findClass(env, "com/thalmic/myo/FirmwareVersion");
+	c.quaternionClass = findClass(env, "com/thalmic/myo/Quaternion");
+	c.vector3Class = findClass(env, "com/thalmic/myo/Vector3");
+	c.bufferClass = findClass(env, "java/nio/Buffer");
+	jclass hubClass = env->FindClass("com/thalmic/myo/Hub");
+	jclass replayHubClass = env->FindClass("com/thalmic/myo/ReplayHub");
+	if (!c.myoClass || !c.firmwareVersionClass || !c.quaternionClass || !c.vector3Class || !c.bufferClass || !hubClass || !replayHubClass) {
+		return JNI_ERR;
+	}
+
+	c.myoConstructor = env->GetMethodID(c.myoClass, "<init>", "(JZJ)V");
+	c.firmwareVersionConstructor = env->GetMethodID(c.firmwareVersionClass, "<init>", "()V");
+	c.quaternionConstructor = env->GetMethodID(c.quaternionClass, "<init>", "(DDDD)V");
+	c.vector3Constructor = env->GetMethodID(c.vector3Class, "<init>", "(DDD)V");
+	c.bufferClearMid = env->GetMethodID(c.bufferClass, "clear", "()Ljava/nio/Buffer;");
+
+	c.hubPointerFid = env->GetFieldID(hubClass, "_nativePointer", "J");
+	c.replayHubPointerFid = env->GetFieldID(replayHubClass, "_nativePointer", "J");
+	c.myoPointerFid = env->GetFieldID(c.myoClass, "_nativePointer", "J");
+	c.myoProcessingFid = env->GetFieldID(c.myoClass, "_processingPointer", "J");
+	env->DeleteLocalRef(hubClass);
+	env->DeleteLocalRef(replayHubClass);
+
+	c.fvMajorFid = env->GetFieldID(c.firmwareVersionClass, "firmwareVersionMajor", "I");
+	c.fvMinorFid = env->GetFieldID(c.firmwareVersionClass, "firmwareVersionMinor", "I");
+	c.fvPatchFid = env->GetFieldID(c.firmwareVersionClass, "firmwareVersionPatch", "I");
+	c.fvHardwareRevFid = env->GetFieldID(c.firmwareVersionClass, "firmwareVersionHardwareRev", "I");
+
+	c.armEnums[libmyo_arm_right] = getEnumConstant(env, "com/thalmic/myo/Arm", "armRight");
+	c.armEnums[libmyo_arm_left] = getEnumConstant(env, "com/thalmic/myo/Arm", "armLeft");
+	c.armEnums[libmyo_arm_unknown] = getEnumConstant(env, "com/thalmic/myo/Arm", "armUnknown");
+
+	c.xDirectionEnums[libmyo_x_direction_toward_wrist] = getEnumConstant(env, "com/thalmic/myo/XDirection", "xDirectionTowardsWrist");
+	c.xDirectionEnums[libmyo_x_direction_toward_elbow] = getEnumConstant(env, "com/thalmic/myo/XDirection", "xDirectionTowardsElbow");
+	c.xDirectionEnums[libmyo_x_direction_unknown] = getEnumConstant(env, "com/thalmic/myo/XDirection", "xDirectionUnknown");
+
+	c.warmupStateEnums[libmyo_warmup_state_unknown] = getEnumConstant(env, "com/thalmic/myo/WarmupState", "warmupStateUnknown");
+	c.warmupStateEnums[libmyo_warmup_state_cold] = getEnumConstant(env, "com/thalmic/myo/WarmupState", "warmupStateCold");
+	c.warmupStateEnums[libmyo_warmup_state_warm] = getEnumConstant(env, "com/thalmic/myo/WarmupState", "warmupStateWarm");
+
+	c.warmupResultEnums[libmyo_warmup_result_unknown] = getEnumConstant(env, "com/thalmic/myo/WarmupResult", "warmupResultUnknown");
+	c.warmupResultEnums[libmyo_warmup_result_success] = getEnumConstant(env, "com/thalmic/myo/WarmupResult", "warmupResultSuccess");
+	c.warmupResultEnums[libmyo_warmup_result_failed_timeout] = getEnumConstant(env, "com/thalmic/myo/WarmupResult", "warmupResultFailedTimeout");
+
+	c.poseEnums[libmyo_pose_rest] = getEnumConstant(env, "com/thalmic/myo/Pose", "rest");
+	c.poseEnums[libmyo_pose_fist] = getEnumConstant(env, "com/thalmic/myo/Pose", "fist");
+	c.poseEnums[libmyo_pose_wave_in] = getEnumConstant(env, "com/thalmic/myo/Pose", "waveIn");
+	c.poseEnums[libmyo_pose_wave_out] = getEnumConstant(env, "com/thalmic/myo/Pose", "waveOut");
+	c.poseEnums[libmyo_pose_fingers_spread] = getEnumConstant(env, "com/thalmic/myo/Pose", "fingersSpread");
+	c.poseEnums[libmyo_pose_double_tap] = getEnumConstant(env, "com/thalmic/myo/Pose", "doubleTap");
+	c.poseUnknownEnum = getEnumConstant(env, "com/thalmic/myo/Pose", "unknown");
+
+	//Any failed lookup above leaves a pending exception (NoSuchFieldError, NoSuchMethodError, ...)
+	if (env->ExceptionCheck() == JNI_TRUE) {
+		return JNI_ERR;
+	}
+	return JNI_VERSION_1_8;
+}
+
+JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void * /*reserved*/) {
+	JNIEnv *env;
+	if (vm->GetEnv((void **)&env, JNI_VERSION_1_8) != JNI_OK) {
+		return;
+	}
+	JNICache &c = jniCache;
+
+	jobject refs[] = { c.myoClass, c.firmwareVersionClass, c.quaternionClass, c.vector3Class, c.bufferClass, c.poseUnknownEnum };
+	for (jobject ref : refs) {
+		if (ref)
+			env->DeleteGlobalRef(ref);
+	}
+	for (int i = 0; i < 3; i++) {
+		if (c.armEnums[i])
+			env->DeleteGlobalRef(c.armEnums[i]);
+		if (c.xDirectionEnums[i])
+			env->DeleteGlobalRef(c.xDirectionEnums[i]);
+		if (c.warmupStateEnums[i])
+			env->DeleteGlobalRef(c.warmupStateEnums[i]);
+		if (c.warmupResultEnums[i])
+			env->DeleteGlobalRef(c.warmupResultEnums[i]);
+	}
+	for (jobject ref : c.poseEnums) {
+		if (ref)
+			env->DeleteGlobalRef(ref);
+	}
+	c = JNICache();
+}
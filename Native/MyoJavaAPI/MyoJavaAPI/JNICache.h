@@ -0,0 +1,86 @@
+#pragma once
+#include <jni.h>
+#include <cstddef>
+#include <myo/libmyo.h>
+
+#define JNI_CHECK_EXCEPT(env) if(env->ExceptionCheck() == JNI_TRUE) { env->ExceptionDescribe(); }
+#define THROW_JNI_EXCEPTION(env, message) env->ThrowNew(env->FindClass("com/thalmic/myo/JNIException"), message)
+
+/*
+ * Classes, method IDs, field IDs and enum constants used by the native code.
+ *
+ * Everything in here is resolved once in JNI_OnLoad and shared by all Hubs, Myos and listeners, so native methods
+ * and callbacks never have to look anything up by name. Classes and enum constants are global references, which
+ * are released again in JNI_OnUnload.
+ */
+struct JNICache {
+	JavaVM *jvm;
+
+	jclass myoClass, firmwareVersionClass, quaternionClass, vector3Class, bufferClass;
+
+	jmethodID myoConstructor, firmwareVersionConstructor, quaternionConstructor, vector3Constructor;
+	jmethodID bufferClearMid;
+
+	jfieldID hubPointerFid, replayHubPointerFid, myoPointerFid, myoProcessingFid;
+	jfieldID fvMajorFid, fvMinorFid, fvPatchFid, fvHardwareRevFid;
+
+	//Java enum constants, indexed by the corresponding libmyo enum value.
+	//The unknown constant of each enum is also used for any value outside of the table.
+	jobject armEnums[3];
+	jobject xDirectionEnums[3];
+	jobject warmupStateEnums[3];
+	jobject warmupResultEnums[3];
+	jobject poseEnums[libmyo_num_poses];
+	jobject poseUnknownEnum;
+
+	//Returns the JNI environment of the current thread, attaching the thread to the JVM if needed.
+	JNIEnv* getJNIEnv();
+
+	jobject arm(int value) {
+		return lookupEnum(armEnums, 3, value, armEnums[libmyo_arm_unknown]);
+	}
+	jobject xDirection(int value) {
+		return lookupEnum(xDirectionEnums, 3, value, xDirectionEnums[libmyo_x_direction_unknown]);
+	}
+	jobject warmupState(int value) {
+		return lookupEnum(warmupStateEnums, 3, value, warmupStateEnums[libmyo_warmup_state_unknown]);
+	}
+	jobject warmupResult(int value) {
+		return lookupEnum(warmupResultEnums, 3, value, warmupResultEnums[libmyo_warmup_result_unknown]);
+	}
+	jobject pose(int value) {
+		return lookupEnum(poseEnums, libmyo_num_poses, value, poseUnknownEnum);
+	}
+
+private:
+	static jobject lookupEnum(jobject *table, size_t size, int value, jobject unknown) {
+		return value >= 0 && static_cast<size_t>(value) < size ? table[value] : unknown;
+	}
+};
+
+extern JNICache jniCache;
+
+/*
+ * Pushes a local reference frame for as long as it is in scope.
+ *
+ * All listener callbacks of a Hub.run() call happen inside that one native method, so any local reference created
+ * while dispatching an event would otherwise stay alive until run() returns. Every callback opens one of these, which
+ * frees its local references as soon as the callback is done.
+ */
+class LocalFrame {
+public:
+	LocalFrame(JNIEnv *env, jint capacity = 16) : env(env), pushed(env->PushLocalFrame(capacity) == 0) {
+	}
+	~LocalFrame() {
+		if (pushed) {
+			env->PopLocalFrame(nullptr);
+		}
+	}
+
+private:
+	JNIEnv *env;
+	bool pushed;
+
+	LocalFrame(const LocalFrame&);
+	LocalFrame& operator=(const LocalFrame&);
+};
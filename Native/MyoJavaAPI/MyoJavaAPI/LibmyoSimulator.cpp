@@ -0,0 +1,672 @@
+#ifdef MYO_SIMULATED
+#include "LibmyoSimulator.h"
+#include <myo/libmyo.h>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ * The simulated libmyo; see LibmyoSimulator.h.
+ *
+ * Each armband has a set of timers (the next IMU sample, EMG sample, pose change, connection change and timed
+ * relock), and libmyo_run() repeatedly delivers whichever timer of any armband is due first. Events that happen all
+ * at once, like the pair/connect/sync sequence or the answer to a request, go through a FIFO that is always drained
+ * before the timers. Timestamps are in microseconds, like libmyo's.
+ *
+ * All state of a hub is guarded by its mutex, which is released while the handler runs so that it (or any other
+ * thread) can call back into the API.
+ */
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+//How long a timed unlock lasts after the last pose
+const uint64_t unlockDuration = 2000000;
+const uint64_t never = UINT64_MAX;
+
+struct SimMyo;
+struct SimHub;
+
+struct SimEvent {
+	libmyo_event_type_t type;
+	uint64_t timestamp;
+	SimMyo *myo;
+	unsigned int firmwareVersion[4];
+	libmyo_arm_t arm;
+	libmyo_x_direction_t xDirection;
+	float rotation;
+	libmyo_warmup_state_t warmupState;
+	libmyo_warmup_result_t warmupResult;
+	float orientation[4];
+	float accelerometer[3];
+	float gyroscope[3];
+	libmyo_pose_t pose;
+	int8_t rssi;
+	uint8_t batteryLevel;
+	int8_t emg[8];
+};
+
+struct SimMyo {
+	SimHub *hub;
+	unsigned int index;
+	uint64_t macAddress;
+	uint32_t random;
+	//Phase of the synthetic arm motion, so that armbands don't all move in lockstep
+	double phase;
+	uint8_t batteryLevel;
+
+	bool connected = false;
+	bool unlocked = false;
+	bool unlockHeld = false;
+	bool streamEmg = false;
+	libmyo_pose_t pose = libmyo_pose_rest;
+
+	uint64_t nextImu = never;
+	uint64_t nextEmg = never;
+	uint64_t nextPose = never;
+	uint64_t nextConnectionChange = never;
+	uint64_t relockTime = never;
+
+	//xorshift32; good enough for noise, and the same on every platform
+	uint32_t nextRandom() {
+		random ^= random << 13;
+		random ^= random >> 17;
+		random ^= random << 5;
+		return random;
+	}
+	//Uniform in [0, 1)
+	double uniform() {
+		return (nextRandom() >> 8) / 16777216.0;
+	}
+	//Roughly normal with a standard deviation of 1
+	double noise() {
+		return (uniform() + uniform() + uniform() + uniform() - 2) * 1.7320508;
+	}
+	//Uniform in [0.5, 1.5) times the average
+	uint64_t interval(double averageSeconds) {
+		return static_cast<uint64_t>(averageSeconds * (0.5 + uniform()) * 1e6);
+	}
+};
+
+struct SimHub {
+	SimulatorConfig config;
+	libmyo_locking_policy_t lockingPolicy = libmyo_locking_policy_standard;
+	vector<unique_ptr<SimMyo>> myos;
+	deque<SimEvent> immediateEvents;
+	uint64_t imuPeriod;
+	uint64_t emgPeriod;
+
+	chrono::steady_clock::time_point startTime;
+	uint64_t startTimestamp;
+	//Current time when not running in real time
+	uint64_t simulatedTime;
+
+	mutex lock;
+	//Signalled when an immediate event is added while libmyo_run() is waiting
+	condition_variable wakeup;
+
+	uint64_t now() const {
+		if (!config.realTime) {
+			return simulatedTime;
+		}
+		return startTimestamp + chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count();
+	}
+	chrono::steady_clock::time_point realTimeOf(uint64_t timestamp) const {
+		return startTime + chrono::microseconds(timestamp - startTimestamp);
+	}
+};
+
+struct SimError {
+	libmyo_result_t kind;
+	string message;
+};
+
+mutex configMutex;
+bool configured = false;
+SimulatorConfig currentConfig;
+
+libmyo_result_t fail(libmyo_error_details_t *out_error, libmyo_result_t kind, const char *message) {
+	if (out_error) {
+		*out_error = new SimError{ kind, message };
+	}
+	return kind;
+}
+
+SimEvent makeEvent(SimMyo *myo, libmyo_event_type_t type, uint64_t timestamp) {
+	SimEvent event = {};
+	event.type = type;
+	event.timestamp = timestamp;
+	event.myo = myo;
+	event.arm = libmyo_arm_unknown;
+	event.xDirection = libmyo_x_direction_unknown;
+	event.pose = libmyo_pose_unknown;
+	//Firmware 1.5.1970 on a consumer unit
+	event.firmwareVersion[0] = 1;
+	event.firmwareVersion[1] = 5;
+	event.firmwareVersion[2] = 1970;
+	event.firmwareVersion[3] = libmyo_hardware_rev_d;
+	return event;
+}
+
+void connect(SimMyo &myo, uint64_t time) {
+	SimHub &hub = *myo.hub;
+	myo.connected = true;
+	myo.unlocked = hub.lockingPolicy == libmyo_locking_policy_none;
+	myo.unlockHeld = false;
+	myo.pose = libmyo_pose_rest;
+	myo.nextImu = time + hub.imuPeriod;
+	myo.nextEmg = time + hub.emgPeriod;
+	myo.nextPose = hub.config.poseInterval > 0 ? time + myo.interval(hub.config.poseInterval) : never;
+	myo.nextConnectionChange = hub.config.connectionInterval > 0 ? time + myo.interval(hub.config.connectionInterval) : never;
+	myo.relockTime = never;
+
+	hub.immediateEvents.push_back(makeEvent(&myo, libmyo_event_connected, time));
+	SimEvent synced = makeEvent(&myo, libmyo_event_arm_synced, time);
+	synced.arm = myo.index % 2 == 0 ? libmyo_arm_right : libmyo_arm_left;
+	synced.xDirection = libmyo_x_direction_toward_wrist;
+	synced.warmupState = libmyo_warmup_state_warm;
+	hub.immediateEvents.push_back(synced);
+	if (myo.unlocked) {
+		hub.immediateEvents.push_back(makeEvent(&myo, libmyo_event_unlocked, time));
+	}
+}
+
+void disconnect(SimMyo &myo, uint64_t time) {
+	myo.connected = false;
+	myo.unlocked = false;
+	myo.nextImu = never;
+	myo.nextEmg = never;
+	myo.nextPose = never;
+	myo.relockTime = never;
+	myo.nextConnectionChange = time + static_cast<uint64_t>(myo.hub->config.disconnectDuration * 1e6);
+	myo.hub->immediateEvents.push_back(makeEvent(&myo, libmyo_event_disconnected, time));
+}
+
+void unlockMyo(SimMyo &myo, libmyo_unlock_type_t type, uint64_t time) {
+	if (!myo.unlocked) {
+		myo.unlocked = true;
+		myo.hub->immediateEvents.push_back(makeEvent(&myo, libmyo_event_unlocked, time));
+	}
+	myo.unlockHeld = type == libmyo_unlock_hold;
+	myo.relockTime = myo.unlockHeld ? never : time + unlockDuration;
+}
+
+void lockMyo(SimMyo &myo, uint64_t time) {
+	if (myo.unlocked) {
+		myo.unlocked = false;
+		myo.hub->immediateEvents.push_back(makeEvent(&myo, libmyo_event_locked, time));
+	}
+	myo.unlockHeld = false;
+	myo.relockTime = never;
+}
+
+//The arm sways slowly about all three axes; orientation is a ZYX (yaw, pitch, roll) rotation.
+SimEvent imuEvent(SimMyo &myo, uint64_t time) {
+	SimHub &hub = *myo.hub;
+	double t = (time - hub.startTimestamp) / 1e6 + myo.phase;
+	double roll = 0.6 * sin(0.7 * t), rollRate = 0.42 * cos(0.7 * t);
+	double pitch = 0.4 * sin(0.5 * t), pitchRate = 0.2 * cos(0.5 * t);
+	double yaw = 1.0 * sin(0.3 * t), yawRate = 0.3 * cos(0.3 * t);
+
+	double cr = cos(roll / 2), sr = sin(roll / 2);
+	double cp = cos(pitch / 2), sp = sin(pitch / 2);
+	double cy = cos(yaw / 2), sy = sin(yaw / 2);
+
+	SimEvent event = makeEvent(&myo, libmyo_event_orientation, time);
+	event.orientation[libmyo_orientation_x] = static_cast<float>(sr * cp * cy - cr * sp * sy);
+	event.orientation[libmyo_orientation_y] = static_cast<float>(cr * sp * cy + sr * cp * sy);
+	event.orientation[libmyo_orientation_z] = static_cast<float>(cr * cp * sy - sr * sp * cy);
+	event.orientation[libmyo_orientation_w] = static_cast<float>(cr * cp * cy + sr * sp * sy);
+
+	//Gravity in the armband's frame, plus some sensor noise and more of it while a pose is held
+	double shake = myo.pose == libmyo_pose_rest ? 0.01 : 0.05;
+	event.accelerometer[0] = static_cast<float>(-sin(pitch) + shake * myo.noise());
+	event.accelerometer[1] = static_cast<float>(sin(roll) * cos(pitch) + shake * myo.noise());
+	event.accelerometer[2] = static_cast<float>(cos(roll) * cos(pitch) + shake * myo.noise());
+
+	const double degrees = 180 / pi;
+	event.gyroscope[0] = static_cast<float>(rollRate * degrees + 0.5 * myo.noise());
+	event.gyroscope[1] = static_cast<float>(pitchRate * degrees + 0.5 * myo.noise());
+	event.gyroscope[2] = static_cast<float>(yawRate * degrees + 0.5 * myo.noise());
+	return event;
+}
+
+//Muscle activity is noise whose amplitude depends on the pose, with a different mix of channels for each pose.
+SimEvent emgEvent(SimMyo &myo, uint64_t time) {
+	SimEvent event = makeEvent(&myo, libmyo_event_emg, time);
+	int pose = myo.pose == libmyo_pose_unknown ? 0 : myo.pose;
+	double amplitude = pose == libmyo_pose_rest ? 3 : 35;
+	for (int i = 0; i < 8; i++) {
+		double gain = pose == libmyo_pose_rest ? 1 : 0.3 + ((pose * 3 + i * 5) % 8) / 7.0;
+		double value = amplitude * gain * myo.noise();
+		event.emg[i] = static_cast<int8_t>(value > 127 ? 127 : value < -128 ? -128 : value);
+	}
+	return event;
+}
+
+//Alternates between rest and a random other pose. A locked armband under the standard locking policy only ever
+//recognizes the unlock gesture.
+void changePose(SimMyo &myo, uint64_t time) {
+	SimHub &hub = *myo.hub;
+	myo.nextPose = time + myo.interval(hub.config.poseInterval);
+
+	bool standard = hub.lockingPolicy == libmyo_locking_policy_standard;
+	libmyo_pose_t pose;
+	if (standard && !myo.unlocked) {
+		pose = libmyo_pose_double_tap;
+		unlockMyo(myo, libmyo_unlock_timed, time);
+	}
+	else if (myo.pose == libmyo_pose_rest || myo.pose == libmyo_pose_double_tap) {
+		static const libmyo_pose_t active[] = { libmyo_pose_fist, libmyo_pose_wave_in, libmyo_pose_wave_out, libmyo_pose_fingers_spread };
+		pose = active[myo.nextRandom() % 4];
+	}
+	else {
+		pose = libmyo_pose_rest;
+	}
+	myo.pose = pose;
+	if (myo.unlocked && !myo.unlockHeld) {
+		myo.relockTime = time + unlockDuration;
+	}
+
+	SimEvent event = makeEvent(&myo, libmyo_event_pose, time);
+	event.pose = pose;
+	hub.immediateEvents.push_back(event);
+}
+
+//Advances the earliest timer of any armband, adding its event to the immediate events.
+//Returns false without changing anything if no timer is due by the deadline; time is then the earliest due time.
+bool fireNextTimer(SimHub &hub, uint64_t deadline, uint64_t &time) {
+	SimMyo *next = nullptr;
+	uint64_t *timer = nullptr;
+	time = never;
+	for (auto &myo : hub.myos) {
+		uint64_t *timers[] = { &myo->nextImu, &myo->nextEmg, &myo->nextPose, &myo->nextConnectionChange, &myo->relockTime };
+		for (uint64_t *t : timers) {
+			//EMG is only streamed on request
+			if (t == &myo->nextEmg && !myo->streamEmg) {
+				continue;
+			}
+			if (*t < time) {
+				time = *t;
+				next = myo.get();
+				timer = t;
+			}
+		}
+	}
+	if (!next || time > deadline || (hub.config.realTime && time > hub.now())) {
+		return false;
+	}
+
+	if (!hub.config.realTime) {
+		hub.simulatedTime = time;
+	}
+	SimMyo &myo = *next;
+	if (timer == &myo.nextImu) {
+		myo.nextImu += hub.imuPeriod;
+		hub.immediateEvents.push_back(imuEvent(myo, time));
+	}
+	else if (timer == &myo.nextEmg) {
+		myo.nextEmg += hub.emgPeriod;
+		hub.immediateEvents.push_back(emgEvent(myo, time));
+	}
+	else if (timer == &myo.nextPose) {
+		changePose(myo, time);
+	}
+	else if (timer == &myo.nextConnectionChange) {
+		if (myo.connected) {
+			disconnect(myo, time);
+		}
+		else {
+			connect(myo, time);
+		}
+	}
+	else {
+		lockMyo(myo, time);
+	}
+	return true;
+}
+
+SimMyo* toMyo(libmyo_myo_t myo) {
+	return static_cast<SimMyo*>(myo);
+}
+
+const SimEvent* toEvent(libmyo_event_t event) {
+	return static_cast<const SimEvent*>(event);
+}
+
+double readSetting(const char *name, double defaultValue) {
+	const char *value = getenv(name);
+	return value && *value ? atof(value) : defaultValue;
+}
+
+}
+
+void configureSimulator(const SimulatorConfig &config) {
+	lock_guard<mutex> guard(configMutex);
+	currentConfig = config;
+	configured = true;
+}
+
+SimulatorConfig simulatorConfigFromEnvironment() {
+	SimulatorConfig config;
+	config.myoCount = static_cast<unsigned int>(readSetting("MYO_SIM_COUNT", config.myoCount));
+	config.imuRate = readSetting("MYO_SIM_IMU_RATE", config.imuRate);
+	config.emgRate = readSetting("MYO_SIM_EMG_RATE", config.emgRate);
+	config.poseInterval = readSetting("MYO_SIM_POSE_INTERVAL", config.poseInterval);
+	config.connectionInterval = readSetting("MYO_SIM_CONNECTION_INTERVAL", config.connectionInterval);
+	config.disconnectDuration = readSetting("MYO_SIM_DISCONNECT_DURATION", config.disconnectDuration);
+	config.realTime = readSetting("MYO_SIM_REALTIME", config.realTime ? 1 : 0) != 0;
+	config.seed = static_cast<uint32_t>(readSetting("MYO_SIM_SEED", config.seed));
+	return config;
+}
+
+const char* libmyo_error_cstring(libmyo_error_details_t error) {
+	return static_cast<SimError*>(error)->message.c_str();
+}
+
+libmyo_result_t libmyo_error_kind(libmyo_error_details_t error) {
+	return static_cast<SimError*>(error)->kind;
+}
+
+void libmyo_free_error_details(libmyo_error_details_t error) {
+	delete static_cast<SimError*>(error);
+}
+
+const char* libmyo_string_c_str(libmyo_string_t string) {
+	return static_cast<std::string*>(string)->c_str();
+}
+
+void libmyo_string_free(libmyo_string_t string) {
+	delete static_cast<std::string*>(string);
+}
+
+libmyo_string_t libmyo_mac_address_to_string(uint64_t address) {
+	char buffer[18];
+	snprintf(buffer, sizeof(buffer), "%02x-%02x-%02x-%02x-%02x-%02x",
+		static_cast<unsigned int>(address >> 40 & 0xff), static_cast<unsigned int>(address >> 32 & 0xff),
+		static_cast<unsigned int>(address >> 24 & 0xff), static_cast<unsigned int>(address >> 16 & 0xff),
+		static_cast<unsigned int>(address >> 8 & 0xff), static_cast<unsigned int>(address & 0xff));
+	return new std::string(buffer);
+}
+
+uint64_t libmyo_string_to_mac_address(const char *string) {
+	if (!string || strlen(string) != 17) {
+		return 0;
+	}
+	uint64_t address = 0;
+	for (int i = 0; i < 17; i++) {
+		char c = string[i];
+		if (i % 3 == 2) {
+			if (c != '-') {
+				return 0;
+			}
+			continue;
+		}
+		int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+		if (digit < 0) {
+			return 0;
+		}
+		address = address << 4 | static_cast<uint64_t>(digit);
+	}
+	return address;
+}
+
+libmyo_result_t libmyo_init_hub(libmyo_hub_t *out_hub, const char *application_identifier, libmyo_error_details_t *out_error) {
+	if (!out_hub) {
+		return fail(out_error, libmyo_error_invalid_argument, "out_hub is NULL");
+	}
+	if (application_identifier && strlen(application_identifier) > 255) {
+		return fail(out_error, libmyo_error_invalid_argument, "Application identifier is longer than 255 characters");
+	}
+
+	SimHub *hub = new SimHub();
+	{
+		lock_guard<mutex> guard(configMutex);
+		hub->config = configured ? currentConfig : simulatorConfigFromEnvironment();
+	}
+	const SimulatorConfig &config = hub->config;
+	hub->imuPeriod = config.imuRate > 0 ? static_cast<uint64_t>(1e6 / config.imuRate) : never;
+	hub->emgPeriod = config.emgRate > 0 ? static_cast<uint64_t>(1e6 / config.emgRate) : never;
+	hub->startTime = chrono::steady_clock::now();
+	hub->startTimestamp = chrono::duration_cast<chrono::microseconds>(hub->startTime.time_since_epoch()).count();
+	hub->simulatedTime = hub->startTimestamp;
+
+	for (unsigned int i = 0; i < config.myoCount; i++) {
+		SimMyo *myo = new SimMyo();
+		myo->hub = hub;
+		myo->index = i;
+		myo->macAddress = 0xd0d0d0000000ULL + i;
+		//Never zero, which would stick xorshift at zero
+		myo->random = (config.seed ^ 0x9e3779b9u) * (2 * i + 1) | 1;
+		myo->phase = myo->uniform() * 100;
+		myo->batteryLevel = static_cast<uint8_t>(60 + myo->nextRandom() % 41);
+		hub->myos.emplace_back(myo);
+
+		hub->immediateEvents.push_back(makeEvent(myo, libmyo_event_paired, hub->startTimestamp));
+		connect(*myo, hub->startTimestamp);
+	}
+
+	*out_hub = hub;
+	return libmyo_success;
+}
+
+libmyo_result_t libmyo_shutdown_hub(libmyo_hub_t hub, libmyo_error_details_t *out_error) {
+	if (!hub) {
+		return fail(out_error, libmyo_error_invalid_argument, "hub is NULL");
+	}
+	delete static_cast<SimHub*>(hub);
+	return libmyo_success;
+}
+
+libmyo_result_t libmyo_set_locking_policy(libmyo_hub_t hub_opq, libmyo_locking_policy_t locking_policy, libmyo_error_details_t *out_error) {
+	if (!hub_opq) {
+		return fail(out_error, libmyo_error_invalid_argument, "hub is NULL");
+	}
+	SimHub *hub = static_cast<SimHub*>(hub_opq);
+	lock_guard<mutex> guard(hub->lock);
+	hub->lockingPolicy = locking_policy;
+	return libmyo_success;
+}
+
+uint64_t libmyo_get_mac_address(libmyo_myo_t myo) {
+	return toMyo(myo)->macAddress;
+}
+
+libmyo_result_t libmyo_vibrate(libmyo_myo_t myo, libmyo_vibration_type_t /*type*/, libmyo_error_details_t *out_error) {
+	if (!myo) {
+		return fail(out_error, libmyo_error_invalid_argument, "myo is NULL");
+	}
+	return libmyo_success;
+}
+
+libmyo_result_t libmyo_request_rssi(libmyo_myo_t myo_opq, libmyo_error_details_t *out_error) {
+	if (!myo_opq) {
+		return fail(out_error, libmyo_error_invalid_argument, "myo is NULL");
+	}
+	SimMyo *myo = toMyo(myo_opq);
+	lock_guard<mutex> guard(myo->hub->lock);
+	SimEvent event = makeEvent(myo, libmyo_event_rssi, myo->hub->now());
+	event.rssi = static_cast<int8_t>(-45 - static_cast<int>(myo->nextRandom() % 30));
+	myo->hub->immediateEvents.push_back(event);
+	myo->hub->wakeup.notify_all();
+	return libmyo_success;
+}
+
+libmyo_result_t libmyo_request_battery_level(libmyo_myo_t myo_opq, libmyo_error_details_t *out_error) {
+	if (!myo_opq) {
+		return fail(out_error, libmyo_error_invalid_argument, "myo is NULL");
+	}
+	SimMyo *myo = toMyo(myo_opq);
+	lock_guard<mutex> guard(myo->hub->lock);
+	SimEvent event = makeEvent(myo, libmyo_event_battery_level, myo->hub->now());
+	event.batteryLevel = myo->batteryLevel;
+	myo->hub->immediateEvents.push_back(event);
+	myo->hub->wakeup.notify_all();
+	return libmyo_success;
+}
+
+libmyo_result_t libmyo_set_stream_emg(libmyo_myo_t myo_opq, libmyo_stream_emg_t emg, libmyo_error_details_t *out_error) {
+	if (!myo_opq) {
+		return fail(out_error, libmyo_error_invalid_argument, "myo is NULL");
+	}
+	SimMyo *myo = toMyo(myo_opq);
+	lock_guard<mutex> guard(myo->hub->lock);
+	bool enable = emg == libmyo_stream_emg_enabled;
+	if (enable && !myo->streamEmg && myo->connected) {
+		myo->nextEmg = myo->hub->now() + myo->hub->emgPeriod;
+	}
+	myo->streamEmg = enable;
+	myo->hub->wakeup.notify_all();
+	return libmyo_success;
+}
+
+libmyo_result_t libmyo_myo_unlock(libmyo_myo_t myo_opq, libmyo_unlock_type_t type, libmyo_error_details_t *out_error) {
+	if (!myo_opq) {
+		return fail(out_error, libmyo_error_invalid_argument, "myo is NULL");
+	}
+	SimMyo *myo = toMyo(myo_opq);
+	lock_guard<mutex> guard(myo->hub->lock);
+	unlockMyo(*myo, type, myo->hub->now());
+	myo->hub->wakeup.notify_all();
+	return libmyo_success;
+}
+
+libmyo_result_t libmyo_myo_lock(libmyo_myo_t myo_opq, libmyo_error_details_t *out_error) {
+	if (!myo_opq) {
+		return fail(out_error, libmyo_error_invalid_argument, "myo is NULL");
+	}
+	SimMyo *myo = toMyo(myo_opq);
+	lock_guard<mutex> guard(myo->hub->lock);
+	lockMyo(*myo, myo->hub->now());
+	myo->hub->wakeup.notify_all();
+	return libmyo_success;
+}
+
+libmyo_result_t libmyo_myo_notify_user_action(libmyo_myo_t myo, libmyo_user_action_type_t /*type*/, libmyo_error_details_t *out_error) {
+	if (!myo) {
+		return fail(out_error, libmyo_error_invalid_argument, "myo is NULL");
+	}
+	return libmyo_success;
+}
+
+uint32_t libmyo_event_get_type(libmyo_event_t event) {
+	return toEvent(event)->type;
+}
+
+uint64_t libmyo_event_get_timestamp(libmyo_event_t event) {
+	return toEvent(event)->timestamp;
+}
+
+libmyo_myo_t libmyo_event_get_myo(libmyo_event_t event) {
+	return toEvent(event)->myo;
+}
+
+uint64_t libmyo_event_get_mac_address(libmyo_event_t event) {
+	return toEvent(event)->myo->macAddress;
+}
+
+libmyo_string_t libmyo_event_get_myo_name(libmyo_event_t event) {
+	return new std::string("Simulated Myo " + to_string(toEvent(event)->myo->index + 1));
+}
+
+unsigned int libmyo_event_get_firmware_version(libmyo_event_t event, libmyo_version_component_t component) {
+	return static_cast<unsigned int>(component) < 4 ? toEvent(event)->firmwareVersion[component] : 0;
+}
+
+libmyo_arm_t libmyo_event_get_arm(libmyo_event_t event) {
+	return toEvent(event)->arm;
+}
+
+libmyo_x_direction_t libmyo_event_get_x_direction(libmyo_event_t event) {
+	return toEvent(event)->xDirection;
+}
+
+libmyo_warmup_state_t libmyo_event_get_warmup_state(libmyo_event_t event) {
+	return toEvent(event)->warmupState;
+}
+
+libmyo_warmup_result_t libmyo_event_get_warmup_result(libmyo_event_t event) {
+	return toEvent(event)->warmupResult;
+}
+
+float libmyo_event_get_rotation_on_arm(libmyo_event_t event) {
+	return toEvent(event)->rotation;
+}
+
+float libmyo_event_get_orientation(libmyo_event_t event, libmyo_orientation_index index) {
+	return toEvent(event)->orientation[index];
+}
+
+float libmyo_event_get_accelerometer(libmyo_event_t event, unsigned int index) {
+	return toEvent(event)->accelerometer[index];
+}
+
+float libmyo_event_get_gyroscope(libmyo_event_t event, unsigned int index) {
+	return toEvent(event)->gyroscope[index];
+}
+
+libmyo_pose_t libmyo_event_get_pose(libmyo_event_t event) {
+	return toEvent(event)->pose;
+}
+
+int8_t libmyo_event_get_rssi(libmyo_event_t event) {
+	return toEvent(event)->rssi;
+}
+
+uint8_t libmyo_event_get_battery_level(libmyo_event_t event) {
+	return toEvent(event)->batteryLevel;
+}
+
+int8_t libmyo_event_get_emg(libmyo_event_t event, unsigned int sensor) {
+	return toEvent(event)->emg[sensor];
+}
+
+libmyo_result_t libmyo_run(libmyo_hub_t hub_opq, unsigned int duration_ms, libmyo_handler_t handler, void *user_data,
+	libmyo_error_details_t *out_error) {
+	if (!hub_opq) {
+		return fail(out_error, libmyo_error_invalid_argument, "hub is NULL");
+	}
+	if (!handler) {
+		return fail(out_error, libmyo_error_invalid_argument, "handler is NULL");
+	}
+	SimHub *hub = static_cast<SimHub*>(hub_opq);
+	unique_lock<mutex> guard(hub->lock);
+	uint64_t deadline = hub->now() + static_cast<uint64_t>(duration_ms) * 1000;
+
+	for (;;) {
+		uint64_t due;
+		if (hub->immediateEvents.empty() && !fireNextTimer(*hub, deadline, due)) {
+			if (!hub->config.realTime) {
+				hub->simulatedTime = deadline;
+				return libmyo_success;
+			}
+			if (hub->now() >= deadline) {
+				return libmyo_success;
+			}
+			//Sleep until the next timer is due, or until a request adds an immediate event
+			hub->wakeup.wait_until(guard, hub->realTimeOf(due < deadline ? due : deadline));
+			continue;
+		}
+
+		SimEvent event = hub->immediateEvents.front();
+		hub->immediateEvents.pop_front();
+		guard.unlock();
+		libmyo_handler_result_t result = handler(user_data, &event);
+		guard.lock();
+		if (result == libmyo_handler_stop) {
+			return libmyo_success;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+/*
+ * Settings of the simulated libmyo.
+ *
+ * When the library is built with MYO_SIMULATED defined, LibmyoSimulator.cpp implements the whole libmyo C API and
+ * takes the place of myo64.lib, so the JNI layer can be built, run and profiled without the Myo Connect runtime (or
+ * Windows). Every hub gets its own set of virtual armbands, which pair, connect and sync right after the hub is
+ * initialized and then stream synthetic orientation data and pose changes, plus EMG data once it is enabled through
+ * libmyo_set_stream_emg(). Requests (RSSI, battery level, lock and unlock) are answered with the matching event.
+ *
+ * A hub uses the settings that were current when it was initialized. Unless configureSimulator() has been called,
+ * they are read from the environment; see simulatorConfigFromEnvironment().
+ */
+struct SimulatorConfig {
+	//Number of virtual armbands
+	unsigned int myoCount = 1;
+	//Event rates, in events per second per armband
+	double imuRate = 50;
+	double emgRate = 200;
+	//Average number of seconds between pose changes; 0 to never change poses
+	double poseInterval = 1.5;
+	//Average number of seconds between a disconnect and the previous connect, and how long an armband stays
+	//disconnected; 0 to never disconnect
+	double connectionInterval = 0;
+	double disconnectDuration = 1;
+	//When true, libmyo_run() delivers events at the times they are due, like the real libmyo.
+	//When false, simulated time runs as fast as the handler consumes events, so a libmyo_run(hub, 1000, ...) call
+	//delivers one second's worth of events as fast as possible. Timestamps are the same either way.
+	bool realTime = true;
+	//Seed for the noise, pose changes and disconnects; the same seed produces the same stream
+	uint32_t seed = 1;
+};
+
+//Sets the settings used by hubs initialized after this call.
+void configureSimulator(const SimulatorConfig &config);
+//Reads the settings from MYO_SIM_COUNT, MYO_SIM_IMU_RATE, MYO_SIM_EMG_RATE, MYO_SIM_POSE_INTERVAL,
+//MYO_SIM_CONNECTION_INTERVAL, MYO_SIM_DISCONNECT_DURATION, MYO_SIM_REALTIME (0 or 1) and MYO_SIM_SEED.
+//Unset variables keep their default value.
+SimulatorConfig simulatorConfigFromEnvironment();
@@ -0,0 +1,924 @@
+#pragma once
+#include <jni.h>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <myo/myo.hpp>
+#include "JNICache.h"
+#include "com_thalmic_myo_Hub.h"
+#include "MyoEvent.h"
+#include "MyoPeers.h"
+#include "EmgFeatureExtractor.h"
+#include "EmgFilter.h"
+#include "OrientationProcessor.h"
+
+/*
+ * The native side of a Java DeviceListener.
+ *
+ * Calls the Java listener for every event it is dispatched, but only for the callbacks the Java class actually
+ * implements (see Hub.addListener()). Wrappers don't belong to any particular Hub: they hand out the Java Myo
+ * objects of whatever MyoPeers they are created with, so the same wrapper works for a live Hub and a ReplayHub.
+ */
+class ListenerWrapper : public EventListener {
+
+public:
+	//Bits of the Java callbacks that the listener implements; see Hub.implementedCallbacks()
+	enum Callback {
+		callbackPair = com_thalmic_myo_Hub_CALLBACK_PAIR,
+		callbackUnpair = com_thalmic_myo_Hub_CALLBACK_UNPAIR,
+		callbackConnect = com_thalmic_myo_Hub_CALLBACK_CONNECT,
+		callbackDisconnect = com_thalmic_myo_Hub_CALLBACK_DISCONNECT,
+		callbackArmSync = com_thalmic_myo_Hub_CALLBACK_ARM_SYNC,
+		callbackArmUnsync = com_thalmic_myo_Hub_CALLBACK_ARM_UNSYNC,
+		callbackUnlock = com_thalmic_myo_Hub_CALLBACK_UNLOCK,
+		callbackLock = com_thalmic_myo_Hub_CALLBACK_LOCK,
+		callbackPose = com_thalmic_myo_Hub_CALLBACK_POSE,
+		callbackOrientationData = com_thalmic_myo_Hub_CALLBACK_ORIENTATION_DATA,
+		callbackAccelerometerData = com_thalmic_myo_Hub_CALLBACK_ACCELEROMETER_DATA,
+		callbackGyroscopeData = com_thalmic_myo_Hub_CALLBACK_GYROSCOPE_DATA,
+		callbackRssi = com_thalmic_myo_Hub_CALLBACK_RSSI,
+		callbackBatteryLevelReceived = com_thalmic_myo_Hub_CALLBACK_BATTERY_LEVEL_RECEIVED,
+		callbackEmgData = com_thalmic_myo_Hub_CALLBACK_EMG_DATA,
+		callbackWarmupCompleted = com_thalmic_myo_Hub_CALLBACK_WARMUP_COMPLETED,
+		callbackEmgBatch = com_thalmic_myo_Hub_CALLBACK_EMG_BATCH,
+		callbackImuData = com_thalmic_myo_Hub_CALLBACK_IMU_DATA,
+		callbackOrientationRaw = com_thalmic_myo_Hub_CALLBACK_ORIENTATION_RAW,
+		callbackAccelerometerRaw = com_thalmic_myo_Hub_CALLBACK_ACCELEROMETER_RAW,
+		callbackGyroscopeRaw = com_thalmic_myo_Hub_CALLBACK_GYROSCOPE_RAW,
+		callbackEmgFeatures = com_thalmic_myo_Hub_CALLBACK_EMG_FEATURES,
+		callbackEmgFilteredData = com_thalmic_myo_Hub_CALLBACK_EMG_FILTERED_DATA,
+		callbackEmgFilteredBatch = com_thalmic_myo_Hub_CALLBACK_EMG_FILTERED_BATCH,
+		callbackOrientationEuler = com_thalmic_myo_Hub_CALLBACK_ORIENTATION_EULER
+	};
+	uint32_t callbacks;
+
+	bool implements(uint32_t callback) const {
+		return (callbacks & callback) != 0;
+	}
+
+	//EMG frames for one Myo waiting to be delivered through onEmgBatch.
+	//The memory and the Java objects wrapping it are allocated once and reused for every batch.
+	struct EmgBatch {
+		int8_t *samples;
+		jlong *timestamps;
+		jobject sampleBuffer;
+		jlongArray timestampArray;
+		jint count;
+	};
+	std::unordered_map<myo::Myo*, EmgBatch> emgBatches;
+	//Filtered EMG frames for one Myo waiting to be delivered through onEmgFilteredBatch. Reused like EmgBatch.
+	struct FilteredEmgBatch {
+		float *samples;
+		jlong *timestamps;
+		jfloatArray sampleArray;
+		jlongArray timestampArray;
+		jint count;
+	};
+	std::unordered_map<myo::Myo*, FilteredEmgBatch> filteredEmgBatches;
+	//Maximum number of frames in a batch, and maximum age of the oldest frame before a batch is delivered.
+	//The same for raw and filtered batches. Only used by the dispatching thread.
+	jint emgBatchFrames = 32;
+	uint64_t emgBatchLatencyUs = 100000;
+	//Batching parameters set from Java, which the dispatching thread picks up before it next touches a batch.
+	//Guarded by settingsMutex; emgBatchingChanged is set once they are there.
+	jint pendingEmgBatchFrames = 32;
+	uint64_t pendingEmgBatchLatencyUs = 100000;
+	std::atomic<bool> emgBatchingChanged;
+	std::mutex settingsMutex;
+
+	//EMG features of each Myo, over windows of emgFeatureWindow frames delivered every emgFeatureHop frames.
+	//Only used by the dispatching thread.
+	std::unordered_map<myo::Myo*, std::unique_ptr<EmgFeatureExtractor>> emgFeatures;
+	jint emgFeatureWindow = 40;
+	jint emgFeatureHop = 10;
+	//Feature parameters set from Java, picked up like the batching parameters. Guarded by settingsMutex;
+	//emgFeaturesChanged is set once they are there.
+	jint pendingEmgFeatureWindow = 40;
+	jint pendingEmgFeatureHop = 10;
+	std::atomic<bool> emgFeaturesChanged;
+	//Passed to every onEmgFeatures call
+	jfloatArray featureArray = nullptr;
+
+	//Passed to every onImuData call
+	jfloatArray imuArray = nullptr;
+	//Passed to every onEmgFilteredData call
+	jfloatArray filteredArray = nullptr;
+
+	jobject jlistener;
+
+	jclass listenerClass;
+
+	//Where the Java Myo objects passed to the listener come from
+	MyoPeers *peers;
+
+	jmethodID onPairMid, onUnpairMid, onConnectMid, onDisconnectMid, onArmSyncMid, onArmUnsyncMid,
+		onLockMid, onUnlockMid, onPoseMid, onOrientationDataMid, onAccelerometerDataMid, onGyroscopeDataMid,
+		onRssiMid, onBatteryLevelReceivedMid, onEmgDataMid, onWarmupCompletedMid, onEmgBatchMid, onImuDataMid,
+		onOrientationRawMid, onAccelerometerRawMid, onGyroscopeRawMid, onEmgFeaturesMid,
+		onEmgFilteredDataMid, onEmgFilteredBatchMid, onOrientationEulerMid;
+
+	JNIEnv* getJNIEnv() {
+		return jniCache.getJNIEnv();
+	}
+
+	static jclass makeGlobal(JNIEnv *env, jclass clazz) {
+		jclass ref = (jclass)env->NewGlobalRef(clazz);
+		if (!ref) {
+			THROW_JNI_EXCEPTION(env, "Failed to make global reference for class; JVM is out of memory");
+			return nullptr;
+		}
+		return ref;
+	}
+
+	ListenerWrapper(MyoPeers *peers, jobject listener, JNIEnv *env, jint callbacks) :
+		callbacks(static_cast<uint32_t>(callbacks)),
+		emgBatchingChanged(false),
+		emgFeaturesChanged(false),
+		peers(peers) {
+
+		listenerClass = makeGlobal(env, env->GetObjectClass(listener));
+		jlistener = env->NewGlobalRef(listener);
+		if (!jlistener) {
+			THROW_JNI_EXCEPTION(env, "Failed to make global reference for object; JVM is out of memory");
+			return;
+		}
+		if (implements(callbackPair))
+			onPairMid = env->GetMethodID(listenerClass, "onPair", "(Lcom/thalmic/myo/Myo;JLcom/thalmic/myo/FirmwareVersion;)V");
+		if (implements(callbackUnpair))
+			onUnpairMid = env->GetMethodID(listenerClass, "onUnpair", "(Lcom/thalmic/myo/Myo;J)V");
+		if (implements(callbackConnect))
+			onConnectMid = env->GetMethodID(listenerClass, "onConnect", "(Lcom/thalmic/myo/Myo;JLcom/thalmic/myo/FirmwareVersion;)V");
+		if (implements(callbackDisconnect))
+			onDisconnectMid = env->GetMethodID(listenerClass, "onDisconnect", "(Lcom/thalmic/myo/Myo;J)V");
+		if (implements(callbackArmSync))
+			onArmSyncMid = env->GetMethodID(listenerClass, "onArmSync", "(Lcom/thalmic/myo/Myo;JLcom/thalmic/myo/Arm;Lcom/thalmic/myo/XDirection;FLcom/thalmic/myo/WarmupState;)V");
+		if (implements(callbackArmUnsync))
+			onArmUnsyncMid = env->GetMethodID(listenerClass, "onArmUnsync", "(Lcom/thalmic/myo/Myo;J)V");
+		if (implements(callbackLock))
+			onLockMid = env->GetMethodID(listenerClass, "onLock", "(Lcom/thalmic/myo/Myo;J)V");
+		if (implements(callbackUnlock))
+			onUnlockMid = env->GetMethodID(listenerClass, "onUnlock", "(Lcom/thalmic/myo/Myo;J)V");
+		if (implements(callbackPose))
+			onPoseMid = env->GetMethodID(listenerClass, "onPose", "(Lcom/thalmic/myo/Myo;JLcom/thalmic/myo/Pose;)V");
+		if (implements(callbackOrientationData))
+			onOrientationDataMid = env->GetMethodID(listenerClass, "onOrientationData", "(Lcom/thalmic/myo/Myo;JLcom/thalmic/myo/Quaternion;)V");
+		if (implements(callbackAccelerometerData))
+			onAccelerometerDataMid = env->GetMethodID(listenerClass, "onAccelerometerData", "(Lcom/thalmic/myo/Myo;JLcom/thalmic/myo/Vector3;)V");
+		if (implements(callbackGyroscopeData))
+			onGyroscopeDataMid = env->GetMethodID(listenerClass, "onGyroscopeData", "(Lcom/thalmic/myo/Myo;JLcom/thalmic/myo/Vector3;)V");
+		if (implements(callbackRssi))
+			onRssiMid = env->GetMethodID(listenerClass, "onRssi", "(Lcom/thalmic/myo/Myo;JB)V");
+		if (implements(callbackBatteryLevelReceived))
+			onBatteryLevelReceivedMid = env->GetMethodID(listenerClass, "onBatteryLevelReceived", "(Lcom/thalmic/myo/Myo;JB)V");
+		if (implements(callbackEmgData))
+			onEmgDataMid = env->GetMethodID(listenerClass, "onEmgData", "(Lcom/thalmic/myo/Myo;J[B)V");
+		if (implements(callbackWarmupCompleted))
+			onWarmupCompletedMid = env->GetMethodID(listenerClass, "onWarmupCompleted", "(Lcom/thalmic/myo/Myo;JLcom/thalmic/myo/WarmupResult;)V");
+		if (implements(callbackEmgBatch))
+			onEmgBatchMid = env->GetMethodID(listenerClass, "onEmgBatch", "(Lcom/thalmic/myo/Myo;[JLjava/nio/ByteBuffer;I)V");
+		if (implements(callbackImuData)) {
+			onImuDataMid = env->GetMethodID(listenerClass, "onImuData", "(Lcom/thalmic/myo/Myo;J[F)V");
+			jfloatArray array = env->NewFloatArray(10);
+			if (array) {
+				imuArray = (jfloatArray)env->NewGlobalRef(array);
+				env->DeleteLocalRef(array);
+			}
+		}
+		if (implements(callbackOrientationRaw))
+			onOrientationRawMid = env->GetMethodID(listenerClass, "onOrientationRaw", "(Lcom/thalmic/myo/Myo;JFFFF)V");
+		if (implements(callbackOrientationEuler))
+			onOrientationEulerMid = env->GetMethodID(listenerClass, "onOrientationEuler", "(Lcom/thalmic/myo/Myo;JFFF)V");
+		if (implements(callbackAccelerometerRaw))
+			onAccelerometerRawMid = env->GetMethodID(listenerClass, "onAccelerometerRaw", "(Lcom/thalmic/myo/Myo;JFFF)V");
+		if (implements(callbackGyroscopeRaw))
+			onGyroscopeRawMid = env->GetMethodID(listenerClass, "onGyroscopeRaw", "(Lcom/thalmic/myo/Myo;JFFF)V");
+		if (implements(callbackEmgFilteredData)) {
+			onEmgFilteredDataMid = env->GetMethodID(listenerClass, "onEmgFilteredData", "(Lcom/thalmic/myo/Myo;J[F)V");
+			jfloatArray array = env->NewFloatArray(EmgFilterChain::sensors);
+			if (array) {
+				filteredArray = (jfloatArray)env->NewGlobalRef(array);
+				env->DeleteLocalRef(array);
+			}
+		}
+		if (implements(callbackEmgFilteredBatch))
+			onEmgFilteredBatchMid = env->GetMethodID(listenerClass, "onEmgFilteredBatch", "(Lcom/thalmic/myo/Myo;[J[FI)V");
+		if (implements(callbackEmgFeatures)) {
+			onEmgFeaturesMid = env->GetMethodID(listenerClass, "onEmgFeatures", "(Lcom/thalmic/myo/Myo;J[F)V");
+			jfloatArray array = env->NewFloatArray(EmgFeatureExtractor::featureCount * EmgFeatureExtractor::sensors);
+			if (array) {
+				featureArray = (jfloatArray)env->NewGlobalRef(array);
+				env->DeleteLocalRef(array);
+			}
+		}
+
+	}
+
+	~ListenerWrapper() {
+		JNIEnv *env = getJNIEnv();
+
+		releaseEmgBatches(env);
+		releaseFilteredEmgBatches(env);
+		if (filteredArray) {
+			env->DeleteGlobalRef(filteredArray);
+		}
+		if (imuArray) {
+			env->DeleteGlobalRef(imuArray);
+		}
+		if (featureArray) {
+			env->DeleteGlobalRef(featureArray);
+		}
+
+		env->DeleteGlobalRef(listenerClass);
+		env->DeleteGlobalRef(jlistener);
+	}
+
+	//Only the event types that reach an implemented callback. EMG batches are flushed, and EMG features start over,
+	//on unpair and disconnect.
+	uint32_t eventMask() const override {
+		const uint32_t emgBatchCallbacks = callbackEmgBatch | callbackEmgFilteredBatch | callbackEmgFeatures;
+		const uint32_t imuCallbacks = callbackOrientationData | callbackAccelerometerData | callbackGyroscopeData |
+			callbackImuData | callbackOrientationRaw | callbackAccelerometerRaw | callbackGyroscopeRaw | callbackOrientationEuler;
+		uint32_t mask = 0;
+		if (implements(callbackPair))
+			mask |= eventBit(libmyo_event_paired);
+		if (implements(callbackUnpair | emgBatchCallbacks))
+			mask |= eventBit(libmyo_event_unpaired);
+		if (implements(callbackConnect))
+			mask |= eventBit(libmyo_event_connected);
+		if (implements(callbackDisconnect | emgBatchCallbacks))
+			mask |= eventBit(libmyo_event_disconnected);
+		if (implements(callbackArmSync))
+			mask |= eventBit(libmyo_event_arm_synced);
+		if (implements(callbackArmUnsync))
+			mask |= eventBit(libmyo_event_arm_unsynced);
+		if (implements(callbackUnlock))
+			mask |= eventBit(libmyo_event_unlocked);
+		if (implements(callbackLock))
+			mask |= eventBit(libmyo_event_locked);
+		if (implements(callbackPose))
+			mask |= eventBit(libmyo_event_pose);
+		if (implements(imuCallbacks))
+			mask |= eventBit(libmyo_event_orientation);
+		if (implements(callbackRssi))
+			mask |= eventBit(libmyo_event_rssi);
+		if (implements(callbackBatteryLevelReceived))
+			mask |= eventBit(libmyo_event_battery_level);
+		if (implements(callbackEmgData | callbackEmgFilteredData | emgBatchCallbacks))
+			mask |= eventBit(libmyo_event_emg);
+		if (implements(callbackWarmupCompleted))
+			mask |= eventBit(libmyo_event_warmup_completed);
+		return mask;
+	}
+
+	jobject createMyo(JNIEnv *env, myo::Myo *myo) {
+		return peers->get(env, myo);
+	}
+	jobject createFirmwareVersion(JNIEnv *env, myo::FirmwareVersion firmwareVersion) {
+		jobject fv = env->NewObject(jniCache.firmwareVersionClass, jniCache.firmwareVersionConstructor);
+
+		if (env->ExceptionCheck() == JNI_TRUE) {
+			std::cerr << "Exception when creating FirmwareVersion object" << std::endl;
+			env->ExceptionDescribe();
+			return nullptr;
+		}
+
+		env->SetIntField(fv, jniCache.fvMajorFid, firmwareVersion.firmwareVersionMajor);
+		env->SetIntField(fv, jniCache.fvMinorFid, firmwareVersion.firmwareVersionMinor);
+		env->SetIntField(fv, jniCache.fvPatchFid, firmwareVersion.firmwareVersionPatch);
+		env->SetIntField(fv, jniCache.fvHardwareRevFid, firmwareVersion.firmwareVersionHardwareRev);
+
+		if (env->ExceptionCheck() == JNI_TRUE) {
+			std::cerr << "Exception when setting fields for FirmwareVersion object" << std::endl;
+			env->ExceptionDescribe();
+			return nullptr;
+		}
+		return fv;
+	}
+	jobject createQuaternion(JNIEnv *env, const myo::Quaternion<float> *q) {
+		jobject quatObject = env->NewObject(jniCache.quaternionClass, jniCache.quaternionConstructor,
+			static_cast<jdouble>(q->x()), static_cast<jdouble>(q->y()), static_cast<jdouble>(q->z()), static_cast<jdouble>(q->w()));
+		if (env->ExceptionCheck() == JNI_TRUE) {
+			std::cerr << "Exception when creating Quaternion object" << std::endl;
+			env->ExceptionDescribe();
+			return nullptr;
+		}
+
+		return quatObject;
+	}
+	jobject createVector3(JNIEnv *env, const myo::Vector3<float> *v) {
+		jobject vecObject = env->NewObject(jniCache.vector3Class, jniCache.vector3Constructor,
+			static_cast<jdouble>(v->x()), static_cast<jdouble>(v->y()), static_cast<jdouble>(v->z()));
+		if (env->ExceptionCheck() == JNI_TRUE) {
+			std::cerr << "Exception when creating Vector3 object" << std::endl;
+			env->ExceptionDescribe();
+			return nullptr;
+		}
+
+		return vecObject;
+	}
+
+	//Returns the batch for the Myo, allocating the buffers the first time the Myo sends EMG data.
+	EmgBatch* getEmgBatch(JNIEnv *env, myo::Myo *myo) {
+		auto it = emgBatches.find(myo);
+		if (it != emgBatches.end()) {
+			return &it->second;
+		}
+
+		EmgBatch batch;
+		batch.samples = new int8_t[emgBatchFrames * 8];
+		batch.timestamps = new jlong[emgBatchFrames];
+		batch.count = 0;
+		jobject buffer = env->NewDirectByteBuffer(batch.samples, emgBatchFrames * 8);
+		jlongArray array = env->NewLongArray(emgBatchFrames);
+		if (!buffer || !array) {
+			std::cerr << "Exception when creating EMG batch buffers" << std::endl;
+			env->ExceptionDescribe();
+			delete[] batch.samples;
+			delete[] batch.timestamps;
+			return nullptr;
+		}
+		batch.sampleBuffer = env->NewGlobalRef(buffer);
+		batch.timestampArray = (jlongArray)env->NewGlobalRef(array);
+		env->DeleteLocalRef(buffer);
+		env->DeleteLocalRef(array);
+
+		return &emgBatches.emplace(myo, batch).first->second;
+	}
+
+	//Delivers the frames accumulated for the Myo, if there are any.
+	void flushEmgBatch(JNIEnv *env, myo::Myo *myo, EmgBatch *batch) {
+		if (batch->count == 0) {
+			return;
+		}
+		jobject myoObject = createMyo(env, myo);
+		env->SetLongArrayRegion(batch->timestampArray, 0, batch->count, batch->timestamps);
+		//The listener may have moved the position or limit of the buffer during the previous batch
+		env->DeleteLocalRef(env->CallObjectMethod(batch->sampleBuffer, jniCache.bufferClearMid));
+		JNI_CHECK_EXCEPT(env);
+
+		jint count = batch->count;
+		batch->count = 0;
+		env->CallVoidMethod(jlistener, onEmgBatchMid, myoObject, batch->timestampArray, batch->sampleBuffer, count);
+	}
+
+	void flushEmgBatches(JNIEnv *env) {
+		for (auto &entry : emgBatches) {
+			flushEmgBatch(env, entry.first, &entry.second);
+		}
+	}
+
+	void flushEmgBatch(JNIEnv *env, myo::Myo *myo) {
+		auto it = emgBatches.find(myo);
+		if (it != emgBatches.end()) {
+			flushEmgBatch(env, myo, &it->second);
+		}
+	}
+
+	void releaseEmgBatches(JNIEnv *env) {
+		for (auto &entry : emgBatches) {
+			env->DeleteGlobalRef(entry.second.sampleBuffer);
+			env->DeleteGlobalRef(entry.second.timestampArray);
+			delete[] entry.second.samples;
+			delete[] entry.second.timestamps;
+		}
+		emgBatches.clear();
+	}
+
+	//Same as getEmgBatch(), for filtered frames.
+	FilteredEmgBatch* getFilteredEmgBatch(JNIEnv *env, myo::Myo *myo) {
+		auto it = filteredEmgBatches.find(myo);
+		if (it != filteredEmgBatches.end()) {
+			return &it->second;
+		}
+
+		FilteredEmgBatch batch;
+		batch.samples = new float[emgBatchFrames * 8];
+		batch.timestamps = new jlong[emgBatchFrames];
+		batch.count = 0;
+		jfloatArray samples = env->NewFloatArray(emgBatchFrames * 8);
+		jlongArray timestamps = env->NewLongArray(emgBatchFrames);
+		if (!samples || !timestamps) {
+			std::cerr << "Exception when creating filtered EMG batch arrays" << std::endl;
+			env->ExceptionDescribe();
+			delete[] batch.samples;
+			delete[] batch.timestamps;
+			return nullptr;
+		}
+		batch.sampleArray = (jfloatArray)env->NewGlobalRef(samples);
+		batch.timestampArray = (jlongArray)env->NewGlobalRef(timestamps);
+		env->DeleteLocalRef(samples);
+		env->DeleteLocalRef(timestamps);
+
+		return &filteredEmgBatches.emplace(myo, batch).first->second;
+	}
+
+	void flushFilteredEmgBatch(JNIEnv *env, myo::Myo *myo, FilteredEmgBatch *batch) {
+		if (batch->count == 0) {
+			return;
+		}
+		jobject myoObject = createMyo(env, myo);
+		env->SetLongArrayRegion(batch->timestampArray, 0, batch->count, batch->timestamps);
+		env->SetFloatArrayRegion(batch->sampleArray, 0, batch->count * 8, batch->samples);
+
+		jint count = batch->count;
+		batch->count = 0;
+		env->CallVoidMethod(jlistener, onEmgFilteredBatchMid, myoObject, batch->timestampArray, batch->sampleArray, count);
+	}
+
+	void flushFilteredEmgBatches(JNIEnv *env) {
+		for (auto &entry : filteredEmgBatches) {
+			flushFilteredEmgBatch(env, entry.first, &entry.second);
+		}
+	}
+
+	void flushFilteredEmgBatch(JNIEnv *env, myo::Myo *myo) {
+		auto it = filteredEmgBatches.find(myo);
+		if (it != filteredEmgBatches.end()) {
+			flushFilteredEmgBatch(env, myo, &it->second);
+		}
+	}
+
+	void releaseFilteredEmgBatches(JNIEnv *env) {
+		for (auto &entry : filteredEmgBatches) {
+			env->DeleteGlobalRef(entry.second.sampleArray);
+			env->DeleteGlobalRef(entry.second.timestampArray);
+			delete[] entry.second.samples;
+			delete[] entry.second.timestamps;
+		}
+		filteredEmgBatches.clear();
+	}
+
+	//Delivers the frames of all raw and filtered batches. Dispatching thread only.
+	void flushAllEmgBatches(JNIEnv *env) {
+		applyEmgBatching(env);
+		flushBatches(env);
+	}
+
+	void flushBatches(JNIEnv *env) {
+		if (implements(callbackEmgBatch)) {
+			flushEmgBatches(env);
+		}
+		if (implements(callbackEmgFilteredBatch)) {
+			flushFilteredEmgBatches(env);
+		}
+	}
+
+	//Can be called from any thread. The batches belong to the dispatching thread, which may be in the middle of
+	//filling one, so the new parameters are only handed over here and applied by applyEmgBatching().
+	void setEmgBatching(jint maxFrames, jint maxLatencyMs) {
+		std::lock_guard<std::mutex> lock(settingsMutex);
+		pendingEmgBatchFrames = maxFrames;
+		pendingEmgBatchLatencyUs = static_cast<uint64_t>(maxLatencyMs) * 1000;
+		emgBatchingChanged.store(true, std::memory_order_release);
+	}
+
+	//Dispatching thread only. Takes over batching parameters set since the last call; pending frames are delivered
+	//before the batches are reallocated with the new size.
+	void applyEmgBatching(JNIEnv *env) {
+		if (!emgBatchingChanged.load(std::memory_order_acquire)) {
+			return;
+		}
+		jint frames;
+		uint64_t latencyUs;
+		{
+			std::lock_guard<std::mutex> lock(settingsMutex);
+			frames = pendingEmgBatchFrames;
+			latencyUs = pendingEmgBatchLatencyUs;
+			emgBatchingChanged.store(false, std::memory_order_relaxed);
+		}
+		LocalFrame frame(env);
+		flushBatches(env);
+		releaseEmgBatches(env);
+		releaseFilteredEmgBatches(env);
+		emgBatchFrames = frames;
+		emgBatchLatencyUs = latencyUs;
+	}
+
+	//Age of a batch at the time, which is negative if the time is older than its first frame. Events of different
+	//Myos aren't in timestamp order, so this has to be signed.
+	static jlong batchAge(const jlong *timestamps, uint64_t time) {
+		return static_cast<jlong>(time) - timestamps[0];
+	}
+
+	//Batches are due once their oldest frame is emgBatchLatencyUs old on the hub's clock, even if their Myo has gone
+	//quiet since.
+	bool wantsTicks() const override {
+		return implements(callbackEmgBatch | callbackEmgFilteredBatch);
+	}
+
+	bool wantsOrientationEuler() const override {
+		return implements(callbackOrientationEuler);
+	}
+
+	void onTick(uint64_t now) override {
+		JNIEnv *env = getJNIEnv();
+		applyEmgBatching(env);
+		LocalFrame frame(env);
+		if (implements(callbackEmgBatch)) {
+			for (auto &entry : emgBatches) {
+				EmgBatch &batch = entry.second;
+				if (batch.count > 0 && batchAge(batch.timestamps, now) >= static_cast<jlong>(emgBatchLatencyUs)) {
+					flushEmgBatch(env, entry.first, &batch);
+					JNI_CHECK_EXCEPT(env);
+				}
+			}
+		}
+		if (implements(callbackEmgFilteredBatch)) {
+			for (auto &entry : filteredEmgBatches) {
+				FilteredEmgBatch &batch = entry.second;
+				if (batch.count > 0 && batchAge(batch.timestamps, now) >= static_cast<jlong>(emgBatchLatencyUs)) {
+					flushFilteredEmgBatch(env, entry.first, &batch);
+					JNI_CHECK_EXCEPT(env);
+				}
+			}
+		}
+	}
+
+	//Feeds the frame to the extractor of the Myo, and delivers its features if they are due.
+	void extractEmgFeatures(myo::Myo *myo, uint64_t timestamp, const int8_t *emg) {
+		applyEmgFeatures();
+		auto it = emgFeatures.find(myo);
+		if (it == emgFeatures.end()) {
+			it = emgFeatures.emplace(myo, std::unique_ptr<EmgFeatureExtractor>(new EmgFeatureExtractor(emgFeatureWindow, emgFeatureHop))).first;
+		}
+		if (!it->second->push(emg) || !featureArray) {
+			return;
+		}
+		float features[EmgFeatureExtractor::featureCount * EmgFeatureExtractor::sensors];
+		it->second->features(features);
+
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+		env->SetFloatArrayRegion(featureArray, 0, EmgFeatureExtractor::featureCount * EmgFeatureExtractor::sensors, features);
+
+		env->CallVoidMethod(jlistener, onEmgFeaturesMid, myoObject, time, featureArray);
+	}
+
+	//Can be called from any thread. The extractors belong to the dispatching thread, so the new parameters are only
+	//handed over here and applied by applyEmgFeatures().
+	void setEmgFeatures(jint windowFrames, jint hopFrames) {
+		std::lock_guard<std::mutex> lock(settingsMutex);
+		pendingEmgFeatureWindow = windowFrames;
+		pendingEmgFeatureHop = hopFrames;
+		emgFeaturesChanged.store(true, std::memory_order_release);
+	}
+
+	//Dispatching thread only. Takes over feature parameters set since the last call. Windows in progress are
+	//dropped, since they were collected with the old parameters.
+	void applyEmgFeatures() {
+		if (!emgFeaturesChanged.load(std::memory_order_acquire)) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(settingsMutex);
+		emgFeatureWindow = pendingEmgFeatureWindow;
+		emgFeatureHop = pendingEmgFeatureHop;
+		emgFeaturesChanged.store(false, std::memory_order_relaxed);
+		emgFeatures.clear();
+	}
+
+	void onPair(myo::Myo *myo, uint64_t timestamp, myo::FirmwareVersion firmwareVersion) override {
+		if (!implements(callbackPair)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+		jobject fv = createFirmwareVersion(env, firmwareVersion);
+
+		env->CallVoidMethod(jlistener, onPairMid, myoObject, time, fv);
+	}
+
+	void onUnpair(myo::Myo *myo, uint64_t timestamp) override {
+		if (implements(callbackEmgBatch)) {
+			flushEmgBatch(getJNIEnv(), myo);
+		}
+		if (implements(callbackEmgFilteredBatch)) {
+			flushFilteredEmgBatch(getJNIEnv(), myo);
+		}
+		emgFeatures.erase(myo);
+		if (!implements(callbackUnpair)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+
+		env->CallVoidMethod(jlistener, onUnpairMid, myoObject, time);
+	}
+
+	void onConnect(myo::Myo *myo, uint64_t timestamp, myo::FirmwareVersion firmwareVersion) override {
+		if (!implements(callbackConnect)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+		jobject fv = createFirmwareVersion(env, firmwareVersion);
+
+		env->CallVoidMethod(jlistener, onConnectMid, myoObject, time, fv);
+	}
+
+	void onDisconnect(myo::Myo *myo, uint64_t timestamp) override {
+		if (implements(callbackEmgBatch)) {
+			flushEmgBatch(getJNIEnv(), myo);
+		}
+		if (implements(callbackEmgFilteredBatch)) {
+			flushFilteredEmgBatch(getJNIEnv(), myo);
+		}
+		emgFeatures.erase(myo);
+		if (!implements(callbackDisconnect)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+
+		env->CallVoidMethod(jlistener, onDisconnectMid, myoObject, time);
+	}
+
+	void onArmSync(myo::Myo *myo, uint64_t timestamp, myo::Arm arm, myo::XDirection xDirection, float rotation, myo::WarmupState warmupState) override {
+		if (!implements(callbackArmSync)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+
+		jobject armEnum = jniCache.arm(arm);
+		jobject xDirectionEnum = jniCache.xDirection(xDirection);
+		jfloat jRotation = rotation;
+		jobject warmupStateEnum = jniCache.warmupState(warmupState);
+
+		env->CallVoidMethod(jlistener, onArmSyncMid, myoObject, time, armEnum, xDirectionEnum, jRotation, warmupStateEnum);
+	}
+
+	void onArmUnsync(myo::Myo *myo, uint64_t timestamp) override {
+		if (!implements(callbackArmUnsync)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+
+		env->CallVoidMethod(jlistener, onArmUnsyncMid, myoObject, time);
+	}
+
+	void onLock(myo::Myo *myo, uint64_t timestamp) override {
+		if (!implements(callbackLock)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+
+		env->CallVoidMethod(jlistener, onLockMid, myoObject, time);
+	}
+
+	void onUnlock(myo::Myo *myo, uint64_t timestamp) override {
+		if (!implements(callbackUnlock)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+
+		env->CallVoidMethod(jlistener, onUnlockMid, myoObject, time);
+	}
+
+	void onPose(myo::Myo *myo, uint64_t timestamp, myo::Pose pose) override {
+		if (!implements(callbackPose)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+
+		jobject poseEnum = jniCache.pose(pose.type());
+
+		env->CallVoidMethod(jlistener, onPoseMid, myoObject, time, poseEnum);
+	}
+
+	void onImuData(myo::Myo *myo, uint64_t timestamp, const float *imu) override {
+		if ((implements(callbackImuData) && imuArray) || implements(callbackOrientationRaw) || implements(callbackAccelerometerRaw) || implements(callbackGyroscopeRaw)) {
+			JNIEnv *env = getJNIEnv();
+			LocalFrame frame(env);
+			jobject myoObject = createMyo(env, myo);
+			jlong time = (jlong)timestamp;
+
+			if (implements(callbackImuData) && imuArray) {
+				env->SetFloatArrayRegion(imuArray, 0, 10, imu);
+				env->CallVoidMethod(jlistener, onImuDataMid, myoObject, time, imuArray);
+			}
+			//The raw callbacks take floats, which are passed through jvalues to keep them from being widened
+			jvalue args[6];
+			args[0].l = myoObject;
+			args[1].j = time;
+			if (implements(callbackOrientationRaw)) {
+				for (int i = 0; i < 4; i++) {
+					args[2 + i].f = imu[i];
+				}
+				env->CallVoidMethodA(jlistener, onOrientationRawMid, args);
+			}
+			if (implements(callbackAccelerometerRaw)) {
+				for (int i = 0; i < 3; i++) {
+					args[2 + i].f = imu[4 + i];
+				}
+				env->CallVoidMethodA(jlistener, onAccelerometerRawMid, args);
+			}
+			if (implements(callbackGyroscopeRaw)) {
+				for (int i = 0; i < 3; i++) {
+					args[2 + i].f = imu[7 + i];
+				}
+				env->CallVoidMethodA(jlistener, onGyroscopeRawMid, args);
+			}
+		}
+		//Skip building the Quaternion and Vector3s if nobody wants them
+		if (implements(callbackOrientationData) || implements(callbackAccelerometerData) || implements(callbackGyroscopeData)) {
+			EventListener::onImuData(myo, timestamp, imu);
+		}
+	}
+
+	void onOrientationEuler(myo::Myo *myo, uint64_t timestamp, const float *angles) override {
+		if (!implements(callbackOrientationEuler)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		//Floats go through jvalues, as in onImuData()
+		jvalue args[5];
+		args[0].l = createMyo(env, myo);
+		args[1].j = (jlong)timestamp;
+		for (int i = 0; i < OrientationProcessor::angleCount; i++) {
+			args[2 + i].f = angles[i];
+		}
+
+		env->CallVoidMethodA(jlistener, onOrientationEulerMid, args);
+	}
+
+	void onOrientationData(myo::Myo *myo, uint64_t timestamp, const myo::Quaternion<float> &orientation) override {
+		if (!implements(callbackOrientationData)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+		jobject quatObject = createQuaternion(env, &orientation);
+
+		env->CallVoidMethod(jlistener, onOrientationDataMid, myoObject, time, quatObject);
+	}
+
+	void onAccelerometerData(myo::Myo *myo, uint64_t timestamp, const myo::Vector3<float> &accel) override {
+		if (!implements(callbackAccelerometerData)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+		jobject vecObject = createVector3(env, &accel);
+
+		env->CallVoidMethod(jlistener, onAccelerometerDataMid, myoObject, time, vecObject);
+	}
+
+	void onGyroscopeData(myo::Myo *myo, uint64_t timestamp, const myo::Vector3<float> &gyro) override {
+		if (!implements(callbackGyroscopeData)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+		jobject vecObject = createVector3(env, &gyro);
+
+		env->CallVoidMethod(jlistener, onGyroscopeDataMid, myoObject, time, vecObject);
+	}
+
+	void onRssi(myo::Myo *myo, uint64_t timestamp, int8_t rssi) override {
+		if (!implements(callbackRssi)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+		jbyte jRssi = static_cast<jbyte>(rssi);
+
+		env->CallVoidMethod(jlistener, onRssiMid, myoObject, time, jRssi);
+	}
+
+	void onBatteryLevelReceived(myo::Myo *myo, uint64_t timestamp, uint8_t batteryLevel) override {
+		if (!implements(callbackBatteryLevelReceived)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+		jbyte jBattLevel = static_cast<jbyte>(batteryLevel);
+
+		env->CallVoidMethod(jlistener, onBatteryLevelReceivedMid, myoObject, time, jBattLevel);
+	}
+
+	void onEmgData(myo::Myo *myo, uint64_t timestamp, const int8_t *emg) override {
+		if (implements(callbackEmgBatch)) {
+			JNIEnv *env = getJNIEnv();
+			applyEmgBatching(env);
+			LocalFrame frame(env);
+			EmgBatch *batch = getEmgBatch(env, myo);
+			if (batch) {
+				memcpy(batch->samples + batch->count * 8, emg, 8);
+				batch->timestamps[batch->count++] = (jlong)timestamp;
+				if (batch->count == emgBatchFrames || batchAge(batch->timestamps, timestamp) >= static_cast<jlong>(emgBatchLatencyUs)) {
+					flushEmgBatch(env, myo, batch);
+				}
+			}
+		}
+		if (implements(callbackEmgFeatures)) {
+			extractEmgFeatures(myo, timestamp, emg);
+		}
+		if (!implements(callbackEmgData)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+
+		jbyteArray emgArray = env->NewByteArray(8);
+		env->SetByteArrayRegion(emgArray, 0, 8, emg);
+
+		env->CallVoidMethod(jlistener, onEmgDataMid, myoObject, time, emgArray);
+	}
+
+	void onEmgFiltered(myo::Myo *myo, uint64_t timestamp, const float *emg) override {
+		if (implements(callbackEmgFilteredBatch)) {
+			JNIEnv *env = getJNIEnv();
+			applyEmgBatching(env);
+			LocalFrame frame(env);
+			FilteredEmgBatch *batch = getFilteredEmgBatch(env, myo);
+			if (batch) {
+				memcpy(batch->samples + batch->count * 8, emg, 8 * sizeof(float));
+				batch->timestamps[batch->count++] = (jlong)timestamp;
+				if (batch->count == emgBatchFrames || batchAge(batch->timestamps, timestamp) >= static_cast<jlong>(emgBatchLatencyUs)) {
+					flushFilteredEmgBatch(env, myo, batch);
+				}
+			}
+		}
+		if (!implements(callbackEmgFilteredData) || !filteredArray) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+		env->SetFloatArrayRegion(filteredArray, 0, EmgFilterChain::sensors, emg);
+
+		env->CallVoidMethod(jlistener, onEmgFilteredDataMid, myoObject, time, filteredArray);
+	}
+
+	void onWarmupCompleted(myo::Myo *myo, uint64_t timestamp, myo::WarmupResult warmupResult) override {
+		if (!implements(callbackWarmupCompleted)) {
+			return;
+		}
+		JNIEnv *env = getJNIEnv();
+		LocalFrame frame(env);
+		jobject myoObject = createMyo(env, myo);
+		jlong time = (jlong)timestamp;
+
+		jobject warmupResultEnum = jniCache.warmupResult(warmupResult);
+
+		env->CallVoidMethod(jlistener, onWarmupCompletedMid, myoObject, time, warmupResultEnum);
+	}
+};
+
+//The native Myos of the Java Myo addresses that a listener is limited to; see Hub.addListener(DeviceListener, Myo...)
+inline std::vector<myo::Myo*> toMyos(JNIEnv *env, jlongArray addresses) {
+	std::vector<myo::Myo*> myos;
+	if (!addresses) {
+		return myos;
+	}
+	jsize count = env->GetArrayLength(addresses);
+	myos.resize(count);
+	std::vector<jlong> values(count);
+	env->GetLongArrayRegion(addresses, 0, count, values.data());
+	for (jsize i = 0; i < count; i++) {
+		myos[i] = reinterpret_cast<myo::Myo*>(values[i]);
+	}
+	return myos;
+}
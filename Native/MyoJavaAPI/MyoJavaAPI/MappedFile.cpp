@@ -0,0 +1,85 @@
+#include "MappedFile.h"
+#include <stdexcept>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const string &path) : address(nullptr), length(0) {
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw runtime_error("Cannot open " + path);
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || static_cast<unsigned long long>(size.QuadPart) > SIZE_MAX) {
+		CloseHandle(file);
+		throw runtime_error("Cannot map " + path);
+	}
+	length = static_cast<size_t>(size.QuadPart);
+	if (length == 0) {
+		//Empty files can't be mapped
+		CloseHandle(file);
+		return;
+	}
+	//The view keeps the file open by itself
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping) {
+		throw runtime_error("Cannot map " + path);
+	}
+	address = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	CloseHandle(mapping);
+	if (!address) {
+		throw runtime_error("Cannot map " + path);
+	}
+}
+
+MappedFile::~MappedFile() {
+	if (address) {
+		UnmapViewOfFile(address);
+	}
+}
+
+#else
+
+MappedFile::MappedFile(const string &path) : address(nullptr), length(0) {
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		throw runtime_error("Cannot open " + path);
+	}
+	struct stat status;
+	if (fstat(file, &status) != 0) {
+		close(file);
+		throw runtime_error("Cannot map " + path);
+	}
+	length = static_cast<size_t>(status.st_size);
+	if (length == 0) {
+		//Empty files can't be mapped
+		close(file);
+		return;
+	}
+	//The mapping keeps the file open by itself
+	void *mapped = mmap(nullptr, length, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if (mapped == MAP_FAILED) {
+		throw runtime_error("Cannot map " + path);
+	}
+	address = static_cast<const uint8_t*>(mapped);
+}
+
+MappedFile::~MappedFile() {
+	if (address) {
+		munmap(const_cast<uint8_t*>(address), length);
+	}
+}
+
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*
+ * A whole file mapped read-only into memory.
+ *
+ * The pages are only read in from disk as they are touched, and are shared with the OS file cache, so even large
+ * session logs can be read without copying them into the process first.
+ */
+class MappedFile {
+
+public:
+	//Maps the file. Throws a runtime_error if it can't be opened or mapped.
+	explicit MappedFile(const std::string &path);
+	~MappedFile();
+
+	//nullptr for an empty file
+	const uint8_t* data() const {
+		return address;
+	}
+	size_t size() const {
+		return length;
+	}
+
+private:
+	const uint8_t *address;
+	size_t length;
+
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+};
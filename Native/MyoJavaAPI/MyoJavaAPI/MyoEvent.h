@@ -0,0 +1,227 @@
+#pragma once
+#include <cstdint>
+#include <myo/myo.hpp>
+
+/*
+ * A libmyo event, decoded into plain data.
+ *
+ * libmyo_event_t handles are only valid inside the libmyo_run() handler, so anything that keeps events around
+ * (the async queue, for one) stores them in this form instead. The layout is fixed at 64 bytes so that a record
+ * can be copied as-is into a Java EventBuffer; see EventBuffer.java for the Java side of the layout.
+ */
+struct MyoEvent {
+	uint32_t type; //libmyo_event_type_t
+	uint32_t reserved;
+	uint64_t timestamp;
+	//Address of the native Myo. Stored as an integer so the layout is the same on 32 and 64 bit.
+	uint64_t myoAddress;
+	union Data {
+		//libmyo_event_paired, libmyo_event_connected: major, minor, patch, hardware revision
+		uint32_t firmwareVersion[4];
+		//libmyo_event_arm_synced
+		struct {
+			int32_t arm;
+			int32_t xDirection;
+			float rotation;
+			int32_t warmupState;
+		} armSync;
+		//libmyo_event_orientation: quaternion x, y, z, w, then accelerometer x, y, z, then gyroscope x, y, z
+		float imu[10];
+		int32_t pose;
+		int8_t rssi;
+		uint8_t batteryLevel;
+		int8_t emg[8];
+		int32_t warmupResult;
+	} data;
+
+	myo::Myo* myo() const {
+		return reinterpret_cast<myo::Myo*>(static_cast<uintptr_t>(myoAddress));
+	}
+};
+
+static_assert(sizeof(MyoEvent) == 64, "MyoEvent must match the Java EventBuffer record size");
+
+//Number of libmyo event types; MyoEvent::type is always less than this.
+const int numEventTypes = libmyo_event_warmup_completed + 1;
+
+//The bit of an event type in an event mask; see EventListener::eventMask()
+inline uint32_t eventBit(libmyo_event_type_t type) {
+	return 1u << type;
+}
+const uint32_t allEventTypes = (1u << numEventTypes) - 1;
+
+//Fills in decoded from a libmyo event belonging to myo.
+inline void decodeEvent(libmyo_event_t event, myo::Myo *myo, MyoEvent &decoded) {
+	decoded.type = libmyo_event_get_type(event);
+	decoded.reserved = 0;
+	decoded.timestamp = libmyo_event_get_timestamp(event);
+	decoded.myoAddress = reinterpret_cast<uintptr_t>(myo);
+	decoded.data = {};
+
+	switch (decoded.type) {
+	case libmyo_event_paired:
+	case libmyo_event_connected:
+		decoded.data.firmwareVersion[0] = libmyo_event_get_firmware_version(event, libmyo_version_major);
+		decoded.data.firmwareVersion[1] = libmyo_event_get_firmware_version(event, libmyo_version_minor);
+		decoded.data.firmwareVersion[2] = libmyo_event_get_firmware_version(event, libmyo_version_patch);
+		decoded.data.firmwareVersion[3] = libmyo_event_get_firmware_version(event, libmyo_version_hardware_rev);
+		break;
+	case libmyo_event_arm_synced:
+		decoded.data.armSync.arm = libmyo_event_get_arm(event);
+		decoded.data.armSync.xDirection = libmyo_event_get_x_direction(event);
+		decoded.data.armSync.rotation = libmyo_event_get_rotation_on_arm(event);
+		decoded.data.armSync.warmupState = libmyo_event_get_warmup_state(event);
+		break;
+	case libmyo_event_orientation:
+		for (int i = 0; i < 4; i++) {
+			decoded.data.imu[i] = libmyo_event_get_orientation(event, static_cast<libmyo_orientation_index>(i));
+		}
+		for (unsigned int i = 0; i < 3; i++) {
+			decoded.data.imu[4 + i] = libmyo_event_get_accelerometer(event, i);
+			decoded.data.imu[7 + i] = libmyo_event_get_gyroscope(event, i);
+		}
+		break;
+	case libmyo_event_pose:
+		decoded.data.pose = libmyo_event_get_pose(event);
+		break;
+	case libmyo_event_rssi:
+		decoded.data.rssi = libmyo_event_get_rssi(event);
+		break;
+	case libmyo_event_battery_level:
+		decoded.data.batteryLevel = libmyo_event_get_battery_level(event);
+		break;
+	case libmyo_event_emg:
+		for (unsigned int i = 0; i < 8; i++) {
+			decoded.data.emg[i] = libmyo_event_get_emg(event, i);
+		}
+		break;
+	case libmyo_event_warmup_completed:
+		decoded.data.warmupResult = libmyo_event_get_warmup_result(event);
+		break;
+	}
+}
+
+/*
+ * A DeviceListener with callbacks that the C++ DeviceListener doesn't have.
+ *
+ * libmyo delivers orientation, accelerometer and gyroscope data in a single event. onImuData() gets all of it at
+ * once: x, y, z, w of the orientation, then x, y, z of the accelerometer, then x, y, z of the gyroscope. By default
+ * it splits the frame into the three DeviceListener calls, just like Hub::onDeviceEvent() does.
+ */
+class EventListener : public myo::DeviceListener {
+
+public:
+	//The event types this listener handles, as a combination of eventBit()s. Events of other types may never reach
+	//it (see EventDispatcher). Must not change while the listener is added to a hub.
+	virtual uint32_t eventMask() const {
+		return allEventTypes;
+	}
+
+	//Whether the listener gets onTick(). Must not change while the listener is added to a hub.
+	virtual bool wantsTicks() const {
+		return false;
+	}
+	//Called on the dispatching thread after every event the hub dispatches, whether or not it reached this
+	//listener, and when the hub's run() or runOnce() returns. now is the time on the hub's clock, which is the
+	//clock of event timestamps, in microseconds. Lets a listener act on deadlines while its Myos are quiet.
+	virtual void onTick(uint64_t /*now*/) {
+	}
+
+	//Whether the listener wants onOrientationEuler(). The hub only works out the angles of an orientation event if
+	//a listener that gets the event does. Must not change while the listener is added to a hub.
+	virtual bool wantsOrientationEuler() const {
+		return false;
+	}
+
+	virtual void onImuData(myo::Myo *myo, uint64_t timestamp, const float *imu) {
+		onOrientationData(myo, timestamp, myo::Quaternion<float>(imu[0], imu[1], imu[2], imu[3]));
+		onAccelerometerData(myo, timestamp, myo::Vector3<float>(imu[4], imu[5], imu[6]));
+		onGyroscopeData(myo, timestamp, myo::Vector3<float>(imu[7], imu[8], imu[9]));
+	}
+
+	//Called right after onEmgData() with the same frame passed through the EMG filter of the Myo, if it has one.
+	virtual void onEmgFiltered(myo::Myo * /*myo*/, uint64_t /*timestamp*/, const float * /*emg*/) {
+	}
+
+	//Called right after onImuData() with the roll, pitch and yaw of the orientation (see OrientationProcessor), if
+	//wantsOrientationEuler().
+	virtual void onOrientationEuler(myo::Myo * /*myo*/, uint64_t /*timestamp*/, const float * /*angles*/) {
+	}
+};
+
+//What the hub derives from an event before dispatching it (see MyoProcessing); nullptr where there is nothing.
+struct DerivedData {
+	//Of libmyo_event_emg, if the Myo has an EMG filter
+	const float *filteredEmg;
+	//Of libmyo_event_orientation: roll, pitch and yaw
+	const float *eulerAngles;
+};
+
+//Calls the listener method for a decoded event, the same way Hub::onDeviceEvent() does for a libmyo event.
+//derived is what the hub derived from the event, if anything.
+inline void dispatchEvent(const MyoEvent &event, EventListener *listener, const DerivedData &derived = DerivedData()) {
+	using namespace myo;
+	Myo *myo = event.myo();
+	uint64_t time = event.timestamp;
+
+	switch (event.type) {
+	case libmyo_event_paired: {
+		FirmwareVersion version = { event.data.firmwareVersion[0], event.data.firmwareVersion[1],
+			event.data.firmwareVersion[2], event.data.firmwareVersion[3] };
+		listener->onPair(myo, time, version);
+		break;
+	}
+	case libmyo_event_unpaired:
+		listener->onUnpair(myo, time);
+		break;
+	case libmyo_event_connected: {
+		FirmwareVersion version = { event.data.firmwareVersion[0], event.data.firmwareVersion[1],
+			event.data.firmwareVersion[2], event.data.firmwareVersion[3] };
+		listener->onConnect(myo, time, version);
+		break;
+	}
+	case libmyo_event_disconnected:
+		listener->onDisconnect(myo, time);
+		break;
+	case libmyo_event_arm_synced:
+		listener->onArmSync(myo, time,
+			static_cast<Arm>(event.data.armSync.arm),
+			static_cast<XDirection>(event.data.armSync.xDirection),
+			event.data.armSync.rotation,
+			static_cast<WarmupState>(event.data.armSync.warmupState));
+		break;
+	case libmyo_event_arm_unsynced:
+		listener->onArmUnsync(myo, time);
+		break;
+	case libmyo_event_unlocked:
+		listener->onUnlock(myo, time);
+		break;
+	case libmyo_event_locked:
+		listener->onLock(myo, time);
+		break;
+	case libmyo_event_orientation:
+		listener->onImuData(myo, time, event.data.imu);
+		if (derived.eulerAngles) {
+			listener->onOrientationEuler(myo, time, derived.eulerAngles);
+		}
+		break;
+	case libmyo_event_pose:
+		listener->onPose(myo, time, Pose(static_cast<Pose::Type>(event.data.pose)));
+		break;
+	case libmyo_event_rssi:
+		listener->onRssi(myo, time, event.data.rssi);
+		break;
+	case libmyo_event_battery_level:
+		listener->onBatteryLevelReceived(myo, time, event.data.batteryLevel);
+		break;
+	case libmyo_event_emg:
+		listener->onEmgData(myo, time, event.data.emg);
+		if (derived.filteredEmg) {
+			listener->onEmgFiltered(myo, time, derived.filteredEmg);
+		}
+		break;
+	case libmyo_event_warmup_completed:
+		listener->onWarmupCompleted(myo, time, static_cast<WarmupResult>(event.data.warmupResult));
+		break;
+	}
+}
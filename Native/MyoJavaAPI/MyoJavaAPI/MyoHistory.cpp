@@ -0,0 +1,152 @@
+#include "MyoHistory.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+using namespace myo;
+
+void MyoHistory::Ring::allocate(size_t recordSize, size_t records) {
+	storage.assign(recordSize * records, 0);
+	this->recordSize = recordSize;
+	slots = records;
+	clear();
+}
+
+unsigned char* MyoHistory::Ring::push() {
+	if (count < slots) {
+		return storage.data() + (oldest + count++) % slots * recordSize;
+	}
+	unsigned char *slot = storage.data() + oldest * recordSize;
+	oldest = (oldest + 1) % slots;
+	return slot;
+}
+
+uint64_t MyoHistory::Ring::timestamp(size_t i) const {
+	//Both record types start with the timestamp
+	uint64_t time;
+	memcpy(&time, slot(i), sizeof(time));
+	return time;
+}
+
+size_t MyoHistory::Ring::firstAfter(uint64_t time) const {
+	//Records are in the order they were decoded, which is timestamp order for one stream of one Myo
+	size_t low = 0;
+	size_t high = count;
+	while (low < high) {
+		size_t middle = low + (high - low) / 2;
+		if (timestamp(middle) > time) {
+			high = middle;
+		}
+		else {
+			low = middle + 1;
+		}
+	}
+	return low;
+}
+
+void MyoHistory::Ring::copy(size_t first, size_t count, unsigned char *out) const {
+	size_t start = (oldest + first) % slots;
+	size_t beforeWrap = min(count, slots - start);
+	memcpy(out, storage.data() + start * recordSize, beforeWrap * recordSize);
+	if (beforeWrap < count) {
+		memcpy(out + beforeWrap * recordSize, storage.data(), (count - beforeWrap) * recordSize);
+	}
+}
+
+void MyoHistory::set(Myo *myo, int stream, uint32_t capacityMs) {
+	if (stream < 0 || stream >= streamCount) {
+		return;
+	}
+	uint32_t rate = stream == imu ? imuRate : emgRate;
+	//Rounded up, plus one so that a full window of capacityMs always fits between its two ends
+	size_t capacity = capacityMs ? (static_cast<uint64_t>(capacityMs) * rate + 999) / 1000 + 1 : 0;
+
+	lock_guard<std::mutex> lock(mutex);
+	if (capacity == 0) {
+		auto it = histories.find(myo);
+		if (it == histories.end()) {
+			return;
+		}
+		it->second.streams[stream] = Ring();
+		//Myos without any history are not looked at again
+		bool unused = true;
+		for (const Ring &ring : it->second.streams) {
+			unused = unused && ring.capacity() == 0;
+		}
+		if (unused) {
+			histories.erase(it);
+		}
+		return;
+	}
+	histories[myo].streams[stream].allocate(recordSize(stream), capacity);
+}
+
+void MyoHistory::record(const MyoEvent &event) {
+	int stream;
+	if (event.type == libmyo_event_orientation) {
+		stream = imu;
+	}
+	else if (event.type == libmyo_event_emg) {
+		stream = emg;
+	}
+	else if (event.type == libmyo_event_unpaired) {
+		lock_guard<std::mutex> lock(mutex);
+		auto it = histories.find(event.myo());
+		if (it != histories.end()) {
+			for (Ring &ring : it->second.streams) {
+				ring.clear();
+			}
+		}
+		return;
+	}
+	else {
+		return;
+	}
+
+	lock_guard<std::mutex> lock(mutex);
+	auto it = histories.find(event.myo());
+	if (it == histories.end()) {
+		return;
+	}
+	Ring &ring = it->second.streams[stream];
+	if (ring.capacity() == 0) {
+		return;
+	}
+	unsigned char *slot = ring.push();
+	memcpy(slot, &event.timestamp, sizeof(event.timestamp));
+	if (stream == imu) {
+		memcpy(slot + offsetof(ImuHistoryRecord, imu), event.data.imu, sizeof(event.data.imu));
+	}
+	else {
+		memcpy(slot + offsetof(EmgHistoryRecord, emg), event.data.emg, sizeof(event.data.emg));
+	}
+}
+
+size_t MyoHistory::copyWindow(Myo *myo, int stream, uint64_t durationUs, void *out, size_t maxRecords) {
+	if (stream < 0 || stream >= streamCount || durationUs == 0 || maxRecords == 0) {
+		return 0;
+	}
+	lock_guard<std::mutex> lock(mutex);
+	auto it = histories.find(myo);
+	if (it == histories.end()) {
+		return 0;
+	}
+	const Ring &ring = it->second.streams[stream];
+	if (ring.empty()) {
+		return 0;
+	}
+	uint64_t newest = ring.timestamp(ring.size() - 1);
+	size_t first = newest >= durationUs ? ring.firstAfter(newest - durationUs) : 0;
+	size_t count = min(ring.size() - first, maxRecords);
+	ring.copy(ring.size() - count, count, static_cast<unsigned char*>(out));
+	return count;
+}
+
+void MyoHistory::clearAll() {
+	lock_guard<std::mutex> lock(mutex);
+	for (auto &entry : histories) {
+		for (Ring &ring : entry.second.streams) {
+			ring.clear();
+		}
+	}
+}
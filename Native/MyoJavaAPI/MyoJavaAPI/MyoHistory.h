@@ -0,0 +1,114 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <myo/myo.hpp>
+#include "MyoEvent.h"
+#include "com_thalmic_myo_Myo.h"
+
+/*
+ * The records kept in a history, as copied into the buffer passed to Myo.getHistory(). See Myo.HistoryStream for
+ * the Java side of the layout.
+ */
+struct ImuHistoryRecord {
+	uint64_t timestamp;
+	//Orientation x, y, z, w, then accelerometer x, y, z, then gyroscope x, y, z, as in MyoEvent
+	float imu[10];
+};
+
+struct EmgHistoryRecord {
+	uint64_t timestamp;
+	int8_t emg[8];
+};
+
+static_assert(sizeof(ImuHistoryRecord) == 48, "ImuHistoryRecord must match Myo.HistoryStream.imu");
+static_assert(sizeof(EmgHistoryRecord) == 16, "EmgHistoryRecord must match Myo.HistoryStream.emg");
+
+/*
+ * The recent IMU and EMG data of the Myos of one hub, for reading a window of it at any time.
+ *
+ * Every Myo that has a history set through Myo.setHistory() gets a fixed-size ring per stream, sized for the
+ * requested number of milliseconds at the stream's rate and allocated once. Records are written into the ring as
+ * events are decoded, so keeping a history allocates nothing while running. A window is read by finding its first
+ * record by timestamp and copying from there, which is one memcpy, or two where the window wraps around the end of
+ * the ring.
+ *
+ * The hub writes from the thread that decodes events while Java reads from any thread, so everything is done under
+ * a lock. Nothing is held for longer than the copy of one window.
+ */
+class MyoHistory {
+
+public:
+	enum Stream {
+		imu = com_thalmic_myo_Myo_HISTORY_IMU,
+		emg = com_thalmic_myo_Myo_HISTORY_EMG,
+		streamCount
+	};
+
+	//Rates of Myo IMU and EMG data, in records per second
+	static const uint32_t imuRate = 50;
+	static const uint32_t emgRate = 200;
+
+	static size_t recordSize(int stream) {
+		return stream == imu ? sizeof(ImuHistoryRecord) : sizeof(EmgHistoryRecord);
+	}
+
+	//Replaces the history of a stream of the Myo with an empty one holding capacityMs of data. 0 removes it.
+	void set(myo::Myo *myo, int stream, uint32_t capacityMs);
+	//Adds the data of an IMU or EMG event to the history of its Myo. A Myo that unpairs starts over empty.
+	void record(const MyoEvent &event);
+	//Copies the records of the last durationUs before the newest record of the stream, oldest first, to out. If
+	//there are more than maxRecords of them, only the newest maxRecords are copied. Returns the number copied.
+	size_t copyWindow(myo::Myo *myo, int stream, uint64_t durationUs, void *out, size_t maxRecords);
+	//Empties every history, keeping their capacities.
+	void clearAll();
+
+private:
+	class Ring {
+	public:
+		Ring() : recordSize(0), slots(0), oldest(0), count(0) {
+		}
+		void allocate(size_t recordSize, size_t records);
+		//0 if the stream has no history
+		size_t capacity() const {
+			return slots;
+		}
+		bool empty() const {
+			return count == 0;
+		}
+		void clear() {
+			oldest = 0;
+			count = 0;
+		}
+		//Returns the slot of a new record, which overwrites the oldest one once the ring is full.
+		unsigned char* push();
+		//Index of the first record with a timestamp after the time
+		size_t firstAfter(uint64_t time) const;
+		uint64_t timestamp(size_t i) const;
+		size_t size() const {
+			return count;
+		}
+		//Copies count records from index first on to out.
+		void copy(size_t first, size_t count, unsigned char *out) const;
+
+	private:
+		std::vector<unsigned char> storage;
+		size_t recordSize;
+		size_t slots;
+		size_t oldest;
+		size_t count;
+
+		const unsigned char* slot(size_t i) const {
+			return storage.data() + (oldest + i) % slots * recordSize;
+		}
+	};
+
+	struct Rings {
+		Ring streams[streamCount];
+	};
+
+	std::unordered_map<myo::Myo*, Rings> histories;
+	std::mutex mutex;
+};
@@ -0,0 +1,57 @@
+#include "MyoPeers.h"
+#include "JNICache.h"
+#include <iostream>
+
+using namespace std;
+using namespace myo;
+
+jobject MyoPeers::get(JNIEnv *env, Myo *myo) {
+	lock_guard<std::mutex> lock(mutex);
+	return find(env, myo);
+}
+
+jobject MyoPeers::getLocal(JNIEnv *env, Myo *myo) {
+	lock_guard<std::mutex> lock(mutex);
+	jobject peer = find(env, myo);
+	return peer ? env->NewLocalRef(peer) : nullptr;
+}
+
+jobject MyoPeers::find(JNIEnv *env, Myo *myo) {
+	auto it = peers.find(myo);
+	if (it != peers.end()) {
+		return it->second;
+	}
+
+	jobject m = env->NewObject(jniCache.myoClass, jniCache.myoConstructor, reinterpret_cast<jlong>(myo), static_cast<jboolean>(replayed),
+		reinterpret_cast<jlong>(processing));
+	if (env->ExceptionCheck() == JNI_TRUE) {
+		cerr << "Exception when creating Myo object" << endl;
+		env->ExceptionDescribe();
+		return nullptr;
+	}
+	jobject peer = env->NewGlobalRef(m);
+	env->DeleteLocalRef(m);
+	if (!peer) {
+		THROW_JNI_EXCEPTION(env, "Failed to make global reference for object; JVM is out of memory");
+		return nullptr;
+	}
+	peers[myo] = peer;
+	return peer;
+}
+
+void MyoPeers::release(JNIEnv *env, Myo *myo) {
+	lock_guard<std::mutex> lock(mutex);
+	auto it = peers.find(myo);
+	if (it != peers.end()) {
+		env->DeleteGlobalRef(it->second);
+		peers.erase(it);
+	}
+}
+
+void MyoPeers::releaseAll(JNIEnv *env) {
+	lock_guard<std::mutex> lock(mutex);
+	for (auto &entry : peers) {
+		env->DeleteGlobalRef(entry.second);
+	}
+	peers.clear();
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <jni.h>
+#include <mutex>
+#include <unordered_map>
+#include <myo/myo.hpp>
+#include "MyoProcessing.h"
+
+/*
+ * The Java Myo objects ("peers") of native Myos.
+ *
+ * Keeps exactly one Java Myo object for each native Myo. Listener callbacks hand out the peer instead of constructing
+ * a new Java object for every event, which saves an allocation per event and means Java code can compare Myos by
+ * identity. Peers are global references; they are dropped once a Myo is unpaired, and all at once by releaseAll().
+ *
+ * Peers of replayed Myos are created as such (see Myo.isReplayed()), since there is no device behind them that
+ * commands could be sent to. Every peer is handed the MyoProcessing of its hub, which Myo.setEmgFilter() and the
+ * orientation methods of Myo go through.
+ *
+ * Peers are looked up by the thread that dispatches events, which is also the only one that releases single peers,
+ * but Hub.waitForMyo() looks them up from whatever thread calls it, even while another thread consumes the async
+ * queue. The map is therefore guarded by a lock, and threads other than the dispatching one use getLocal(), which
+ * takes its reference before the peer can be released.
+ */
+class MyoPeers {
+
+public:
+	explicit MyoPeers(MyoProcessing *processing, bool replayed = false) : processing(processing), replayed(replayed) {
+	}
+
+	//Returns the peer of the Myo, creating it the first time the Myo is seen. The global reference stays valid until
+	//the peer is released, so only the dispatching thread may hold on to it.
+	jobject get(JNIEnv *env, myo::Myo *myo);
+	//Same as get(), but returns a new local reference, which stays valid even if the peer is released meanwhile.
+	jobject getLocal(JNIEnv *env, myo::Myo *myo);
+	void release(JNIEnv *env, myo::Myo *myo);
+	//Has to be called before deleting, since the destructor can't release Java references.
+	void releaseAll(JNIEnv *env);
+
+private:
+	std::unordered_map<myo::Myo*, jobject> peers;
+	std::mutex mutex;
+	MyoProcessing *processing;
+	bool replayed;
+
+	//Looks up or creates the peer; mutex must be held.
+	jobject find(JNIEnv *env, myo::Myo *myo);
+
+	MyoPeers(const MyoPeers&);
+	MyoPeers& operator=(const MyoPeers&);
+};
@@ -0,0 +1,48 @@
+#include "MyoProcessing.h"
+
+using namespace std;
+using namespace myo;
+
+void MyoProcessing::smooth(MyoEvent &event) {
+	if (event.type == libmyo_event_orientation) {
+		smoother.process(event.myo(), event.timestamp, event.data.imu);
+	}
+	else if (event.type == libmyo_event_disconnected || event.type == libmyo_event_unpaired) {
+		smoother.reset(event.myo());
+	}
+}
+
+void MyoProcessing::dispatch(const MyoEvent &event, const EventDispatcher &dispatcher) {
+	Myo *myo = event.myo();
+	DerivedData derived = DerivedData();
+	float filtered[EmgFilterChain::sensors];
+	float angles[OrientationProcessor::angleCount];
+
+	switch (event.type) {
+	case libmyo_event_emg:
+		if (filters.process(myo, event.data.emg, filtered)) {
+			derived.filteredEmg = filtered;
+		}
+		break;
+	case libmyo_event_orientation:
+		//The angles cost a lock and some trigonometry, so they are only worked out for someone
+		if (dispatcher.wantsOrientationEuler(myo)) {
+			orientation.process(myo, event.data.imu, angles);
+			derived.eulerAngles = angles;
+		}
+		break;
+	case libmyo_event_arm_synced:
+		orientation.setXDirection(myo, static_cast<XDirection>(event.data.armSync.xDirection));
+		break;
+	case libmyo_event_arm_unsynced:
+		orientation.setXDirection(myo, xDirectionUnknown);
+		break;
+	}
+
+	dispatcher.dispatch(event, derived);
+
+	if (event.type == libmyo_event_disconnected || event.type == libmyo_event_unpaired) {
+		filters.reset(myo);
+		orientation.setXDirection(myo, xDirectionUnknown);
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "MyoEvent.h"
+#include "EventDispatcher.h"
+#include "EmgFilter.h"
+#include "OrientationProcessor.h"
+#include "OrientationSmoother.h"
+#include "MyoHistory.h"
+
+/*
+ * What a hub derives from the events of its Myos before they reach listeners.
+ *
+ * Both HubWrapper and ReplayHub own one and dispatch every event through it. It is configured per Myo from Java,
+ * through the Myo objects that the hub hands out (see MyoPeers): Myo.setEmgFilter() for the EMG filters,
+ * Myo.setOrientationSmoothing() for the smoother, Myo.setOrientationReference() and Myo.centerOrientation() for
+ * the orientation, and Myo.setHistory() for the history.
+ *
+ * Smoothing comes first and changes the event itself, so that everything after it, including the state block and
+ * the async queue of a HubWrapper, sees the smoothed orientation. Session logs keep the raw one.
+ */
+class MyoProcessing {
+
+public:
+	EmgFilterBank filters;
+	OrientationProcessor orientation;
+	OrientationSmoother smoother;
+	//Filled by the hubs with the events as their listeners see them, right after smoothing
+	MyoHistory history;
+
+	MyoProcessing() {
+	}
+
+	//Replaces the orientation of an orientation event by its smoothed version, if its Myo has smoothing. Must be
+	//called for every event, in order, before dispatch(); smoothing starts over when the Myo disconnects or unpairs.
+	void smooth(MyoEvent &event);
+
+	//Dispatches the event with the data derived from it, then updates the state of its Myo. EMG filters start
+	//over, and the arm is forgotten, when the Myo disconnects or unpairs.
+	void dispatch(const MyoEvent &event, const EventDispatcher &dispatcher);
+
+private:
+	MyoProcessing(const MyoProcessing&);
+	MyoProcessing& operator=(const MyoProcessing&);
+};
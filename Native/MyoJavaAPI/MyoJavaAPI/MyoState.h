@@ -0,0 +1,129 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "MyoEvent.h"
+
+/*
+ * The latest known state of one Myo, shared with Java through a direct ByteBuffer.
+ *
+ * The block is updated from the thread that decodes events and read by any number of Java threads without any
+ * locking or JNI calls, using a seqlock: the writer makes sequence odd before changing anything and even again
+ * afterwards, and a reader retries if sequence was odd or changed while it was copying. See MyoState.java for
+ * the reading side; the offsets there have to match this struct.
+ */
+struct MyoStateBlock {
+	std::atomic<uint32_t> sequence;
+	int32_t pose;
+	uint64_t imuTimestamp;
+	float orientation[4];
+	float accelerometer[3];
+	float gyroscope[3];
+	uint64_t emgTimestamp;
+	int8_t emg[8];
+	uint64_t lastEventTimestamp;
+	int32_t arm;
+	int32_t xDirection;
+	float rotationOnArm;
+	int32_t warmupState;
+	int8_t connected;
+	int8_t synced;
+	int8_t unlocked;
+	//-1 until the first battery level or RSSI event
+	int8_t batteryLevel;
+	int8_t rssi;
+	int8_t reserved[3];
+	uint64_t poseTimestamp;
+	//The orientation before the latest one, so that readers can interpolate between the two; 0 and identity until
+	//the second orientation event
+	uint64_t previousImuTimestamp;
+	float previousOrientation[4];
+	uint8_t padding[56];
+
+	MyoStateBlock() {
+		sequence.store(0, std::memory_order_relaxed);
+		memset(reinterpret_cast<char*>(this) + sizeof(sequence), 0, sizeof(*this) - sizeof(sequence));
+		pose = libmyo_pose_unknown;
+		arm = libmyo_arm_unknown;
+		xDirection = libmyo_x_direction_unknown;
+		batteryLevel = -1;
+		rssi = -1;
+		//Identity quaternions
+		orientation[3] = 1;
+		previousOrientation[3] = 1;
+	}
+
+	//Only one thread may call this at a time.
+	void update(const MyoEvent &event) {
+		uint32_t s = sequence.load(std::memory_order_relaxed);
+		sequence.store(s + 1, std::memory_order_relaxed);
+		//Keeps the writes below from becoming visible before sequence is odd
+		std::atomic_thread_fence(std::memory_order_release);
+
+		lastEventTimestamp = event.timestamp;
+		switch (event.type) {
+		case libmyo_event_paired:
+			break;
+		case libmyo_event_unpaired:
+			connected = 0;
+			synced = 0;
+			break;
+		case libmyo_event_connected:
+			connected = 1;
+			break;
+		case libmyo_event_disconnected:
+			connected = 0;
+			synced = 0;
+			break;
+		case libmyo_event_arm_synced:
+			synced = 1;
+			arm = event.data.armSync.arm;
+			xDirection = event.data.armSync.xDirection;
+			rotationOnArm = event.data.armSync.rotation;
+			warmupState = event.data.armSync.warmupState;
+			break;
+		case libmyo_event_arm_unsynced:
+			synced = 0;
+			arm = libmyo_arm_unknown;
+			xDirection = libmyo_x_direction_unknown;
+			break;
+		case libmyo_event_unlocked:
+			unlocked = 1;
+			break;
+		case libmyo_event_locked:
+			unlocked = 0;
+			break;
+		case libmyo_event_orientation:
+			if (imuTimestamp != 0) {
+				previousImuTimestamp = imuTimestamp;
+				memcpy(previousOrientation, orientation, sizeof(previousOrientation));
+			}
+			imuTimestamp = event.timestamp;
+			memcpy(orientation, event.data.imu, sizeof(orientation));
+			memcpy(accelerometer, event.data.imu + 4, sizeof(accelerometer));
+			memcpy(gyroscope, event.data.imu + 7, sizeof(gyroscope));
+			break;
+		case libmyo_event_pose:
+			poseTimestamp = event.timestamp;
+			pose = event.data.pose;
+			break;
+		case libmyo_event_rssi:
+			rssi = event.data.rssi;
+			break;
+		case libmyo_event_battery_level:
+			batteryLevel = static_cast<int8_t>(event.data.batteryLevel);
+			break;
+		case libmyo_event_emg:
+			emgTimestamp = event.timestamp;
+			memcpy(emg, event.data.emg, sizeof(emg));
+			break;
+		case libmyo_event_warmup_completed:
+			warmupState = event.data.warmupResult == libmyo_warmup_result_success ? libmyo_warmup_state_warm : warmupState;
+			break;
+		}
+
+		sequence.store(s + 2, std::memory_order_release);
+	}
+};
+
+static_assert(sizeof(MyoStateBlock) == 192, "MyoStateBlock must match the layout in MyoState.java");
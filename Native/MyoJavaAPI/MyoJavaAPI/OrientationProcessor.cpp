@@ -0,0 +1,64 @@
+#include "OrientationProcessor.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace myo;
+
+void OrientationProcessor::setReference(Myo *myo, const Quaternion<float> &reference) {
+	lock_guard<std::mutex> lock(mutex);
+	State &state = states[myo];
+	state.reference = reference.normalized();
+	state.hasReference = true;
+	state.centerPending = false;
+}
+
+void OrientationProcessor::clearReference(Myo *myo) {
+	lock_guard<std::mutex> lock(mutex);
+	auto it = states.find(myo);
+	if (it != states.end()) {
+		it->second.hasReference = false;
+		it->second.centerPending = false;
+	}
+}
+
+void OrientationProcessor::center(Myo *myo) {
+	lock_guard<std::mutex> lock(mutex);
+	states[myo].centerPending = true;
+}
+
+void OrientationProcessor::setXDirection(Myo *myo, XDirection xDirection) {
+	lock_guard<std::mutex> lock(mutex);
+	states[myo].xDirection = xDirection;
+}
+
+void OrientationProcessor::process(Myo *myo, const float *quaternion, float *out) {
+	Quaternion<float> q(quaternion[0], quaternion[1], quaternion[2], quaternion[3]);
+	bool towardElbow;
+	{
+		lock_guard<std::mutex> lock(mutex);
+		State &state = states[myo];
+		if (state.centerPending) {
+			state.reference = q;
+			state.hasReference = true;
+			state.centerPending = false;
+		}
+		if (state.hasReference) {
+			q = state.reference.conjugate() * q;
+		}
+		towardElbow = state.xDirection == xDirectionTowardElbow;
+	}
+
+	float x = q.x(), y = q.y(), z = q.z(), w = q.w();
+	float roll = atan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y));
+	//Rounding can take the sine just past 1 near the poles
+	float pitch = asin(max(-1.0f, min(1.0f, 2 * (w * y - z * x))));
+	float yaw = atan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z));
+	if (towardElbow) {
+		roll = -roll;
+		pitch = -pitch;
+	}
+	out[angleRoll] = roll;
+	out[anglePitch] = pitch;
+	out[angleYaw] = yaw;
+}
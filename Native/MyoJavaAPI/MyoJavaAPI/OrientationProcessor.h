@@ -0,0 +1,55 @@
+#pragma once
+#include <mutex>
+#include <unordered_map>
+#include <myo/myo.hpp>
+
+/*
+ * Euler angles of the orientation of the Myos of one hub, relative to a reference and in the frame of the arm.
+ *
+ * Each Myo may have a reference orientation, typically the orientation of a calibration pose; orientations are
+ * taken relative to it (conjugate(reference) * orientation), so that the reference pose reads as all zero angles.
+ * If the Myo is synced with its +x axis toward the elbow, roll and pitch are negated, as in the Myo SDK samples, so
+ * that the angles mean the same whichever way round the Myo is worn.
+ *
+ * Java sets references from whatever thread it likes, while the hub processes orientation events on the thread
+ * that dispatches them, so everything is done under a lock. The hub only processes the orientations of Myos that a
+ * listener wants the angles of (see EventListener::wantsOrientationEuler()), so centering waits for the next
+ * orientation that is processed instead of using the last one seen, which may be long gone.
+ */
+class OrientationProcessor {
+
+public:
+	//Order of the angles in the output of process(), all in radians
+	enum Angle {
+		angleRoll,
+		anglePitch,
+		angleYaw,
+		angleCount
+	};
+
+	void setReference(myo::Myo *myo, const myo::Quaternion<float> &reference);
+	void clearReference(myo::Myo *myo);
+	//Makes the next orientation of the Myo that is processed its reference. A reference set or cleared before then
+	//cancels this.
+	void center(myo::Myo *myo);
+
+	//Called on arm sync and unsync, as well as disconnect and unpair, which forget the arm.
+	void setXDirection(myo::Myo *myo, myo::XDirection xDirection);
+
+	//Writes the angles of an orientation (x, y, z, w) of the Myo to out.
+	void process(myo::Myo *myo, const float *quaternion, float *out);
+
+private:
+	struct State {
+		myo::Quaternion<float> reference;
+		bool hasReference;
+		bool centerPending;
+		myo::XDirection xDirection;
+
+		State() : hasReference(false), centerPending(false), xDirection(myo::xDirectionUnknown) {
+		}
+	};
+
+	std::unordered_map<myo::Myo*, State> states;
+	std::mutex mutex;
+};
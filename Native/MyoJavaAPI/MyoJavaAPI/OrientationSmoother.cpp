@@ -0,0 +1,95 @@
+#include "OrientationSmoother.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "QuaternionBatch.h"
+
+using namespace std;
+using namespace myo;
+
+namespace {
+
+const float pi = 3.14159265358979f;
+//Time between orientation events, used when two events have the same timestamp
+const float nominalInterval = 1.0f / 50;
+
+//from = slerp(from, to, t), with the same kernel as the batch operations
+void slerpInPlace(float *from, const float *to, float t) {
+	QuaternionArrays<float> a = { from, from + 1, from + 2, from + 3 };
+	QuaternionArrays<float> b = { const_cast<float*>(to), const_cast<float*>(to) + 1, const_cast<float*>(to) + 2, const_cast<float*>(to) + 3 };
+	slerpBatch<float>(a, b, &t, a, 1);
+}
+
+//Angle of the rotation between two unit quaternions, in radians
+float angleBetween(const float *a, const float *b) {
+	float cosHalf = fabs(a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]);
+	return 2 * acos(min(1.0f, cosHalf));
+}
+
+//Weight of a new sample in a first order low-pass filter with the cutoff, for samples interval seconds apart
+float lowPassAlpha(float cutoff, float interval) {
+	float tau = 1 / (2 * pi * cutoff);
+	return 1 / (1 + tau / interval);
+}
+
+}
+
+void OrientationSmoother::set(Myo *myo, const OrientationSmoothing &smoothing) {
+	lock_guard<std::mutex> lock(mutex);
+	if (smoothing.mode == OrientationSmoothing::none) {
+		states.erase(myo);
+		return;
+	}
+	State &state = states[myo];
+	state.smoothing = smoothing;
+	state.started = false;
+}
+
+bool OrientationSmoother::process(Myo *myo, uint64_t timestamp, float *quaternion) {
+	lock_guard<std::mutex> lock(mutex);
+	auto it = states.find(myo);
+	if (it == states.end()) {
+		return false;
+	}
+	State &state = it->second;
+	if (!state.started) {
+		memcpy(state.filtered, quaternion, sizeof(state.filtered));
+		memcpy(state.lastInput, quaternion, sizeof(state.lastInput));
+		state.lastTimestamp = timestamp;
+		state.speed = 0;
+		state.started = true;
+		return true;
+	}
+
+	float t;
+	if (state.smoothing.mode == OrientationSmoothing::exponential) {
+		t = state.smoothing.factor;
+	}
+	else {
+		float interval = timestamp > state.lastTimestamp ? (timestamp - state.lastTimestamp) / 1e6f : nominalInterval;
+		float speed = angleBetween(state.lastInput, quaternion) / interval;
+		state.speed += lowPassAlpha(state.smoothing.derivativeCutoff, interval) * (speed - state.speed);
+		t = lowPassAlpha(state.smoothing.minCutoff + state.smoothing.beta * state.speed, interval);
+	}
+	memcpy(state.lastInput, quaternion, sizeof(state.lastInput));
+	state.lastTimestamp = timestamp;
+
+	slerpInPlace(state.filtered, quaternion, t);
+	memcpy(quaternion, state.filtered, sizeof(state.filtered));
+	return true;
+}
+
+void OrientationSmoother::reset(Myo *myo) {
+	lock_guard<std::mutex> lock(mutex);
+	auto it = states.find(myo);
+	if (it != states.end()) {
+		it->second.started = false;
+	}
+}
+
+void OrientationSmoother::resetAll() {
+	lock_guard<std::mutex> lock(mutex);
+	for (auto &entry : states) {
+		entry.second.started = false;
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <myo/myo.hpp>
+#include "com_thalmic_myo_OrientationSmoothing.h"
+
+//How the orientation of one Myo is smoothed, as described by a Java OrientationSmoothing
+struct OrientationSmoothing {
+	enum Mode {
+		//Orientations pass through unchanged
+		none = com_thalmic_myo_OrientationSmoothing_MODE_NONE,
+		//Every orientation moves the output toward it by factor, along the shortest arc
+		exponential = com_thalmic_myo_OrientationSmoothing_MODE_EXPONENTIAL,
+		//One-Euro filter: a low-pass whose cutoff rises from minCutoff with the angular speed, scaled by beta
+		oneEuro = com_thalmic_myo_OrientationSmoothing_MODE_ONE_EURO
+	};
+
+	int mode;
+	//exponential: the smoothing factor, from 0 (frozen) to 1 (no smoothing)
+	float factor;
+	//oneEuro: cutoffs in Hz, and beta in Hz per radian per second
+	float minCutoff;
+	float beta;
+	float derivativeCutoff;
+};
+
+/*
+ * Smooths the orientations of the Myos of one hub, to take the jitter out of them before anything else sees them.
+ *
+ * Both modes work on quaternions directly, interpolating with slerp so that the output always stays a unit
+ * quaternion and follows the shortest way between rotations. The One-Euro filter (Casiez et al., "1 Euro Filter: A
+ * Simple Speed-based Low-pass Filter for Noisy Input in Interactive Systems") takes its speed from the angle between
+ * successive orientations, so it smooths a lot while the arm is still and hardly lags while it moves. Its cutoffs
+ * are applied with the actual time between events, taken from their timestamps.
+ *
+ * Java sets smoothing through Myo.setOrientationSmoothing() from whatever thread it likes, while the hub smooths
+ * orientations on the thread that decodes events, so everything is done under a lock.
+ */
+class OrientationSmoother {
+
+public:
+	//Replaces the smoothing of the Myo; mode none removes it.
+	void set(myo::Myo *myo, const OrientationSmoothing &smoothing);
+	//Smooths an orientation (x, y, z, w) of the Myo in place. Returns false, leaving it alone, if the Myo has no
+	//smoothing.
+	bool process(myo::Myo *myo, uint64_t timestamp, float *quaternion);
+	//Starts the smoothing of the Myo over from its next orientation. Called when the Myo disconnects or unpairs.
+	void reset(myo::Myo *myo);
+	void resetAll();
+
+private:
+	struct State {
+		OrientationSmoothing smoothing;
+		//The last output, and the last input and its timestamp for the One-Euro speed
+		float filtered[4];
+		float lastInput[4];
+		uint64_t lastTimestamp;
+		//Filtered angular speed, in radians per second
+		float speed;
+		bool started;
+	};
+
+	std::unordered_map<myo::Myo*, State> states;
+	std::mutex mutex;
+};
@@ -0,0 +1,252 @@
+#include "QuaternionBatch.h"
+
+#if defined(__AVX__)
+#define QUATERNION_BATCH_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define QUATERNION_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/*
+ * The kernels are written once against a "pack" of floats, which is one element in ScalarPack and a full register in
+ * SimdPack. The SIMD pack takes the bulk of a batch, and the scalar pack the elements left over at the end.
+ */
+namespace {
+
+struct ScalarPack {
+	static const size_t width = 1;
+	float v;
+
+	ScalarPack() {
+	}
+	ScalarPack(float value) : v(value) {
+	}
+	static ScalarPack load(const float *p) {
+		return ScalarPack(*p);
+	}
+	void store(float *p) const {
+		*p = v;
+	}
+};
+
+inline ScalarPack operator+(ScalarPack a, ScalarPack b) { return ScalarPack(a.v + b.v); }
+inline ScalarPack operator-(ScalarPack a, ScalarPack b) { return ScalarPack(a.v - b.v); }
+inline ScalarPack operator*(ScalarPack a, ScalarPack b) { return ScalarPack(a.v * b.v); }
+inline ScalarPack operator/(ScalarPack a, ScalarPack b) { return ScalarPack(a.v / b.v); }
+inline ScalarPack sqrt(ScalarPack a) { return ScalarPack(std::sqrt(a.v)); }
+inline ScalarPack abs(ScalarPack a) { return ScalarPack(std::fabs(a.v)); }
+//1 or -1, with the sign of a
+inline ScalarPack signOf(ScalarPack a) { return ScalarPack(a.v < 0 ? -1.0f : 1.0f); }
+
+#if defined(QUATERNION_BATCH_AVX)
+
+struct SimdPack {
+	static const size_t width = 8;
+	__m256 v;
+
+	SimdPack() {
+	}
+	SimdPack(__m256 value) : v(value) {
+	}
+	SimdPack(float value) : v(_mm256_set1_ps(value)) {
+	}
+	static SimdPack load(const float *p) {
+		return SimdPack(_mm256_loadu_ps(p));
+	}
+	void store(float *p) const {
+		_mm256_storeu_ps(p, v);
+	}
+};
+
+inline SimdPack operator+(SimdPack a, SimdPack b) { return SimdPack(_mm256_add_ps(a.v, b.v)); }
+inline SimdPack operator-(SimdPack a, SimdPack b) { return SimdPack(_mm256_sub_ps(a.v, b.v)); }
+inline SimdPack operator*(SimdPack a, SimdPack b) { return SimdPack(_mm256_mul_ps(a.v, b.v)); }
+inline SimdPack operator/(SimdPack a, SimdPack b) { return SimdPack(_mm256_div_ps(a.v, b.v)); }
+inline SimdPack sqrt(SimdPack a) { return SimdPack(_mm256_sqrt_ps(a.v)); }
+inline SimdPack abs(SimdPack a) { return SimdPack(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)); }
+inline SimdPack signOf(SimdPack a) {
+	return SimdPack(_mm256_or_ps(_mm256_set1_ps(1.0f), _mm256_and_ps(_mm256_set1_ps(-0.0f), a.v)));
+}
+
+#elif defined(QUATERNION_BATCH_SSE2)
+
+struct SimdPack {
+	static const size_t width = 4;
+	__m128 v;
+
+	SimdPack() {
+	}
+	SimdPack(__m128 value) : v(value) {
+	}
+	SimdPack(float value) : v(_mm_set1_ps(value)) {
+	}
+	static SimdPack load(const float *p) {
+		return SimdPack(_mm_loadu_ps(p));
+	}
+	void store(float *p) const {
+		_mm_storeu_ps(p, v);
+	}
+};
+
+inline SimdPack operator+(SimdPack a, SimdPack b) { return SimdPack(_mm_add_ps(a.v, b.v)); }
+inline SimdPack operator-(SimdPack a, SimdPack b) { return SimdPack(_mm_sub_ps(a.v, b.v)); }
+inline SimdPack operator*(SimdPack a, SimdPack b) { return SimdPack(_mm_mul_ps(a.v, b.v)); }
+inline SimdPack operator/(SimdPack a, SimdPack b) { return SimdPack(_mm_div_ps(a.v, b.v)); }
+inline SimdPack sqrt(SimdPack a) { return SimdPack(_mm_sqrt_ps(a.v)); }
+inline SimdPack abs(SimdPack a) { return SimdPack(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)); }
+inline SimdPack signOf(SimdPack a) {
+	return SimdPack(_mm_or_ps(_mm_set1_ps(1.0f), _mm_and_ps(_mm_set1_ps(-0.0f), a.v)));
+}
+
+#else
+
+typedef ScalarPack SimdPack;
+
+#endif
+
+template<typename P>
+struct Quat {
+	P x, y, z, w;
+
+	static Quat load(const QuaternionArrays<float> &q, size_t i) {
+		Quat result = { P::load(q.x + i), P::load(q.y + i), P::load(q.z + i), P::load(q.w + i) };
+		return result;
+	}
+	void store(const QuaternionArrays<float> &q, size_t i) const {
+		x.store(q.x + i);
+		y.store(q.y + i);
+		z.store(q.z + i);
+		w.store(q.w + i);
+	}
+};
+
+template<typename P>
+size_t multiplyKernel(const QuaternionArrays<float> &a, const QuaternionArrays<float> &b, const QuaternionArrays<float> &out,
+	size_t i, size_t count) {
+	for (; i + P::width <= count; i += P::width) {
+		Quat<P> l = Quat<P>::load(a, i);
+		Quat<P> r = Quat<P>::load(b, i);
+		//Same as myo::Quaternion::operator*()
+		Quat<P> product = {
+			l.w * r.x + l.x * r.w + l.y * r.z - l.z * r.y,
+			l.w * r.y - l.x * r.z + l.y * r.w + l.z * r.x,
+			l.w * r.z + l.x * r.y - l.y * r.x + l.z * r.w,
+			l.w * r.w - l.x * r.x - l.y * r.y - l.z * r.z
+		};
+		product.store(out, i);
+	}
+	return i;
+}
+
+template<typename P>
+size_t rotateKernel(const QuaternionArrays<float> &q, const Vector3Arrays<float> &v, const Vector3Arrays<float> &out,
+	size_t i, size_t count) {
+	const P two(2.0f);
+	for (; i + P::width <= count; i += P::width) {
+		Quat<P> r = Quat<P>::load(q, i);
+		P vx = P::load(v.x + i), vy = P::load(v.y + i), vz = P::load(v.z + i);
+		//Same as rotateBatch()
+		P tx = two * (r.y * vz - r.z * vy);
+		P ty = two * (r.z * vx - r.x * vz);
+		P tz = two * (r.x * vy - r.y * vx);
+		(vx + r.w * tx + (r.y * tz - r.z * ty)).store(out.x + i);
+		(vy + r.w * ty + (r.z * tx - r.x * tz)).store(out.y + i);
+		(vz + r.w * tz + (r.x * ty - r.y * tx)).store(out.z + i);
+	}
+	return i;
+}
+
+template<typename P>
+size_t normalizeKernel(const QuaternionArrays<float> &q, const QuaternionArrays<float> &out, size_t i, size_t count) {
+	for (; i + P::width <= count; i += P::width) {
+		Quat<P> r = Quat<P>::load(q, i);
+		//A true division rather than a reciprocal square root estimate, to match myo::Quaternion::normalized()
+		P magnitude = sqrt(r.x * r.x + r.y * r.y + r.z * r.z + r.w * r.w);
+		Quat<P> normalized = { r.x / magnitude, r.y / magnitude, r.z / magnitude, r.w / magnitude };
+		normalized.store(out, i);
+	}
+	return i;
+}
+
+//Coefficients of the polynomial approximation of slerp from D. Eberly, "A Fast and Accurate Algorithm for Computing
+//SLERP": u[k] = 1 / ((k + 1)(2k + 3)) and v[k] = (k + 1) / (2k + 3), with the last pair scaled by mu to balance the
+//error of the truncated series. With 16 terms the error is about 3e-8, below float rounding; the 8 terms of the
+//paper leave errors of 2e-5 for rotations close to half a turn apart.
+struct SlerpCoefficients {
+	static const int terms = 16;
+	float u[terms];
+	float v[terms];
+
+	SlerpCoefficients() {
+		const double mu = 1.91672540727;
+		for (int k = 0; k < terms; k++) {
+			double scale = k == terms - 1 ? mu : 1.0;
+			u[k] = static_cast<float>(scale / ((k + 1) * (2 * k + 3)));
+			v[k] = static_cast<float>(scale * (k + 1) / (2 * k + 3));
+		}
+	}
+};
+const SlerpCoefficients slerpCoefficients;
+
+//sin(t * angle) / sin(angle), from xm1 = cos(angle) - 1, for angles up to pi / 2
+template<typename P>
+inline P slerpWeight(P t, P xm1) {
+	P sqrT = t * t;
+	P b = P(1.0f);
+	for (int k = SlerpCoefficients::terms - 1; k >= 0; k--) {
+		b = P(1.0f) + (P(slerpCoefficients.u[k]) * sqrT - P(slerpCoefficients.v[k])) * xm1 * b;
+	}
+	return t * b;
+}
+
+template<typename P>
+size_t slerpKernel(const QuaternionArrays<float> &a, const QuaternionArrays<float> &b, const float *t, const QuaternionArrays<float> &out,
+	size_t i, size_t count) {
+	for (; i + P::width <= count; i += P::width) {
+		Quat<P> from = Quat<P>::load(a, i);
+		Quat<P> to = Quat<P>::load(b, i);
+		P cosAngle = from.x * to.x + from.y * to.y + from.z * to.z + from.w * to.w;
+		P sign = signOf(cosAngle);
+		P xm1 = abs(cosAngle) - P(1.0f);
+		P s = P::load(t + i);
+		P weightA = slerpWeight(P(1.0f) - s, xm1);
+		P weightB = slerpWeight(s, xm1) * sign;
+		Quat<P> result = {
+			weightA * from.x + weightB * to.x,
+			weightA * from.y + weightB * to.y,
+			weightA * from.z + weightB * to.z,
+			weightA * from.w + weightB * to.w
+		};
+		result.store(out, i);
+	}
+	return i;
+}
+
+}
+
+template<>
+void multiplyBatch<float>(const QuaternionArrays<float> &a, const QuaternionArrays<float> &b, const QuaternionArrays<float> &out, size_t count) {
+	size_t i = multiplyKernel<SimdPack>(a, b, out, 0, count);
+	multiplyKernel<ScalarPack>(a, b, out, i, count);
+}
+
+template<>
+void rotateBatch<float>(const QuaternionArrays<float> &q, const Vector3Arrays<float> &v, const Vector3Arrays<float> &out, size_t count) {
+	size_t i = rotateKernel<SimdPack>(q, v, out, 0, count);
+	rotateKernel<ScalarPack>(q, v, out, i, count);
+}
+
+template<>
+void normalizeBatch<float>(const QuaternionArrays<float> &q, const QuaternionArrays<float> &out, size_t count) {
+	size_t i = normalizeKernel<SimdPack>(q, out, 0, count);
+	normalizeKernel<ScalarPack>(q, out, i, count);
+}
+
+template<>
+void slerpBatch<float>(const QuaternionArrays<float> &a, const QuaternionArrays<float> &b, const float *t, const QuaternionArrays<float> &out, size_t count) {
+	size_t i = slerpKernel<SimdPack>(a, b, t, out, 0, count);
+	slerpKernel<ScalarPack>(a, b, t, out, i, count);
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <myo/myo.hpp>
+
+/*
+ * Batch versions of the myo::Quaternion and myo::Vector3 operations, over arrays of components.
+ *
+ * The values are laid out as a structure of arrays: one array per component, as in a column file (see
+ * SessionColumns.java), so that element i of a batch is (x[i], y[i], z[i], w[i]). Every operation works element by
+ * element and gives the same results as its myo:: counterpart. The output may be the same arrays as an input, but
+ * must not overlap them otherwise.
+ *
+ * The templates work for any T. The float versions are specialized in QuaternionBatch.cpp to process 8 elements at a
+ * time with AVX or 4 at a time with SSE2, whichever the compiler targets, so that a batch is limited by memory
+ * bandwidth rather than by the cost of a call and temporaries per element.
+ */
+template<typename T>
+struct QuaternionArrays {
+	T *x;
+	T *y;
+	T *z;
+	T *w;
+};
+
+template<typename T>
+struct Vector3Arrays {
+	T *x;
+	T *y;
+	T *z;
+};
+
+//out[i] = a[i] * b[i]
+template<typename T>
+void multiplyBatch(const QuaternionArrays<T> &a, const QuaternionArrays<T> &b, const QuaternionArrays<T> &out, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		myo::Quaternion<T> product = myo::Quaternion<T>(a.x[i], a.y[i], a.z[i], a.w[i]) *
+			myo::Quaternion<T>(b.x[i], b.y[i], b.z[i], b.w[i]);
+		out.x[i] = product.x();
+		out.y[i] = product.y();
+		out.z[i] = product.z();
+		out.w[i] = product.w();
+	}
+}
+
+//out[i] = rotate(q[i], v[i]), for unit quaternions q[i]
+template<typename T>
+void rotateBatch(const QuaternionArrays<T> &q, const Vector3Arrays<T> &v, const Vector3Arrays<T> &out, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		//v + 2w(u x v) + 2u x (u x v), with u the vector part of q, which is what q * v * conjugate(q) expands to
+		T tx = 2 * (q.y[i] * v.z[i] - q.z[i] * v.y[i]);
+		T ty = 2 * (q.z[i] * v.x[i] - q.x[i] * v.z[i]);
+		T tz = 2 * (q.x[i] * v.y[i] - q.y[i] * v.x[i]);
+		T x = v.x[i] + q.w[i] * tx + (q.y[i] * tz - q.z[i] * ty);
+		T y = v.y[i] + q.w[i] * ty + (q.z[i] * tx - q.x[i] * tz);
+		T z = v.z[i] + q.w[i] * tz + (q.x[i] * ty - q.y[i] * tx);
+		out.x[i] = x;
+		out.y[i] = y;
+		out.z[i] = z;
+	}
+}
+
+//out[i] = q[i].normalized()
+template<typename T>
+void normalizeBatch(const QuaternionArrays<T> &q, const QuaternionArrays<T> &out, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		myo::Quaternion<T> normalized = myo::Quaternion<T>(q.x[i], q.y[i], q.z[i], q.w[i]).normalized();
+		out.x[i] = normalized.x();
+		out.y[i] = normalized.y();
+		out.z[i] = normalized.z();
+		out.w[i] = normalized.w();
+	}
+}
+
+//out[i] is the spherical linear interpolation from a[i] (t[i] = 0) to b[i] (t[i] = 1), for unit quaternions.
+//b[i] is negated first if that is closer to a[i], so the interpolation always takes the shorter way round.
+template<typename T>
+void slerpBatch(const QuaternionArrays<T> &a, const QuaternionArrays<T> &b, const T *t, const QuaternionArrays<T> &out, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		T cosAngle = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i] + a.w[i] * b.w[i];
+		T sign = cosAngle < 0 ? T(-1) : T(1);
+		cosAngle *= sign;
+		T weightA, weightB;
+		if (cosAngle > T(0.9995)) {
+			//Too close for sin() to be accurate; the difference from a straight line is below rounding
+			weightA = 1 - t[i];
+			weightB = t[i];
+		}
+		else {
+			T angle = std::acos(cosAngle);
+			T sinAngle = std::sin(angle);
+			weightA = std::sin((1 - t[i]) * angle) / sinAngle;
+			weightB = std::sin(t[i] * angle) / sinAngle;
+		}
+		weightB *= sign;
+		T x = weightA * a.x[i] + weightB * b.x[i];
+		T y = weightA * a.y[i] + weightB * b.y[i];
+		T z = weightA * a.z[i] + weightB * b.z[i];
+		T w = weightA * a.w[i] + weightB * b.w[i];
+		out.x[i] = x;
+		out.y[i] = y;
+		out.z[i] = z;
+		out.w[i] = w;
+	}
+}
+
+template<>
+void multiplyBatch<float>(const QuaternionArrays<float> &a, const QuaternionArrays<float> &b, const QuaternionArrays<float> &out, size_t count);
+template<>
+void rotateBatch<float>(const QuaternionArrays<float> &q, const Vector3Arrays<float> &v, const Vector3Arrays<float> &out, size_t count);
+template<>
+void normalizeBatch<float>(const QuaternionArrays<float> &q, const QuaternionArrays<float> &out, size_t count);
+//Uses a polynomial in place of acos() and sin(), so that it vectorizes; it is within a few float roundings of the
+//generic version.
+template<>
+void slerpBatch<float>(const QuaternionArrays<float> &a, const QuaternionArrays<float> &b, const float *t, const QuaternionArrays<float> &out, size_t count);
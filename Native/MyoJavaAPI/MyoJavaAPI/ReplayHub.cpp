@@ -0,0 +1,141 @@
+#include "ReplayHub.h"
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+using namespace myo;
+
+ReplayHub::ReplayHub(const string &path) : peers(&processing, true), reader(path), speed(1) {
+	rewind();
+}
+
+void ReplayHub::release(JNIEnv *env) {
+	peers.releaseAll(env);
+}
+
+void ReplayHub::rewind() {
+	processing.filters.resetAll();
+	processing.smoother.resetAll();
+	processing.history.clearAll();
+	blockIndex = 0;
+	recordIndex = 0;
+	replayed = 0;
+	//Skip empty blocks, so that current() is always a record unless the replay is finished
+	while (!isFinished() && reader.blocks()[blockIndex].count == 0) {
+		blockIndex++;
+	}
+	replayTime = isFinished() ? 0 : current()->timestamp;
+}
+
+void ReplayHub::advance() {
+	replayed++;
+	if (++recordIndex < reader.blocks()[blockIndex].count) {
+		return;
+	}
+	recordIndex = 0;
+	do {
+		blockIndex++;
+	} while (!isFinished() && reader.blocks()[blockIndex].count == 0);
+}
+
+Myo* ReplayHub::lookupMyo(uint64_t macAddress) {
+	auto it = myos.find(macAddress);
+	if (it == myos.end()) {
+		ReplayMyo *myo = new ReplayMyo();
+		myo->macAddress = macAddress;
+		it = myos.emplace(macAddress, unique_ptr<ReplayMyo>(myo)).first;
+	}
+	return reinterpret_cast<Myo*>(it->second.get());
+}
+
+void ReplayHub::dispatch(JNIEnv *env, const SessionRecord &record) {
+	//A newer recorder may know event types that this version doesn't
+	if (record.type >= static_cast<uint32_t>(numEventTypes)) {
+		return;
+	}
+	MyoEvent event;
+	event.type = record.type;
+	event.reserved = 0;
+	event.timestamp = record.timestamp;
+	event.myoAddress = reinterpret_cast<uintptr_t>(lookupMyo(record.macAddress));
+	event.data = record.data;
+
+	processing.smooth(event);
+	processing.history.record(event);
+	processing.dispatch(event, dispatcher);
+	if (event.type == libmyo_event_unpaired) {
+		peers.release(env, event.myo());
+	}
+	dispatcher.tick(max(replayTime, event.timestamp));
+}
+
+bool ReplayHub::waitUntilDue(const SessionRecord &record, chrono::steady_clock::time_point start, uint64_t startTime,
+	chrono::steady_clock::time_point deadline) const {
+	if (speed <= 0) {
+		return chrono::steady_clock::now() < deadline;
+	}
+	//Events of different Myos aren't always in timestamp order, so a record can be behind the replay
+	int64_t ahead = static_cast<int64_t>(record.timestamp - startTime);
+	if (ahead <= 0) {
+		return true;
+	}
+	auto due = start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double, micro>(ahead / speed));
+	if (due > deadline) {
+		return false;
+	}
+	this_thread::sleep_until(due);
+	return true;
+}
+
+void ReplayHub::advanceReplayTime(chrono::steady_clock::time_point start, uint64_t startTime) {
+	if (speed > 0) {
+		double elapsed = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+		replayTime = startTime + static_cast<uint64_t>(elapsed * speed);
+	}
+}
+
+void ReplayHub::run(JNIEnv *env, unsigned int duration_ms) {
+	auto start = chrono::steady_clock::now();
+	auto deadline = start + chrono::milliseconds(duration_ms);
+	uint64_t startTime = replayTime;
+
+	while (const SessionRecord *record = current()) {
+		if (!waitUntilDue(*record, start, startTime, deadline)) {
+			break;
+		}
+		dispatch(env, *record);
+		if (speed <= 0) {
+			replayTime = record->timestamp;
+		}
+		advance();
+	}
+	if (isFinished()) {
+		dispatcher.tick(replayTime);
+		return;
+	}
+	//Like Hub::run(), this takes the whole duration even if nothing happens
+	this_thread::sleep_until(deadline);
+	advanceReplayTime(start, startTime);
+	dispatcher.tick(replayTime);
+}
+
+void ReplayHub::runOnce(JNIEnv *env, unsigned int duration_ms) {
+	auto start = chrono::steady_clock::now();
+	auto deadline = start + chrono::milliseconds(duration_ms);
+	uint64_t startTime = replayTime;
+
+	const SessionRecord *record = current();
+	if (!record) {
+		return;
+	}
+	if (!waitUntilDue(*record, start, startTime, deadline)) {
+		this_thread::sleep_until(deadline);
+		advanceReplayTime(start, startTime);
+		dispatcher.tick(replayTime);
+		return;
+	}
+	dispatch(env, *record);
+	//The replay has got exactly as far as this record, or further if it was behind
+	replayTime = max(replayTime, record->timestamp);
+	advance();
+}
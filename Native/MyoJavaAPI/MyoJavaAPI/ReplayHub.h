@@ -0,0 +1,107 @@
+#pragma once
+#include <jni.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "MyoEvent.h"
+#include "MyoPeers.h"
+#include "EventDispatcher.h"
+#include "MyoProcessing.h"
+#include "SessionReader.h"
+
+/*
+ * The native object behind a Java ReplayHub: plays a session log back to EventListeners.
+ *
+ * It works like HubWrapper from the point of view of a listener, with run() and runOnce() dispatching events and
+ * the Java peers of its Myos kept in peers, except that the events come from a SessionReader instead of libmyo.
+ * Each MAC address in the log gets a native address of its own to stand in for a Myo. There is no C++ Myo behind
+ * that address, so the peers are replayed Myos, which never call into native code.
+ *
+ * Events are paced by their recorded timestamps, scaled by the speed (see setSpeed()). The replay only moves on
+ * while run() or runOnce() is running, so a program that stops calling them picks up where it left off.
+ * Listeners get the timestamps as they were recorded.
+ */
+class ReplayHub {
+
+public:
+	MyoProcessing processing;
+	MyoPeers peers;
+
+	//Throws a runtime_error if the file can't be read or isn't a session log.
+	explicit ReplayHub(const std::string &path);
+
+	//The destructor can't release Java references, so release() has to be called before deleting.
+	void release(JNIEnv *env);
+
+	//Same as HubWrapper::addListener() and HubWrapper::removeListener()
+	void addListener(EventListener *listener, const std::vector<myo::Myo*> &myos = std::vector<myo::Myo*>()) {
+		dispatcher.add(listener, myos);
+	}
+	void removeListener(EventListener *listener) {
+		dispatcher.remove(listener);
+	}
+
+	//0 replays as fast as possible, 1 in real time, and anything else that many times as fast as real time.
+	void setSpeed(double speed) {
+		this->speed = speed;
+	}
+
+	//Like Hub::run() and Hub::runOnce(), except that they return right away once every event has been replayed.
+	//The peer of an unpaired Myo is dropped after all listeners have seen the event.
+	void run(JNIEnv *env, unsigned int duration_ms);
+	void runOnce(JNIEnv *env, unsigned int duration_ms);
+
+	//Starts the replay over from the first event. Myos keep their native addresses, EMG filters
+	//and orientation references; the filters start over.
+	void rewind();
+	bool isFinished() const {
+		return blockIndex == reader.blocks().size();
+	}
+	uint64_t eventCount() const {
+		return reader.recordCount();
+	}
+	uint64_t replayedEvents() const {
+		return replayed;
+	}
+	//Whether the end of the log was cut off; see SessionReader
+	bool isTruncated() const {
+		return reader.isTruncated();
+	}
+
+private:
+	//Stands in for the Myo with this MAC address. Only its address is ever used.
+	struct ReplayMyo {
+		uint64_t macAddress;
+	};
+
+	SessionReader reader;
+	EventDispatcher dispatcher;
+	std::unordered_map<uint64_t, std::unique_ptr<ReplayMyo>> myos;
+	double speed;
+
+	//The next record to replay
+	size_t blockIndex;
+	uint32_t recordIndex;
+	uint64_t replayed;
+	//How far the replay has got, as a timestamp of the log
+	uint64_t replayTime;
+
+	const SessionRecord* current() const {
+		return isFinished() ? nullptr : &reader.blocks()[blockIndex].records[recordIndex];
+	}
+	void advance();
+	myo::Myo* lookupMyo(uint64_t macAddress);
+	void dispatch(JNIEnv *env, const SessionRecord &record);
+	//Waits until the record is due, for a run that started at start at a replayTime of startTime.
+	//Returns false without waiting if it isn't due before the deadline.
+	bool waitUntilDue(const SessionRecord &record, std::chrono::steady_clock::time_point start, uint64_t startTime,
+		std::chrono::steady_clock::time_point deadline) const;
+	//Moves replayTime on by the wall clock time since start, at the current speed
+	void advanceReplayTime(std::chrono::steady_clock::time_point start, uint64_t startTime);
+
+	ReplayHub(const ReplayHub&);
+	ReplayHub& operator=(const ReplayHub&);
+};
@@ -0,0 +1,45 @@
+#include "SessionReader.h"
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+SessionReader::SessionReader(const string &path) : file(path), records(0), truncated(false) {
+	//The records are read straight from memory
+	const uint16_t one = 1;
+	if (*reinterpret_cast<const uint8_t*>(&one) != 1) {
+		throw runtime_error("Session logs can only be read on little-endian machines");
+	}
+
+	if (file.size() < sizeof(SessionFileHeader) || memcmp(header().magic, sessionFileMagic, sizeof(sessionFileMagic)) != 0) {
+		throw runtime_error(path + " is not a session log");
+	}
+	const SessionFileHeader &fileHeader = header();
+	if (fileHeader.version != sessionFileVersion || fileHeader.headerSize != sizeof(SessionFileHeader) ||
+		fileHeader.recordSize != sizeof(SessionRecord) || fileHeader.blockHeaderSize != sizeof(SessionBlockHeader)) {
+		throw runtime_error(path + " is a session log of an unsupported version");
+	}
+
+	size_t offset = sizeof(SessionFileHeader);
+	uint32_t sequence = 0;
+	while (offset < file.size()) {
+		if (file.size() - offset < sizeof(SessionBlockHeader)) {
+			truncated = true;
+			break;
+		}
+		const SessionBlockHeader *blockHeader = reinterpret_cast<const SessionBlockHeader*>(file.data() + offset);
+		size_t recordBytes = static_cast<size_t>(blockHeader->recordCount) * sizeof(SessionRecord);
+		if (blockHeader->magic != sessionBlockMagic || blockHeader->sequence != sequence ||
+			blockHeader->recordCount > fileHeader.maxBlockRecords ||
+			file.size() - offset - sizeof(SessionBlockHeader) < recordBytes) {
+			truncated = true;
+			break;
+		}
+		offset += sizeof(SessionBlockHeader);
+		Block block = { reinterpret_cast<const SessionRecord*>(file.data() + offset), blockHeader->recordCount };
+		validBlocks.push_back(block);
+		records += blockHeader->recordCount;
+		offset += recordBytes;
+		sequence++;
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "SessionRecorder.h"
+
+/*
+ * Reads a session log (see SessionRecorder.h for the format) straight out of a memory mapping.
+ *
+ * The constructor walks the block headers once and remembers where the records of each block are; the records
+ * themselves are never copied. Reading stops at the first block that is incomplete or doesn't look like a block,
+ * so a log that was cut short reads up to its last complete block, the same as it was written.
+ */
+class SessionReader {
+
+public:
+	//The records of one block
+	struct Block {
+		const SessionRecord *records;
+		uint32_t count;
+	};
+
+	//Maps and checks the file. Throws a runtime_error if it can't be read or isn't a session log.
+	explicit SessionReader(const std::string &path);
+
+	const SessionFileHeader& header() const {
+		return *reinterpret_cast<const SessionFileHeader*>(file.data());
+	}
+	const std::vector<Block>& blocks() const {
+		return validBlocks;
+	}
+	uint64_t recordCount() const {
+		return records;
+	}
+	//Whether anything after the last complete block was ignored
+	bool isTruncated() const {
+		return truncated;
+	}
+
+private:
+	MappedFile file;
+	std::vector<Block> validBlocks;
+	uint64_t records;
+	bool truncated;
+};
@@ -0,0 +1,163 @@
+#include "SessionRecorder.h"
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+SessionRecorder::SessionRecorder(const string &path) : nextSequence(0), allocatedBlocks(0), current(nullptr),
+	currentFirstTimestamp(0), stopping(false), recordedCount(0), droppedCount(0) {
+	//The records are written straight from memory
+	const uint16_t one = 1;
+	if (*reinterpret_cast<const uint8_t*>(&one) != 1) {
+		throw runtime_error("Session logs can only be recorded on little-endian machines");
+	}
+
+	file = fopen(path.c_str(), "wb");
+	if (!file) {
+		throw runtime_error("Cannot create session log " + path);
+	}
+
+	SessionFileHeader header = {};
+	memcpy(header.magic, sessionFileMagic, sizeof(header.magic));
+	header.version = sessionFileVersion;
+	header.headerSize = sizeof(SessionFileHeader);
+	header.recordSize = sizeof(SessionRecord);
+	header.blockHeaderSize = sizeof(SessionBlockHeader);
+	header.maxBlockRecords = sessionBlockRecords;
+	header.createdTime = chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now().time_since_epoch()).count();
+	if (fwrite(&header, sizeof(header), 1, file) != 1) {
+		fclose(file);
+		throw runtime_error("Cannot write to session log " + path);
+	}
+
+	writerThread = thread(&SessionRecorder::writer, this);
+}
+
+SessionRecorder::~SessionRecorder() {
+	stop();
+	delete current;
+}
+
+SessionRecorder::Block* SessionRecorder::takeBlock() {
+	{
+		lock_guard<mutex> lock(blocksMutex);
+		if (!freeBlocks.empty()) {
+			Block *block = freeBlocks.back().release();
+			freeBlocks.pop_back();
+			return block;
+		}
+	}
+	if (allocatedBlocks == maxBlocks) {
+		return nullptr;
+	}
+	allocatedBlocks++;
+	return new Block();
+}
+
+void SessionRecorder::submitCurrent() {
+	{
+		lock_guard<mutex> lock(blocksMutex);
+		fullBlocks.emplace_back(current);
+	}
+	current = nullptr;
+	blocksCondition.notify_one();
+}
+
+void SessionRecorder::record(const MyoEvent &recorded, libmyo_event_t event) {
+	lock_guard<mutex> lock(currentMutex);
+	if (!current) {
+		current = takeBlock();
+		if (!current) {
+			droppedCount.fetch_add(1, memory_order_relaxed);
+			return;
+		}
+		current->header.magic = sessionBlockMagic;
+		current->header.recordCount = 0;
+		current->header.sequence = nextSequence++;
+		current->header.reserved = 0;
+		currentFirstTimestamp = recorded.timestamp;
+		currentStartTime = chrono::steady_clock::now();
+	}
+
+	myo::Myo *myo = recorded.myo();
+	auto it = macAddresses.find(myo);
+	if (it == macAddresses.end()) {
+		it = macAddresses.emplace(myo, libmyo_event_get_mac_address(event)).first;
+	}
+
+	SessionRecord &record = current->records[current->header.recordCount++];
+	record.macAddress = it->second;
+	record.timestamp = recorded.timestamp;
+	record.type = recorded.type;
+	record.reserved = 0;
+	record.data = recorded.data;
+	recordedCount.fetch_add(1, memory_order_relaxed);
+
+	if (current->header.recordCount == sessionBlockRecords || recorded.timestamp - currentFirstTimestamp >= maxBlockSpanUs) {
+		submitCurrent();
+	}
+}
+
+void SessionRecorder::submitExpired() {
+	lock_guard<mutex> lock(currentMutex);
+	if (current && chrono::steady_clock::now() - currentStartTime >= chrono::microseconds(maxBlockSpanUs)) {
+		//Blocks submitted before are already queued, so this one still goes after them
+		submitCurrent();
+	}
+}
+
+void SessionRecorder::writer() {
+	unique_lock<mutex> lock(blocksMutex);
+	for (;;) {
+		if (!blocksCondition.wait_for(lock, chrono::microseconds(maxBlockSpanUs), [this] {
+			return !fullBlocks.empty() || stopping;
+		})) {
+			lock.unlock();
+			submitExpired();
+			lock.lock();
+			continue;
+		}
+		if (fullBlocks.empty()) {
+			return;
+		}
+		unique_ptr<Block> block = move(fullBlocks.front());
+		fullBlocks.pop_front();
+
+		//Nothing else is written once an error has happened, so that the file stays valid up to that point
+		if (error.empty()) {
+			lock.unlock();
+			size_t size = sizeof(SessionBlockHeader) + block->header.recordCount * sizeof(SessionRecord);
+			bool written = fwrite(block.get(), size, 1, file) == 1 && fflush(file) == 0;
+			lock.lock();
+			if (!written) {
+				error = "Cannot write to session log";
+			}
+		}
+		freeBlocks.push_back(move(block));
+	}
+}
+
+string SessionRecorder::stop() {
+	if (!writerThread.joinable()) {
+		return error;
+	}
+	{
+		lock_guard<mutex> lock(currentMutex);
+		if (current && current->header.recordCount > 0) {
+			submitCurrent();
+		}
+	}
+	{
+		lock_guard<mutex> lock(blocksMutex);
+		stopping = true;
+	}
+	blocksCondition.notify_one();
+	writerThread.join();
+
+	if (fclose(file) != 0 && error.empty()) {
+		error = "Cannot write to session log";
+	}
+	file = nullptr;
+	return error;
+}
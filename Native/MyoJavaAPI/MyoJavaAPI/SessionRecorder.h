@@ -0,0 +1,147 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "MyoEvent.h"
+
+/*
+ * The session log file format.
+ *
+ * A session log is a SessionFileHeader followed by any number of blocks, each of which is a SessionBlockHeader
+ * followed by recordCount SessionRecords. Everything is little-endian and has a fixed size, so a reader can walk
+ * the file block by block without parsing anything. A block is only ever written whole, so a log cut short (say,
+ * by a crash) is still valid up to its last complete block.
+ *
+ * Records are in the order the events were received. Myos are identified by MAC address, since the native
+ * addresses in MyoEvents mean nothing outside of the process that recorded them.
+ */
+struct SessionFileHeader {
+	//"MYOSESS" followed by a zero byte
+	char magic[8];
+	uint32_t version;
+	uint32_t headerSize;
+	uint32_t recordSize;
+	uint32_t blockHeaderSize;
+	//Maximum number of records in a block
+	uint32_t maxBlockRecords;
+	uint32_t reserved0;
+	//Wall clock time the recording was started, in microseconds since the Unix epoch
+	uint64_t createdTime;
+	uint8_t reserved[24];
+};
+
+struct SessionBlockHeader {
+	//sessionBlockMagic
+	uint32_t magic;
+	uint32_t recordCount;
+	//Counts up from 0, so a reader can tell if blocks are missing
+	uint32_t sequence;
+	uint32_t reserved;
+};
+
+//A MyoEvent with the MAC address of its Myo in place of the native address.
+struct SessionRecord {
+	uint64_t macAddress;
+	uint64_t timestamp;
+	uint32_t type; //libmyo_event_type_t
+	uint32_t reserved;
+	MyoEvent::Data data;
+};
+
+const char sessionFileMagic[8] = { 'M', 'Y', 'O', 'S', 'E', 'S', 'S', 0 };
+const uint32_t sessionFileVersion = 1;
+//"MBLK" when read as bytes
+const uint32_t sessionBlockMagic = 0x4b4c424d;
+const uint32_t sessionBlockRecords = 1024;
+
+static_assert(sizeof(SessionFileHeader) == 64, "SessionFileHeader is part of the file format");
+static_assert(sizeof(SessionBlockHeader) == 16, "SessionBlockHeader is part of the file format");
+static_assert(sizeof(SessionRecord) == 64, "SessionRecord is part of the file format");
+
+/*
+ * Writes decoded events to a session log.
+ *
+ * record() only copies the event into the current block, which is handed to a writer thread once it is full (or
+ * once it spans a second of events), so the thread decoding events never waits for the disk. The writer also takes
+ * the current block itself once it has been open for a second, so a recording that goes quiet still reaches the
+ * disk, and flushes the file after every block. Finished blocks come from and go back to a small pool. If the writer
+ * falls so far behind that the pool is used up, events are dropped and counted instead of holding up the decoding
+ * thread.
+ */
+class SessionRecorder {
+
+public:
+	//Creates the file and starts the writer thread. Throws a runtime_error if the file can't be created.
+	explicit SessionRecorder(const std::string &path);
+	~SessionRecorder();
+
+	//Only one thread at a time may call this. event has to be the libmyo event that recorded was decoded from.
+	void record(const MyoEvent &recorded, libmyo_event_t event);
+	//Writes out the current block, waits for the writer thread to finish and closes the file.
+	//Returns the error that stopped the writer, or an empty string. Must not be called concurrently with record().
+	std::string stop();
+
+	uint64_t recordedEvents() const {
+		return recordedCount.load(std::memory_order_relaxed);
+	}
+	uint64_t droppedEvents() const {
+		return droppedCount.load(std::memory_order_relaxed);
+	}
+
+private:
+	struct Block {
+		SessionBlockHeader header;
+		SessionRecord records[sessionBlockRecords];
+	};
+	//Blocks that may exist at once; 64 blocks of 64KB each
+	static const size_t maxBlocks = 64;
+	//A block is handed to the writer once its events span this many microseconds, or once it has been open for
+	//that long, even if it isn't full
+	static const uint64_t maxBlockSpanUs = 1000000;
+
+	FILE *file;
+
+	//Only used by the recording thread
+	std::unordered_map<myo::Myo*, uint64_t> macAddresses;
+	uint32_t nextSequence;
+	size_t allocatedBlocks;
+
+	//Guards the current block. Held by the recording thread while it records an event, and by the writer while it
+	//takes a block that has been open for too long. Never taken while holding blocksMutex.
+	std::mutex currentMutex;
+	Block *current;
+	uint64_t currentFirstTimestamp;
+	std::chrono::steady_clock::time_point currentStartTime;
+
+	//Guards everything below
+	std::mutex blocksMutex;
+	std::condition_variable blocksCondition;
+	std::vector<std::unique_ptr<Block>> freeBlocks;
+	std::deque<std::unique_ptr<Block>> fullBlocks;
+	bool stopping;
+	std::string error;
+
+	std::thread writerThread;
+	std::atomic<uint64_t> recordedCount;
+	std::atomic<uint64_t> droppedCount;
+
+	//Gets an empty block from the pool, or allocates one. Returns nullptr if the pool is used up.
+	Block* takeBlock();
+	//Hands the current block to the writer. Called with currentMutex held.
+	void submitCurrent();
+	//Queues the current block if it has been open for maxBlockSpanUs. Writer only.
+	void submitExpired();
+	void writer();
+
+	SessionRecorder(const SessionRecorder&);
+	SessionRecorder& operator=(const SessionRecorder&);
+};
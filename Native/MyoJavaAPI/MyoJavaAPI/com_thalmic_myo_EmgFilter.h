@@ -0,0 +1,25 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_thalmic_myo_EmgFilter */
+
+#ifndef _Included_com_thalmic_myo_EmgFilter
+#define _Included_com_thalmic_myo_EmgFilter
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_thalmic_myo_EmgFilter_STAGE_NOTCH
+#define com_thalmic_myo_EmgFilter_STAGE_NOTCH 0L
+#undef com_thalmic_myo_EmgFilter_STAGE_HIGH_PASS
+#define com_thalmic_myo_EmgFilter_STAGE_HIGH_PASS 1L
+#undef com_thalmic_myo_EmgFilter_STAGE_LOW_PASS
+#define com_thalmic_myo_EmgFilter_STAGE_LOW_PASS 2L
+#undef com_thalmic_myo_EmgFilter_STAGE_RECTIFY
+#define com_thalmic_myo_EmgFilter_STAGE_RECTIFY 3L
+#undef com_thalmic_myo_EmgFilter_STAGE_ENVELOPE
+#define com_thalmic_myo_EmgFilter_STAGE_ENVELOPE 4L
+#undef com_thalmic_myo_EmgFilter_STAGE_SIZE
+#define com_thalmic_myo_EmgFilter_STAGE_SIZE 4L
+#ifdef __cplusplus
+}
+#endif
+#endif
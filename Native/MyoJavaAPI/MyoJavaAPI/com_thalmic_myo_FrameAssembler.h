@@ -0,0 +1,17 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_thalmic_myo_FrameAssembler */
+
+#ifndef _Included_com_thalmic_myo_FrameAssembler
+#define _Included_com_thalmic_myo_FrameAssembler
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_thalmic_myo_FrameAssembler_INTERPOLATION_NEAREST
+#define com_thalmic_myo_FrameAssembler_INTERPOLATION_NEAREST 0L
+#undef com_thalmic_myo_FrameAssembler_INTERPOLATION_LINEAR
+#define com_thalmic_myo_FrameAssembler_INTERPOLATION_LINEAR 1L
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -11,6 +11,64 @@ extern "C" {
 #define com_thalmic_myo_Hub_POLICY_NONE 0L
 #undef com_thalmic_myo_Hub_POLICY_STANDARD
 #define com_thalmic_myo_Hub_POLICY_STANDARD 1L
+#undef com_thalmic_myo_Hub_OVERFLOW_BLOCK
+#define com_thalmic_myo_Hub_OVERFLOW_BLOCK 0L
+#undef com_thalmic_myo_Hub_OVERFLOW_DROP_OLDEST
+#define com_thalmic_myo_Hub_OVERFLOW_DROP_OLDEST 1L
+#undef com_thalmic_myo_Hub_OVERFLOW_DROP_NEWEST
+#define com_thalmic_myo_Hub_OVERFLOW_DROP_NEWEST 2L
+#undef com_thalmic_myo_Hub_OVERFLOW_COALESCE
+#define com_thalmic_myo_Hub_OVERFLOW_COALESCE 3L
+#undef com_thalmic_myo_Hub_CALLBACK_PAIR
+#define com_thalmic_myo_Hub_CALLBACK_PAIR 1L
+#undef com_thalmic_myo_Hub_CALLBACK_UNPAIR
+#define com_thalmic_myo_Hub_CALLBACK_UNPAIR 2L
+#undef com_thalmic_myo_Hub_CALLBACK_CONNECT
+#define com_thalmic_myo_Hub_CALLBACK_CONNECT 4L
+#undef com_thalmic_myo_Hub_CALLBACK_DISCONNECT
+#define com_thalmic_myo_Hub_CALLBACK_DISCONNECT 8L
+#undef com_thalmic_myo_Hub_CALLBACK_ARM_SYNC
+#define com_thalmic_myo_Hub_CALLBACK_ARM_SYNC 16L
+#undef com_thalmic_myo_Hub_CALLBACK_ARM_UNSYNC
+#define com_thalmic_myo_Hub_CALLBACK_ARM_UNSYNC 32L
+#undef com_thalmic_myo_Hub_CALLBACK_UNLOCK
+#define com_thalmic_myo_Hub_CALLBACK_UNLOCK 64L
+#undef com_thalmic_myo_Hub_CALLBACK_LOCK
+#define com_thalmic_myo_Hub_CALLBACK_LOCK 128L
+#undef com_thalmic_myo_Hub_CALLBACK_POSE
+#define com_thalmic_myo_Hub_CALLBACK_POSE 256L
+#undef com_thalmic_myo_Hub_CALLBACK_ORIENTATION_DATA
+#define com_thalmic_myo_Hub_CALLBACK_ORIENTATION_DATA 512L
+#undef com_thalmic_myo_Hub_CALLBACK_ACCELEROMETER_DATA
+#define com_thalmic_myo_Hub_CALLBACK_ACCELEROMETER_DATA 1024L
+#undef com_thalmic_myo_Hub_CALLBACK_GYROSCOPE_DATA
+#define com_thalmic_myo_Hub_CALLBACK_GYROSCOPE_DATA 2048L
+#undef com_thalmic_myo_Hub_CALLBACK_RSSI
+#define com_thalmic_myo_Hub_CALLBACK_RSSI 4096L
+#undef com_thalmic_myo_Hub_CALLBACK_BATTERY_LEVEL_RECEIVED
+#define com_thalmic_myo_Hub_CALLBACK_BATTERY_LEVEL_RECEIVED 8192L
+#undef com_thalmic_myo_Hub_CALLBACK_EMG_DATA
+#define com_thalmic_myo_Hub_CALLBACK_EMG_DATA 16384L
+#undef com_thalmic_myo_Hub_CALLBACK_WARMUP_COMPLETED
+#define com_thalmic_myo_Hub_CALLBACK_WARMUP_COMPLETED 32768L
+#undef com_thalmic_myo_Hub_CALLBACK_EMG_BATCH
+#define com_thalmic_myo_Hub_CALLBACK_EMG_BATCH 65536L
+#undef com_thalmic_myo_Hub_CALLBACK_IMU_DATA
+#define com_thalmic_myo_Hub_CALLBACK_IMU_DATA 131072L
+#undef com_thalmic_myo_Hub_CALLBACK_ORIENTATION_RAW
+#define com_thalmic_myo_Hub_CALLBACK_ORIENTATION_RAW 262144L
+#undef com_thalmic_myo_Hub_CALLBACK_ACCELEROMETER_RAW
+#define com_thalmic_myo_Hub_CALLBACK_ACCELEROMETER_RAW 524288L
+#undef com_thalmic_myo_Hub_CALLBACK_GYROSCOPE_RAW
+#define com_thalmic_myo_Hub_CALLBACK_GYROSCOPE_RAW 1048576L
+#undef com_thalmic_myo_Hub_CALLBACK_EMG_FEATURES
+#define com_thalmic_myo_Hub_CALLBACK_EMG_FEATURES 2097152L
+#undef com_thalmic_myo_Hub_CALLBACK_EMG_FILTERED_DATA
+#define com_thalmic_myo_Hub_CALLBACK_EMG_FILTERED_DATA 4194304L
+#undef com_thalmic_myo_Hub_CALLBACK_EMG_FILTERED_BATCH
+#define com_thalmic_myo_Hub_CALLBACK_EMG_FILTERED_BATCH 8388608L
+#undef com_thalmic_myo_Hub_CALLBACK_ORIENTATION_EULER
+#define com_thalmic_myo_Hub_CALLBACK_ORIENTATION_EULER 16777216L
 	/*
 	* Class:     com_thalmic_myo_Hub
 	* Method:    _initHub
@@ -54,18 +112,58 @@ extern "C" {
 	/*
 	* Class:     com_thalmic_myo_Hub
 	* Method:    _waitForMyo
-	* Signature: (I)Z
+	* Signature: (I)Lcom/thalmic/myo/Myo;
 	*/
-	JNIEXPORT jboolean JNICALL Java_com_thalmic_myo_Hub__1waitForMyo
+	JNIEXPORT jobject JNICALL Java_com_thalmic_myo_Hub__1waitForMyo
 	(JNIEnv *, jobject, jint);
 
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _createListenerWrapper
+	* Signature: (JLcom/thalmic/myo/DeviceListener;I)J
+	*/
+	JNIEXPORT jlong JNICALL Java_com_thalmic_myo_Hub__1createListenerWrapper
+	(JNIEnv *, jclass, jlong, jobject, jint);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _deleteListenerWrapper
+	* Signature: (J)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1deleteListenerWrapper
+	(JNIEnv *, jclass, jlong);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _createFrameAssembler
+	* Signature: (Lcom/thalmic/myo/FrameListener;Lcom/thalmic/myo/SyncFrame;Ljava/nio/ByteBuffer;[JIII)J
+	*/
+	JNIEXPORT jlong JNICALL Java_com_thalmic_myo_Hub__1createFrameAssembler
+	(JNIEnv *, jclass, jobject, jobject, jobject, jlongArray, jint, jint, jint);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _deleteFrameAssembler
+	* Signature: (J)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1deleteFrameAssembler
+	(JNIEnv *, jclass, jlong);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _getPeers
+	* Signature: ()J
+	*/
+	JNIEXPORT jlong JNICALL Java_com_thalmic_myo_Hub__1getPeers
+	(JNIEnv *, jobject);
+
 	/*
 	* Class:     com_thalmic_myo_Hub
 	* Method:    _addDeviceListener
-	* Signature: (Lcom/thalmic/myo/DeviceListener;ZZZZZZZZZZZZZZZZ)J
+	* Signature: (J[J)V
 	*/
-	JNIEXPORT jlong JNICALL Java_com_thalmic_myo_Hub__1addDeviceListener
-	(JNIEnv *, jobject, jobject, jboolean, jboolean, jboolean, jboolean, jboolean, jboolean, jboolean, jboolean, jboolean, jboolean, jboolean, jboolean, jboolean, jboolean, jboolean, jboolean);
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1addDeviceListener
+	(JNIEnv *, jobject, jlong, jlongArray);
 
 	/*
 	* Class:     com_thalmic_myo_Hub
@@ -75,6 +173,126 @@ extern "C" {
 	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1removeDeviceListener
 	(JNIEnv *, jobject, jlong);
 
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _addFrameListener
+	* Signature: (J)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1addFrameListener
+	(JNIEnv *, jobject, jlong);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _removeFrameListener
+	* Signature: (J)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1removeFrameListener
+	(JNIEnv *, jobject, jlong);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _setEmgBatching
+	* Signature: (JII)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1setEmgBatching
+	(JNIEnv *, jclass, jlong, jint, jint);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _flushEmgBatches
+	* Signature: (J)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1flushEmgBatches
+	(JNIEnv *, jclass, jlong);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _setEmgFeatures
+	* Signature: (JII)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1setEmgFeatures
+	(JNIEnv *, jclass, jlong, jint, jint);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _startAsync
+	* Signature: (II)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1startAsync
+	(JNIEnv *, jobject, jint, jint);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _stopAsync
+	* Signature: ()V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1stopAsync
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _poll
+	* Signature: (Ljava/nio/ByteBuffer;[Lcom/thalmic/myo/Myo;II)I
+	*/
+	JNIEXPORT jint JNICALL Java_com_thalmic_myo_Hub__1poll
+	(JNIEnv *, jobject, jobject, jobjectArray, jint, jint);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _getDroppedEventCount
+	* Signature: ()J
+	*/
+	JNIEXPORT jlong JNICALL Java_com_thalmic_myo_Hub__1getDroppedEventCount
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _getQueuedEventCount
+	* Signature: ()I
+	*/
+	JNIEXPORT jint JNICALL Java_com_thalmic_myo_Hub__1getQueuedEventCount
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _getQueueStats
+	* Signature: ()[J
+	*/
+	JNIEXPORT jlongArray JNICALL Java_com_thalmic_myo_Hub__1getQueueStats
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _getState
+	* Signature: (J)Ljava/nio/ByteBuffer;
+	*/
+	JNIEXPORT jobject JNICALL Java_com_thalmic_myo_Hub__1getState
+	(JNIEnv *, jobject, jlong);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _startRecording
+	* Signature: (Ljava/lang/String;)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1startRecording
+	(JNIEnv *, jobject, jstring);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _stopRecording
+	* Signature: ()V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Hub__1stopRecording
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_Hub
+	* Method:    _getRecordingDroppedEventCount
+	* Signature: ()J
+	*/
+	JNIEXPORT jlong JNICALL Java_com_thalmic_myo_Hub__1getRecordingDroppedEventCount
+	(JNIEnv *, jobject);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,11 +1,19 @@
 #include "com_thalmic_myo_Myo.h"
+#include "JNICache.h"
+#include "MyoProcessing.h"
 #include <myo/myo.hpp>
+#include <stdexcept>
+#include <vector>
 
+using namespace std;
 using namespace myo;
 
-Myo* getPointer(JNIEnv *env, jobject obj) {
-	jfieldID fid = env->GetFieldID(env->GetObjectClass(obj), "_nativePointer", "J");
-	return reinterpret_cast<Myo*>(env->GetLongField(obj, fid));
+static Myo* getPointer(JNIEnv *env, jobject obj) {
+	return reinterpret_cast<Myo*>(env->GetLongField(obj, jniCache.myoPointerFid));
+}
+
+static MyoProcessing* getProcessing(JNIEnv *env, jobject obj) {
+	return reinterpret_cast<MyoProcessing*>(env->GetLongField(obj, jniCache.myoProcessingFid));
 }
 
 JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1vibrate(JNIEnv *env, jobject obj, jint type) {
@@ -52,4 +60,91 @@ JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1setStreamEmg(JNIEnv *env, jobj
 	else {
 		getPointer(env, obj)->setStreamEmg(Myo::streamEmgEnabled);
 	}
-}
\ No newline at end of file
+}
+JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1setEmgFilter(JNIEnv *env, jobject obj, jdoubleArray stages) {
+	MyoProcessing *processing = getProcessing(env, obj);
+	if (!processing) {
+		return;
+	}
+	if (!stages) {
+		processing->filters.clear(getPointer(env, obj));
+		return;
+	}
+
+	//Every stage is STAGE_SIZE doubles: type, frequency, quality factor and frames
+	jsize length = env->GetArrayLength(stages);
+	vector<double> values(length);
+	env->GetDoubleArrayRegion(stages, 0, length, values.data());
+	vector<EmgFilterStage> specs;
+	for (jsize i = 0; i + com_thalmic_myo_EmgFilter_STAGE_SIZE <= length; i += com_thalmic_myo_EmgFilter_STAGE_SIZE) {
+		EmgFilterStage spec;
+		spec.type = static_cast<int>(values[i]);
+		spec.frequency = values[i + 1];
+		spec.q = values[i + 2];
+		spec.frames = static_cast<uint32_t>(values[i + 3]);
+		specs.push_back(spec);
+	}
+
+	try {
+		processing->filters.set(getPointer(env, obj), specs);
+	}
+	catch (invalid_argument &e) {
+		jclass exceptionClass = env->FindClass("java/lang/IllegalArgumentException");
+		env->ThrowNew(exceptionClass, e.what());
+	}
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1setOrientationSmoothing(JNIEnv *env, jobject obj, jint mode, jdouble factor,
+	jdouble minCutoff, jdouble beta, jdouble derivativeCutoff) {
+	MyoProcessing *processing = getProcessing(env, obj);
+	if (processing) {
+		//The parameters were checked by OrientationSmoothing
+		OrientationSmoothing smoothing = { mode, static_cast<float>(factor), static_cast<float>(minCutoff),
+			static_cast<float>(beta), static_cast<float>(derivativeCutoff) };
+		processing->smoother.set(getPointer(env, obj), smoothing);
+	}
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1setOrientationReference(JNIEnv *env, jobject obj, jdouble x, jdouble y, jdouble z, jdouble w) {
+	MyoProcessing *processing = getProcessing(env, obj);
+	if (processing) {
+		Quaternion<float> reference(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z), static_cast<float>(w));
+		processing->orientation.setReference(getPointer(env, obj), reference);
+	}
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1clearOrientationReference(JNIEnv *env, jobject obj) {
+	MyoProcessing *processing = getProcessing(env, obj);
+	if (processing) {
+		processing->orientation.clearReference(getPointer(env, obj));
+	}
+}
+
+JNIEXPORT jboolean JNICALL Java_com_thalmic_myo_Myo__1centerOrientation(JNIEnv *env, jobject obj) {
+	MyoProcessing *processing = getProcessing(env, obj);
+	if (!processing) {
+		return JNI_FALSE;
+	}
+	processing->orientation.center(getPointer(env, obj));
+	return JNI_TRUE;
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1setHistory(JNIEnv *env, jobject obj, jint stream, jint capacityMs) {
+	MyoProcessing *processing = getProcessing(env, obj);
+	if (processing) {
+		processing->history.set(getPointer(env, obj), stream, static_cast<uint32_t>(capacityMs));
+	}
+}
+
+JNIEXPORT jint JNICALL Java_com_thalmic_myo_Myo__1getHistory(JNIEnv *env, jobject obj, jint stream, jint durationMs, jobject buffer,
+	jint position, jint remaining) {
+	MyoProcessing *processing = getProcessing(env, obj);
+	if (!processing) {
+		return 0;
+	}
+	//Java checked that the buffer is direct and writable, and passes its position and remaining bytes
+	unsigned char *out = static_cast<unsigned char*>(env->GetDirectBufferAddress(buffer)) + position;
+	size_t maxRecords = static_cast<size_t>(remaining) / MyoHistory::recordSize(stream);
+	return static_cast<jint>(processing->history.copyWindow(getPointer(env, obj), stream, static_cast<uint64_t>(durationMs) * 1000,
+		out, maxRecords));
+}
@@ -21,6 +21,10 @@ extern "C" {
 #define com_thalmic_myo_Myo_SET_DISABLED 0L
 #undef com_thalmic_myo_Myo_SET_ENABLED
 #define com_thalmic_myo_Myo_SET_ENABLED 1L
+#undef com_thalmic_myo_Myo_HISTORY_IMU
+#define com_thalmic_myo_Myo_HISTORY_IMU 0L
+#undef com_thalmic_myo_Myo_HISTORY_EMG
+#define com_thalmic_myo_Myo_HISTORY_EMG 1L
 	/*
 	* Class:     com_thalmic_myo_Myo
 	* Method:    _vibrate
@@ -77,6 +81,62 @@ extern "C" {
 	JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1setStreamEmg
 	(JNIEnv *, jobject, jint);
 
+	/*
+	* Class:     com_thalmic_myo_Myo
+	* Method:    _setEmgFilter
+	* Signature: ([D)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1setEmgFilter
+	(JNIEnv *, jobject, jdoubleArray);
+
+	/*
+	* Class:     com_thalmic_myo_Myo
+	* Method:    _setOrientationSmoothing
+	* Signature: (IDDDD)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1setOrientationSmoothing
+	(JNIEnv *, jobject, jint, jdouble, jdouble, jdouble, jdouble);
+
+	/*
+	* Class:     com_thalmic_myo_Myo
+	* Method:    _setOrientationReference
+	* Signature: (DDDD)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1setOrientationReference
+	(JNIEnv *, jobject, jdouble, jdouble, jdouble, jdouble);
+
+	/*
+	* Class:     com_thalmic_myo_Myo
+	* Method:    _clearOrientationReference
+	* Signature: ()V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1clearOrientationReference
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_Myo
+	* Method:    _centerOrientation
+	* Signature: ()Z
+	*/
+	JNIEXPORT jboolean JNICALL Java_com_thalmic_myo_Myo__1centerOrientation
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_Myo
+	* Method:    _setHistory
+	* Signature: (II)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_Myo__1setHistory
+	(JNIEnv *, jobject, jint, jint);
+
+	/*
+	* Class:     com_thalmic_myo_Myo
+	* Method:    _getHistory
+	* Signature: (IILjava/nio/ByteBuffer;II)I
+	*/
+	JNIEXPORT jint JNICALL Java_com_thalmic_myo_Myo__1getHistory
+	(JNIEnv *, jobject, jint, jint, jobject, jint, jint);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,19 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_thalmic_myo_OrientationSmoothing */
+
+#ifndef _Included_com_thalmic_myo_OrientationSmoothing
+#define _Included_com_thalmic_myo_OrientationSmoothing
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_thalmic_myo_OrientationSmoothing_MODE_NONE
+#define com_thalmic_myo_OrientationSmoothing_MODE_NONE 0L
+#undef com_thalmic_myo_OrientationSmoothing_MODE_EXPONENTIAL
+#define com_thalmic_myo_OrientationSmoothing_MODE_EXPONENTIAL 1L
+#undef com_thalmic_myo_OrientationSmoothing_MODE_ONE_EURO
+#define com_thalmic_myo_OrientationSmoothing_MODE_ONE_EURO 2L
+#ifdef __cplusplus
+}
+#endif
+#endif
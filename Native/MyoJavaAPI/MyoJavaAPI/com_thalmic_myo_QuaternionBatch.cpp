@@ -0,0 +1,43 @@
+#include "com_thalmic_myo_QuaternionBatch.h"
+#include "QuaternionBatch.h"
+
+//Java checks that every buffer is direct, in native order, and holds enough elements, and passes slices of them, so
+//the address of a buffer is the address of its first element.
+static float* address(JNIEnv *env, jobject buffer) {
+	return static_cast<float*>(env->GetDirectBufferAddress(buffer));
+}
+
+static float* component(JNIEnv *env, jobjectArray components, jsize index) {
+	jobject buffer = env->GetObjectArrayElement(components, index);
+	float *result = address(env, buffer);
+	env->DeleteLocalRef(buffer);
+	return result;
+}
+
+static QuaternionArrays<float> quaternions(JNIEnv *env, jobjectArray components) {
+	QuaternionArrays<float> arrays = { component(env, components, 0), component(env, components, 1),
+		component(env, components, 2), component(env, components, 3) };
+	return arrays;
+}
+
+static Vector3Arrays<float> vectors(JNIEnv *env, jobjectArray components) {
+	Vector3Arrays<float> arrays = { component(env, components, 0), component(env, components, 1),
+		component(env, components, 2) };
+	return arrays;
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_QuaternionBatch__1multiply(JNIEnv *env, jclass clazz, jobjectArray a, jobjectArray b, jobjectArray out, jint count) {
+	multiplyBatch(quaternions(env, a), quaternions(env, b), quaternions(env, out), static_cast<size_t>(count));
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_QuaternionBatch__1rotate(JNIEnv *env, jclass clazz, jobjectArray q, jobjectArray v, jobjectArray out, jint count) {
+	rotateBatch(quaternions(env, q), vectors(env, v), vectors(env, out), static_cast<size_t>(count));
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_QuaternionBatch__1normalize(JNIEnv *env, jclass clazz, jobjectArray q, jobjectArray out, jint count) {
+	normalizeBatch(quaternions(env, q), quaternions(env, out), static_cast<size_t>(count));
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_QuaternionBatch__1slerp(JNIEnv *env, jclass clazz, jobjectArray a, jobjectArray b, jobject t, jobjectArray out, jint count) {
+	slerpBatch(quaternions(env, a), quaternions(env, b), address(env, t), quaternions(env, out), static_cast<size_t>(count));
+}
@@ -0,0 +1,45 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_thalmic_myo_QuaternionBatch */
+
+#ifndef _Included_com_thalmic_myo_QuaternionBatch
+#define _Included_com_thalmic_myo_QuaternionBatch
+#ifdef __cplusplus
+extern "C" {
+#endif
+	/*
+	* Class:     com_thalmic_myo_QuaternionBatch
+	* Method:    _multiply
+	* Signature: ([Ljava/nio/FloatBuffer;[Ljava/nio/FloatBuffer;[Ljava/nio/FloatBuffer;I)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_QuaternionBatch__1multiply
+	(JNIEnv *, jclass, jobjectArray, jobjectArray, jobjectArray, jint);
+
+	/*
+	* Class:     com_thalmic_myo_QuaternionBatch
+	* Method:    _rotate
+	* Signature: ([Ljava/nio/FloatBuffer;[Ljava/nio/FloatBuffer;[Ljava/nio/FloatBuffer;I)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_QuaternionBatch__1rotate
+	(JNIEnv *, jclass, jobjectArray, jobjectArray, jobjectArray, jint);
+
+	/*
+	* Class:     com_thalmic_myo_QuaternionBatch
+	* Method:    _normalize
+	* Signature: ([Ljava/nio/FloatBuffer;[Ljava/nio/FloatBuffer;I)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_QuaternionBatch__1normalize
+	(JNIEnv *, jclass, jobjectArray, jobjectArray, jint);
+
+	/*
+	* Class:     com_thalmic_myo_QuaternionBatch
+	* Method:    _slerp
+	* Signature: ([Ljava/nio/FloatBuffer;[Ljava/nio/FloatBuffer;Ljava/nio/FloatBuffer;[Ljava/nio/FloatBuffer;I)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_QuaternionBatch__1slerp
+	(JNIEnv *, jclass, jobjectArray, jobjectArray, jobject, jobjectArray, jint);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
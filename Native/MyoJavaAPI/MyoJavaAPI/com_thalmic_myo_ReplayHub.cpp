@@ -0,0 +1,90 @@
+#include "com_thalmic_myo_ReplayHub.h"
+#include "JNICache.h"
+#include "ReplayHub.h"
+#include "ListenerWrapper.h"
+#include "FrameListenerWrapper.h"
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+static ReplayHub* getPointer(JNIEnv *env, jobject obj) {
+	return reinterpret_cast<ReplayHub*>(env->GetLongField(obj, jniCache.replayHubPointerFid));
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1open(JNIEnv *env, jobject obj, jstring path) {
+	const char *pathNative = env->GetStringUTFChars(path, 0);
+	string pathString(pathNative);
+	env->ReleaseStringUTFChars(path, pathNative);
+	try {
+		ReplayHub *hub = new ReplayHub(pathString);
+		env->SetLongField(obj, jniCache.replayHubPointerFid, reinterpret_cast<jlong>(hub));
+	}
+	catch (runtime_error &e) {
+		jclass exceptionClass = env->FindClass("java/io/IOException");
+		env->ThrowNew(exceptionClass, e.what());
+	}
+	catch (...) {
+		jclass exceptionClass = env->FindClass("java/lang/Exception");
+		env->ThrowNew(exceptionClass, "Unexpected error");
+	}
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1release(JNIEnv *env, jobject obj) {
+	ReplayHub *hub = getPointer(env, obj);
+	hub->release(env);
+	delete hub;
+}
+
+JNIEXPORT jlong JNICALL Java_com_thalmic_myo_ReplayHub__1getPeers(JNIEnv *env, jobject obj) {
+	return reinterpret_cast<jlong>(&getPointer(env, obj)->peers);
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1addDeviceListener(JNIEnv *env, jobject obj, jlong address, jlongArray myos) {
+	getPointer(env, obj)->addListener(reinterpret_cast<ListenerWrapper*>(address), toMyos(env, myos));
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1removeDeviceListener(JNIEnv *env, jobject obj, jlong address) {
+	getPointer(env, obj)->removeListener(reinterpret_cast<ListenerWrapper*>(address));
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1addFrameListener(JNIEnv *env, jobject obj, jlong address) {
+	FrameListenerWrapper *wrapper = reinterpret_cast<FrameListenerWrapper*>(address);
+	getPointer(env, obj)->addListener(wrapper, wrapper->assembler.myos());
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1removeFrameListener(JNIEnv *env, jobject obj, jlong address) {
+	getPointer(env, obj)->removeListener(reinterpret_cast<FrameListenerWrapper*>(address));
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1setSpeed(JNIEnv *env, jobject obj, jdouble speed) {
+	getPointer(env, obj)->setSpeed(speed);
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1run(JNIEnv *env, jobject obj, jint duration) {
+	getPointer(env, obj)->run(env, duration);
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1runOnce(JNIEnv *env, jobject obj, jint duration) {
+	getPointer(env, obj)->runOnce(env, duration);
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1rewind(JNIEnv *env, jobject obj) {
+	getPointer(env, obj)->rewind();
+}
+
+JNIEXPORT jboolean JNICALL Java_com_thalmic_myo_ReplayHub__1isFinished(JNIEnv *env, jobject obj) {
+	return getPointer(env, obj)->isFinished() ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jlong JNICALL Java_com_thalmic_myo_ReplayHub__1getEventCount(JNIEnv *env, jobject obj) {
+	return static_cast<jlong>(getPointer(env, obj)->eventCount());
+}
+
+JNIEXPORT jlong JNICALL Java_com_thalmic_myo_ReplayHub__1getReplayedEventCount(JNIEnv *env, jobject obj) {
+	return static_cast<jlong>(getPointer(env, obj)->replayedEvents());
+}
+
+JNIEXPORT jboolean JNICALL Java_com_thalmic_myo_ReplayHub__1isTruncated(JNIEnv *env, jobject obj) {
+	return getPointer(env, obj)->isTruncated() ? JNI_TRUE : JNI_FALSE;
+}
@@ -0,0 +1,133 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_thalmic_myo_ReplayHub */
+
+#ifndef _Included_com_thalmic_myo_ReplayHub
+#define _Included_com_thalmic_myo_ReplayHub
+#ifdef __cplusplus
+extern "C" {
+#endif
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _open
+	* Signature: (Ljava/lang/String;)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1open
+	(JNIEnv *, jobject, jstring);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _release
+	* Signature: ()V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1release
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _getPeers
+	* Signature: ()J
+	*/
+	JNIEXPORT jlong JNICALL Java_com_thalmic_myo_ReplayHub__1getPeers
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _addDeviceListener
+	* Signature: (J[J)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1addDeviceListener
+	(JNIEnv *, jobject, jlong, jlongArray);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _removeDeviceListener
+	* Signature: (J)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1removeDeviceListener
+	(JNIEnv *, jobject, jlong);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _addFrameListener
+	* Signature: (J)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1addFrameListener
+	(JNIEnv *, jobject, jlong);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _removeFrameListener
+	* Signature: (J)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1removeFrameListener
+	(JNIEnv *, jobject, jlong);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _setSpeed
+	* Signature: (D)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1setSpeed
+	(JNIEnv *, jobject, jdouble);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _run
+	* Signature: (I)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1run
+	(JNIEnv *, jobject, jint);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _runOnce
+	* Signature: (I)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1runOnce
+	(JNIEnv *, jobject, jint);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _rewind
+	* Signature: ()V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_ReplayHub__1rewind
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _isFinished
+	* Signature: ()Z
+	*/
+	JNIEXPORT jboolean JNICALL Java_com_thalmic_myo_ReplayHub__1isFinished
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _getEventCount
+	* Signature: ()J
+	*/
+	JNIEXPORT jlong JNICALL Java_com_thalmic_myo_ReplayHub__1getEventCount
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _getReplayedEventCount
+	* Signature: ()J
+	*/
+	JNIEXPORT jlong JNICALL Java_com_thalmic_myo_ReplayHub__1getReplayedEventCount
+	(JNIEnv *, jobject);
+
+	/*
+	* Class:     com_thalmic_myo_ReplayHub
+	* Method:    _isTruncated
+	* Signature: ()Z
+	*/
+	JNIEXPORT jboolean JNICALL Java_com_thalmic_myo_ReplayHub__1isTruncated
+	(JNIEnv *, jobject);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
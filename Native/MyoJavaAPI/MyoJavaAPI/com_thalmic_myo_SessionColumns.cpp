@@ -0,0 +1,29 @@
+#include "com_thalmic_myo_SessionColumns.h"
+#include "ColumnExport.h"
+#include "SessionReader.h"
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+static string toString(JNIEnv *env, jstring string) {
+	const char *chars = env->GetStringUTFChars(string, 0);
+	std::string result(chars);
+	env->ReleaseStringUTFChars(string, chars);
+	return result;
+}
+
+JNIEXPORT void JNICALL Java_com_thalmic_myo_SessionColumns__1export(JNIEnv *env, jclass clazz, jstring sessionPath, jstring columnPath) {
+	try {
+		SessionReader reader(toString(env, sessionPath));
+		exportColumns(reader, toString(env, columnPath));
+	}
+	catch (runtime_error &e) {
+		jclass exceptionClass = env->FindClass("java/io/IOException");
+		env->ThrowNew(exceptionClass, e.what());
+	}
+	catch (...) {
+		jclass exceptionClass = env->FindClass("java/lang/Exception");
+		env->ThrowNew(exceptionClass, "Unexpected error");
+	}
+}
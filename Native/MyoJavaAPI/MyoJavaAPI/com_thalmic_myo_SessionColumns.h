@@ -0,0 +1,21 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_thalmic_myo_SessionColumns */
+
+#ifndef _Included_com_thalmic_myo_SessionColumns
+#define _Included_com_thalmic_myo_SessionColumns
+#ifdef __cplusplus
+extern "C" {
+#endif
+	/*
+	* Class:     com_thalmic_myo_SessionColumns
+	* Method:    _export
+	* Signature: (Ljava/lang/String;Ljava/lang/String;)V
+	*/
+	JNIEXPORT void JNICALL Java_com_thalmic_myo_SessionColumns__1export
+	(JNIEnv *, jclass, jstring, jstring);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -6,6 +6,8 @@
 
 #include <myo/libmyo.h>
 
+#include "detail/MyoIndex.hpp"
+
 namespace myo {
 
 class Myo;
@@ -66,12 +68,22 @@ public:
 protected:
     void onDeviceEvent(libmyo_event_t event);
 
+    /// Return the Myo of a paired device, or null if the handle doesn't belong to one.
     Myo* lookupMyo(libmyo_myo_t opaqueMyo) const;
 
+    /// Return the Myo for a newly paired device. A device that was paired before gets its old Myo back.
     Myo* addMyo(libmyo_myo_t opaqueMyo);
 
+    /// Stop looking up events of an unpaired device. Its Myo stays valid until the Hub is destroyed.
+    void retireMyo(libmyo_myo_t opaqueMyo);
+
     libmyo_hub_t _hub;
+    /// Every Myo ever paired, one per device.
     std::vector<Myo*> _myos;
+    /// Paired Myos by libmyo handle.
+    detail::MyoIndex<libmyo_myo_t> _myoIndex;
+    /// All of _myos by MAC address.
+    detail::MyoIndex<uint64_t> _macIndex;
     std::vector<DeviceListener*> _listeners;
 
     /// @endcond
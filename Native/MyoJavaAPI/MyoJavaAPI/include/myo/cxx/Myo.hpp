@@ -2,6 +2,8 @@
 // Distributed under the Myo SDK license agreement. See LICENSE.txt for details.
 #pragma once
 
+#include <atomic>
+
 #include <myo/libmyo.h>
 
 namespace myo {
@@ -69,7 +71,8 @@ private:
     Myo(libmyo_myo_t myo);
     ~Myo();
 
-    libmyo_myo_t _myo;
+    // Hub replaces the handle when the device re-pairs, possibly while another thread is using this Myo.
+    std::atomic<libmyo_myo_t> _myo;
 
     // Not implemented.
     Myo(const Myo&);
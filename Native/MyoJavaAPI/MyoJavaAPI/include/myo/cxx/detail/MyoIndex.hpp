@@ -0,0 +1,165 @@
+// Copyright (C) 2013-2014 Thalmic Labs Inc.
+// Distributed under the Myo SDK license agreement. See LICENSE.txt for details.
+#ifndef MYO_CXX_DETAIL_MYOINDEX_HPP
+#define MYO_CXX_DETAIL_MYOINDEX_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <stdint.h>
+
+namespace myo {
+
+class Myo;
+
+namespace detail {
+
+/// @cond MYO_INTERNALS
+
+inline uint64_t indexKeyBits(const void* key)
+{
+    return reinterpret_cast<uintptr_t>(key);
+}
+
+inline uint64_t indexKeyBits(uint64_t key)
+{
+    return key;
+}
+
+/// An open-addressing hash map from a libmyo handle or a MAC address to a Myo, with linear probing.
+/// A lookup hashes the key and usually reads a single slot of one contiguous array, no matter how many Myos there
+/// are. The zero key marks an empty slot, so it can't be stored; neither null handles nor MAC addresses of zero
+/// belong to a Myo.
+template<typename Key>
+class MyoIndex {
+public:
+    MyoIndex()
+    : _slots(16)
+    , _size(0)
+    {
+    }
+
+    /// Return the Myo stored for \a key, or null if there is none.
+    Myo* find(Key key) const
+    {
+        if (key == Key()) {
+            return 0;
+        }
+        std::size_t mask = _slots.size() - 1;
+        for (std::size_t i = hash(key) & mask; ; i = (i + 1) & mask) {
+            const Slot& slot = _slots[i];
+            if (slot.key == key) {
+                return slot.myo;
+            }
+            if (slot.key == Key()) {
+                return 0;
+            }
+        }
+    }
+
+    /// Store \a myo for \a key, replacing any Myo already stored for it.
+    void insert(Key key, Myo* myo)
+    {
+        if (key == Key()) {
+            return;
+        }
+        // Keep the table at most half full, so that probe sequences stay short
+        if ((_size + 1) * 2 > _slots.size()) {
+            grow();
+        }
+        place(key, myo);
+    }
+
+    /// Remove the Myo stored for \a key, if there is one.
+    void erase(Key key)
+    {
+        if (key == Key()) {
+            return;
+        }
+        std::size_t mask = _slots.size() - 1;
+        std::size_t i = hash(key) & mask;
+        while (_slots[i].key != key) {
+            if (_slots[i].key == Key()) {
+                return;
+            }
+            i = (i + 1) & mask;
+        }
+
+        // Shift later slots of the probe sequence back into the hole, instead of leaving a tombstone
+        for (std::size_t j = (i + 1) & mask; _slots[j].key != Key(); j = (j + 1) & mask) {
+            std::size_t home = hash(_slots[j].key) & mask;
+            bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+            if (!stays) {
+                _slots[i] = _slots[j];
+                i = j;
+            }
+        }
+        _slots[i] = Slot();
+        --_size;
+    }
+
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+private:
+    struct Slot {
+        Key key;
+        Myo* myo;
+
+        Slot()
+        : key()
+        , myo(0)
+        {
+        }
+    };
+
+    std::vector<Slot> _slots;
+    std::size_t _size;
+
+    static std::size_t hash(Key key)
+    {
+        // Handles are aligned pointers and MAC addresses share their vendor prefix, so the bits are mixed
+        // before they are masked
+        uint64_t bits = indexKeyBits(key);
+        bits ^= bits >> 33;
+        bits *= 0xff51afd7ed558ccdULL;
+        bits ^= bits >> 33;
+        return static_cast<std::size_t>(bits);
+    }
+
+    void place(Key key, Myo* myo)
+    {
+        std::size_t mask = _slots.size() - 1;
+        std::size_t i = hash(key) & mask;
+        while (_slots[i].key != Key() && _slots[i].key != key) {
+            i = (i + 1) & mask;
+        }
+        if (_slots[i].key == Key()) {
+            ++_size;
+        }
+        _slots[i].key = key;
+        _slots[i].myo = myo;
+    }
+
+    void grow()
+    {
+        std::vector<Slot> old(_slots.size() * 2);
+        old.swap(_slots);
+        _size = 0;
+        for (typename std::vector<Slot>::const_iterator I = old.begin(), IE = old.end(); I != IE; ++I) {
+            if (I->key != Key()) {
+                place(I->key, I->myo);
+            }
+        }
+    }
+};
+
+/// @endcond
+
+} // namespace detail
+
+} // namespace myo
+
+#endif // MYO_CXX_DETAIL_MYOINDEX_HPP
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <exception>
+#include <stdexcept>
 
 #include "../DeviceListener.hpp"
 #include "../Myo.hpp"
@@ -18,6 +19,8 @@ inline
 Hub::Hub(const std::string& applicationIdentifier)
 : _hub(0)
 , _myos()
+, _myoIndex()
+, _macIndex()
 , _listeners()
 {
     libmyo_init_hub(&_hub, applicationIdentifier.c_str(), ThrowOnError());
@@ -35,17 +38,18 @@ Hub::~Hub()
 inline
 Myo* Hub::waitForMyo(unsigned int timeout_ms)
 {
-    std::size_t prevSize = _myos.size();
-
     struct local {
+        Hub* hub;
+        Myo* myo;
+
         static libmyo_handler_result_t handler(void* user_data, libmyo_event_t event) {
-            Hub* hub = static_cast<Hub*>(user_data);
+            local* context = static_cast<local*>(user_data);
 
             libmyo_myo_t opaque_myo = libmyo_event_get_myo(event);
 
             switch (libmyo_event_get_type(event)) {
             case libmyo_event_paired:
-                hub->addMyo(opaque_myo);
+                context->myo = context->hub->addMyo(opaque_myo);
                 return libmyo_handler_stop;
             default:
                 break;
@@ -55,15 +59,13 @@ Myo* Hub::waitForMyo(unsigned int timeout_ms)
         }
     };
 
+    // A device that paired before gets its old Myo back, so the number of Myos doesn't tell whether one was found
+    local context = { this, 0 };
     do {
-        libmyo_run(_hub, timeout_ms ? timeout_ms : 1000, &local::handler, this, ThrowOnError());
-    } while (!timeout_ms && _myos.size() <= prevSize);
-
-    if (_myos.size() <= prevSize) {
-        return 0;
-    }
+        libmyo_run(_hub, timeout_ms ? timeout_ms : 1000, &local::handler, &context, ThrowOnError());
+    } while (!timeout_ms && !context.myo);
 
-    return _myos.back();
+    return context.myo;
 }
 
 inline
@@ -200,6 +202,10 @@ void Hub::onDeviceEvent(libmyo_event_t event)
         }
         }
     }
+
+    if (libmyo_event_get_type(event) == libmyo_event_unpaired) {
+        retireMyo(opaqueMyo);
+    }
 }
 
 inline
@@ -241,25 +247,36 @@ libmyo_hub_t Hub::libmyoObject()
 inline
 Myo* Hub::lookupMyo(libmyo_myo_t opaqueMyo) const
 {
-    Myo* myo = 0;
-    for (std::vector<Myo*>::const_iterator I = _myos.begin(), IE = _myos.end(); I != IE; ++I) {
-        if ((*I)->libmyoObject() == opaqueMyo) {
-            myo = *I;
-            break;
-        }
-    }
-
-    return myo;
+    return _myoIndex.find(opaqueMyo);
 }
 
 inline
 Myo* Hub::addMyo(libmyo_myo_t opaqueMyo)
 {
-    Myo* myo = new Myo(opaqueMyo);
-
-    _myos.push_back(myo);
+    if (!opaqueMyo) {
+        throw std::invalid_argument("Cannot construct Myo instance with null pointer");
+    }
+    uint64_t macAddress = libmyo_get_mac_address(opaqueMyo);
+
+    Myo* myo = _macIndex.find(macAddress);
+    if (myo) {
+        // Re-paired device; it may have been given a new handle
+        // Java threads may be calling into the Myo, so the handle is swapped atomically
+        _myoIndex.erase(myo->_myo.exchange(opaqueMyo, std::memory_order_acq_rel));
+    } else {
+        myo = new Myo(opaqueMyo);
+        _myos.push_back(myo);
+        _macIndex.insert(macAddress, myo);
+    }
+    _myoIndex.insert(opaqueMyo, myo);
 
     return myo;
 }
 
+inline
+void Hub::retireMyo(libmyo_myo_t opaqueMyo)
+{
+    _myoIndex.erase(opaqueMyo);
+}
+
 } // namespace myo
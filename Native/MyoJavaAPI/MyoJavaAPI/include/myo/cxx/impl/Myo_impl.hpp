@@ -10,56 +10,56 @@ namespace myo {
 inline
 void Myo::vibrate(VibrationType type)
 {
-    libmyo_vibrate(_myo, static_cast<libmyo_vibration_type_t>(type), ThrowOnError());
+    libmyo_vibrate(libmyoObject(), static_cast<libmyo_vibration_type_t>(type), ThrowOnError());
 }
 
 inline
 void Myo::requestRssi() const
 {
-    libmyo_request_rssi(_myo, ThrowOnError());
+    libmyo_request_rssi(libmyoObject(), ThrowOnError());
 }
 
 inline
 void Myo::requestBatteryLevel() const
 {
-    libmyo_request_battery_level(_myo, myo::ThrowOnError());
+    libmyo_request_battery_level(libmyoObject(), myo::ThrowOnError());
 }
 
 inline
 void Myo::unlock(UnlockType type)
 {
-    libmyo_myo_unlock(_myo, static_cast<libmyo_unlock_type_t>(type), ThrowOnError());
+    libmyo_myo_unlock(libmyoObject(), static_cast<libmyo_unlock_type_t>(type), ThrowOnError());
 }
 
 inline
 void Myo::lock()
 {
-    libmyo_myo_lock(_myo, ThrowOnError());
+    libmyo_myo_lock(libmyoObject(), ThrowOnError());
 }
 
 inline
 void Myo::notifyUserAction()
 {
-    libmyo_myo_notify_user_action(_myo, libmyo_user_action_single, ThrowOnError());
+    libmyo_myo_notify_user_action(libmyoObject(), libmyo_user_action_single, ThrowOnError());
 }
 
 inline
 void Myo::setStreamEmg(StreamEmgType type)
 {
-    libmyo_set_stream_emg(_myo, static_cast<libmyo_stream_emg_t>(type), ThrowOnError());
+    libmyo_set_stream_emg(libmyoObject(), static_cast<libmyo_stream_emg_t>(type), ThrowOnError());
 }
 
 inline
 libmyo_myo_t Myo::libmyoObject() const
 {
-    return _myo;
+    return _myo.load(std::memory_order_acquire);
 }
 
 inline
 Myo::Myo(libmyo_myo_t myo)
 : _myo(myo)
 {
-    if (!_myo) {
+    if (!myo) {
         throw std::invalid_argument("Cannot construct Myo instance with null pointer");
     }
 }